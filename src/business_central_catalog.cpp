@@ -47,6 +47,8 @@ duckdb::TableFunction BcTableEntry::GetScanFunction(duckdb::ClientContext &conte
     table_function.filter_pushdown = true;
     table_function.filter_prune = true;
     table_function.projection_pushdown = true;
+    table_function.init_local = ODataReadTableInitLocalState;
+    table_function.get_partition_data = ODataReadGetPartitionData;
     table_function.table_scan_progress = ODataReadTableProgress;
 
     return table_function;
@@ -122,23 +122,19 @@ std::vector<BusinessCentralCompany> BusinessCentralClientFactory::DiscoverCompan
     };
 
     std::vector<BusinessCentralCompany> companies;
-    for (auto response = client->Get(); response; response = client->Get(true)) {
-        auto rows = response->ToRows(column_names, column_types);
-        for (const auto &row : rows) {
-            if (row.size() < 2) {
-                continue;
-            }
-            BusinessCentralCompany company;
-            company.id = ValueToString(row[0]);
-            company.name = ValueToString(row[1]);
-            if (!company.id.empty()) {
-                companies.push_back(std::move(company));
-            }
+    auto on_row = [&](std::vector<duckdb::Value> &row) {
+        if (row.size() < 2) {
+            return true;
         }
-
-        if (!response->NextUrl()) {
-            break;
+        BusinessCentralCompany company;
+        company.id = ValueToString(row[0]);
+        company.name = ValueToString(row[1]);
+        if (!company.id.empty()) {
+            companies.push_back(std::move(company));
         }
+        return true;
+    };
+    for (bool get_next = false; client->StreamRows(column_names, column_types, on_row, get_next); get_next = true) {
     }
 
     ERPL_TRACE_INFO("BC_CLIENT", "Discovered " + std::to_string(companies.size()) + " Business Central companies");
@@ -140,6 +140,11 @@ std::string CharsetConverter::convert(const std::string& input) const {
     }
 }
 
+bool CharsetConverter::NeedsConversion() const {
+    return charsetType == CharsetType::ISO8859_1 || charsetType == CharsetType::ISO8859_15 ||
+           charsetType == CharsetType::WINDOWS_1252;
+}
+
 std::wstring CharsetConverter::from_bytes(const std::string& input) const {
     ERPL_TRACE_DEBUG("CHARSET_CONVERTER", duckdb::StringUtil::Format("Converting from bytes using charset: %s", charset));
     
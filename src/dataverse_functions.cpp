@@ -137,6 +137,8 @@ static unique_ptr<FunctionData> CrmDescribeBind(
     chunk.Initialize(context, attr_types);
 
     while (odata_bind->HasMoreResults()) {
+        // Columns may come back as dictionary vectors, the chunk is reset like a scan's output
+        chunk.Reset();
         auto rows_fetched = odata_bind->FetchNextResult(chunk);
         if (rows_fetched == 0) break;
 
@@ -0,0 +1,312 @@
+#include "delta_share_cache.hpp"
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace erpl_web {
+
+// FNV-1a, the names of the local copies have to be identical across processes and builds
+static uint64_t StableHash(const std::string &value) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : value) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string ToHex(uint64_t value) {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << value;
+    return ss.str();
+}
+
+// Random per thread, temporary names must not collide across threads or processes sharing the directory
+static std::string TempSuffix() {
+    thread_local std::mt19937_64 generator(std::random_device{}());
+    return ToHex(generator());
+}
+
+// =====================================================================
+// DeltaShareFileListCache
+// =====================================================================
+
+DeltaShareFileListCache& DeltaShareFileListCache::GetInstance() {
+    static DeltaShareFileListCache instance;
+    return instance;
+}
+
+void DeltaShareFileListCache::SetMaxEntries(uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    max_entries = value;
+    EvictLocked(value);
+}
+
+std::string DeltaShareFileListCache::Key(const DeltaShareProfile &profile, const std::string &share,
+                                         const std::string &schema, const std::string &table,
+                                         const DeltaShareQueryRequest &request) {
+    // Recipients may see different files of a table, the token only enters the key as a hash.
+    // The request body holds the version, the predicate and the limit hints.
+    return profile.endpoint + "|auth=" + ToHex(StableHash(profile.bearer_token)) + "|" + share + "." + schema +
+           "." + table + "|" + request.ToJson();
+}
+
+std::chrono::system_clock::time_point DeltaShareFileListCache::ExpiryOf(const std::vector<DeltaFileReference> &files,
+                                                                        std::chrono::system_clock::time_point now,
+                                                                        std::chrono::milliseconds ttl) {
+    auto expiry = now + ttl;
+    for (const auto &file : files) {
+        if (file.expiration_timestamp.has_value()) {
+            auto url_expiry = std::chrono::system_clock::time_point(
+                std::chrono::milliseconds(file.expiration_timestamp.value()));
+            expiry = std::min(expiry, url_expiry - EXPIRY_MARGIN);
+        }
+    }
+    return expiry;
+}
+
+DeltaShareFileListCache::Files DeltaShareFileListCache::Get(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        misses++;
+        return nullptr;
+    }
+    if (std::chrono::system_clock::now() >= it->second->expiry) {
+        lru.erase(it->second);
+        index.erase(it);
+        misses++;
+        return nullptr;
+    }
+
+    lru.splice(lru.begin(), lru, it->second);
+    hits++;
+    return it->second->files;
+}
+
+void DeltaShareFileListCache::Put(const std::string &key, std::vector<DeltaFileReference> files) {
+    if (!IsEnabled()) {
+        return;
+    }
+    auto now = std::chrono::system_clock::now();
+    auto expiry = ExpiryOf(files, now, std::chrono::milliseconds(GetTtl()));
+
+    Entry entry;
+    entry.key = key;
+    entry.files = std::make_shared<const std::vector<DeltaFileReference>>(std::move(files));
+    entry.expiry = expiry;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        lru.erase(it->second);
+        index.erase(it);
+    }
+    if (expiry <= now) {
+        // URLs about to expire are not worth keeping
+        return;
+    }
+    lru.push_front(std::move(entry));
+    index[key] = lru.begin();
+    EvictLocked(max_entries);
+}
+
+void DeltaShareFileListCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    lru.clear();
+    index.clear();
+}
+
+void DeltaShareFileListCache::EvictLocked(uint64_t limit) {
+    while (lru.size() > limit) {
+        index.erase(lru.back().key);
+        lru.pop_back();
+    }
+}
+
+DeltaShareFileListCache::Stats DeltaShareFileListCache::GetStats() const {
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.entries = lru.size();
+    return stats;
+}
+
+// =====================================================================
+// DeltaShareDiskCache
+// =====================================================================
+
+DeltaShareDiskCache& DeltaShareDiskCache::GetInstance() {
+    static DeltaShareDiskCache instance;
+    return instance;
+}
+
+void DeltaShareDiskCache::SetDirectory(const std::string &value) {
+    if (!value.empty()) {
+        try {
+            std::filesystem::create_directories(value);
+        } catch (const std::filesystem::filesystem_error &e) {
+            throw InvalidInputException("Cannot use '%s' as erpl_delta_share_cache_directory: %s", value, e.what());
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    directory = value;
+}
+
+std::string DeltaShareDiskCache::GetDirectory() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return directory;
+}
+
+bool DeltaShareDiskCache::IsEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !directory.empty();
+}
+
+std::string DeltaShareDiskCache::FileName(const DeltaShareProfile &profile, const std::string &share,
+                                          const std::string &schema, const std::string &table,
+                                          const DeltaFileReference &file) {
+    if (file.id.empty()) {
+        return "";
+    }
+    // The size guards against a server reusing an id for different content
+    return ToHex(StableHash(profile.endpoint + "|" + share + "." + schema + "." + table + "|" + file.id + "|" +
+                            std::to_string(file.size))) +
+           ".parquet";
+}
+
+void DeltaShareDiskCache::Acquire(const std::string &file_name) {
+    std::lock_guard<std::mutex> lock(in_use_mutex);
+    in_use[file_name]++;
+}
+
+void DeltaShareDiskCache::Release(const std::string &file_name) {
+    std::lock_guard<std::mutex> lock(in_use_mutex);
+    auto it = in_use.find(file_name);
+    if (it != in_use.end() && --it->second == 0) {
+        in_use.erase(it);
+    }
+}
+
+std::unique_ptr<DeltaShareLocalCopy> DeltaShareDiskCache::Resolve(const std::string &file_name, uint64_t size,
+                                                                  const DownloadFunction &download) {
+    auto cache_directory = GetDirectory();
+    if (cache_directory.empty() || file_name.empty()) {
+        return nullptr;
+    }
+
+    // Taken before the copy is looked at, an eviction running now already skips it
+    auto path = std::filesystem::path(cache_directory) / file_name;
+    auto local_copy = std::make_unique<DeltaShareLocalCopy>(*this, file_name, path.string());
+
+    std::error_code ec;
+    auto cached_size = std::filesystem::file_size(path, ec);
+    if (!ec && (size == 0 || cached_size == size)) {
+        // The modification time orders the copies for eviction
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+        hits++;
+        ERPL_TRACE_DEBUG("DELTA_SHARE_CACHE", "Reading local copy " + path.string());
+        return local_copy;
+    }
+
+    // Written next to the target and renamed, readers in other processes never see a partial copy
+    std::filesystem::path tmp_path(path.string() + ".tmp." + TempSuffix());
+
+    try {
+        download(tmp_path.string());
+        auto downloaded_size = std::filesystem::file_size(tmp_path);
+        if (size > 0 && downloaded_size != size) {
+            throw std::runtime_error("expected " + std::to_string(size) + " bytes, received " +
+                                     std::to_string(downloaded_size));
+        }
+        std::filesystem::rename(tmp_path, path);
+        downloads++;
+        ERPL_TRACE_DEBUG("DELTA_SHARE_CACHE", "Downloaded " + std::to_string(downloaded_size) + " bytes to " +
+                         path.string());
+    } catch (const std::exception &e) {
+        // The disk cache is an optimization, a failed copy never fails the scan
+        ERPL_TRACE_WARN("DELTA_SHARE_CACHE", "Failed to cache " + path.string() + ", reading from the URL: " + e.what());
+        std::filesystem::remove(tmp_path, ec);
+        return nullptr;
+    }
+
+    Evict(cache_directory);
+    return local_copy;
+}
+
+void DeltaShareDiskCache::Evict(const std::string &cache_directory) {
+    std::lock_guard<std::mutex> lock(eviction_mutex);
+
+    struct CachedFile {
+        std::filesystem::path path;
+        uint64_t size;
+        std::filesystem::file_time_type last_read;
+    };
+    std::vector<CachedFile> files;
+    uint64_t total_bytes = 0;
+
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(cache_directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entry_ec;
+        if (!it->is_regular_file(entry_ec) || it->path().extension() != ".parquet") {
+            continue;
+        }
+        CachedFile file;
+        file.path = it->path();
+        file.size = it->file_size(entry_ec);
+        file.last_read = it->last_write_time(entry_ec);
+        if (entry_ec) {
+            continue;
+        }
+        total_bytes += file.size;
+        files.push_back(std::move(file));
+    }
+
+    auto limit = GetMaxBytes();
+    if (total_bytes <= limit) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(),
+              [](const CachedFile &a, const CachedFile &b) { return a.last_read < b.last_read; });
+    for (const auto &file : files) {
+        if (total_bytes <= limit) {
+            break;
+        }
+        // Checked and removed under the lock, a scan cannot start reading the copy in between
+        std::lock_guard<std::mutex> in_use_lock(in_use_mutex);
+        if (in_use.count(file.path.filename().string()) > 0) {
+            continue;
+        }
+        std::error_code remove_ec;
+        if (std::filesystem::remove(file.path, remove_ec)) {
+            total_bytes -= file.size;
+            evictions++;
+            ERPL_TRACE_DEBUG("DELTA_SHARE_CACHE", "Evicted " + file.path.string());
+        }
+    }
+}
+
+DeltaShareDiskCache::Stats DeltaShareDiskCache::GetStats() const {
+    Stats stats;
+    stats.hits = hits;
+    stats.downloads = downloads;
+    stats.evictions = evictions;
+    return stats;
+}
+
+DeltaShareLocalCopy::DeltaShareLocalCopy(DeltaShareDiskCache &cache, std::string file_name, std::string path)
+    : cache(cache), file_name(std::move(file_name)), path(std::move(path)) {
+    this->cache.Acquire(this->file_name);
+}
+
+DeltaShareLocalCopy::~DeltaShareLocalCopy() {
+    cache.Release(file_name);
+}
+
+} // namespace erpl_web
@@ -1,8 +1,10 @@
 #include "delta_share_client.hpp"
+#include "graph_write_helpers.hpp"
 #include "tracing.hpp"
 #include "yyjson.hpp"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 #include <chrono>
 #include "duckdb/common/file_system.hpp"
 
@@ -225,7 +227,10 @@ DeltaShareResponse DeltaShareClient::ExecuteGet(const string& endpoint, const He
         DeltaShareResponse delta_response;
         delta_response.http_status = response->Code();
         delta_response.content = response->Content();
-        // Headers available from response object if needed
+        // The version endpoint answers with the version in a header
+        for (auto& header : response->headers) {
+            delta_response.headers[StringUtil::Lower(header.first)] = header.second;
+        }
 
         ERPL_TRACE_DEBUG("DELTA_SHARE", "Response status: " + std::to_string(delta_response.http_status));
 
@@ -271,6 +276,56 @@ DeltaShareResponse DeltaShareClient::ExecutePost(const string& endpoint, const s
     }
 }
 
+DeltaShareResponse DeltaShareClient::ExecuteStreamingRequest(HttpMethod method, const string& endpoint,
+                                                             const string& body, HttpBodyConsumer& consumer) {
+    string url = BuildUrl(endpoint);
+    ERPL_TRACE_DEBUG("DELTA_SHARE", method.ToString() + " (streaming) " + url);
+
+    if (method != HttpMethod::GET) {
+        ERPL_TRACE_DEBUG("DELTA_SHARE", "Request body: " + body);
+    }
+
+    auto request = method == HttpMethod::GET ? HttpRequest(method, url)
+                                             : HttpRequest(method, url, "application/json", body);
+    request.headers = BuildHeaders();
+
+    try {
+        auto response = http_client_->SendStreamingRequest(request, consumer);
+
+        DeltaShareResponse delta_response;
+        delta_response.http_status = response->Code();
+        delta_response.content = response->Content();
+
+        ERPL_TRACE_DEBUG("DELTA_SHARE", "Response status: " + std::to_string(delta_response.http_status));
+
+        return delta_response;
+    } catch (const std::exception& e) {
+        ERPL_TRACE_ERROR("DELTA_SHARE", "HTTP " + method.ToString() + " failed: " + string(e.what()));
+        throw;
+    }
+}
+
+void DeltaShareClient::StreamQueryResponse(HttpMethod method, const string& endpoint, const string& body,
+                                           const DeltaFileCallback& on_file) {
+    // Query responses list one file per line and grow with the table, every line is
+    // parsed and handed on as it arrives instead of collecting the response first.
+    uint64_t file_count = 0;
+    NdjsonLineSplitter splitter([&](const string& line) {
+        return ParseQueryLine(line, [&](DeltaFileReference file) {
+            file_count++;
+            return on_file(std::move(file));
+        });
+    });
+
+    DeltaShareResponse response = ExecuteStreamingRequest(method, endpoint, body, splitter);
+    if (response.http_status != 200) {
+        HandleApiError(response.http_status, response.content);
+    }
+
+    ERPL_TRACE_INFO("DELTA_SHARE", "Streamed query response, found " + std::to_string(file_count) +
+                    " file references in " + std::to_string(splitter.LineCount()) + " lines");
+}
+
 void DeltaShareClient::HandleApiError(int32_t status_code, const string& error_body) {
     string error_msg = "Delta Sharing API error (HTTP " + std::to_string(status_code) + ")";
 
@@ -342,13 +397,22 @@ std::vector<DeltaFileReference> DeltaShareClient::QueryTable(const std::string&
         body = query_request->ToJson();
     }
 
-    DeltaShareResponse response = ExecutePost(endpoint, body);
+    vector<DeltaFileReference> files;
+    StreamQueryResponse(HttpMethod::POST, endpoint, body, [&files](DeltaFileReference file) {
+        files.push_back(std::move(file));
+        return true;
+    });
+    return files;
+}
 
-    if (response.http_status != 200) {
-        HandleApiError(response.http_status, response.content);
-    }
+void DeltaShareClient::StreamQueryTable(const string& share, const string& schema, const string& table,
+                                        const std::optional<DeltaShareQueryRequest>& query_request,
+                                        const DeltaFileCallback& on_file) {
+    ERPL_TRACE_DEBUG("DELTA_SHARE", "Streaming query of table: " + share + "." + schema + "." + table);
 
-    return ParseQueryResponse(response.content);
+    string endpoint = "/shares/" + share + "/schemas/" + schema + "/tables/" + table + "/query";
+    StreamQueryResponse(HttpMethod::POST, endpoint, query_request.has_value() ? query_request->ToJson() : string("{}"),
+                        on_file);
 }
 
 int64_t DeltaShareClient::GetTableVersion(const string& share, const string& schema, const string& table) {
@@ -361,6 +425,16 @@ int64_t DeltaShareClient::GetTableVersion(const string& share, const string& sch
         HandleApiError(response.http_status, response.content);
     }
 
+    // The protocol sends the version in the Delta-Table-Version header, older servers in the body
+    auto version_header = response.headers.find("delta-table-version");
+    if (version_header != response.headers.end()) {
+        try {
+            return std::stoll(version_header->second);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid Delta-Table-Version header: " + version_header->second);
+        }
+    }
+
     // Parse version from response
     auto doc = std::shared_ptr<yyjson_doc>(
         yyjson_read(response.content.c_str(), response.content.size(), 0),
@@ -378,35 +452,57 @@ int64_t DeltaShareClient::GetTableVersion(const string& share, const string& sch
         return (int64_t)yyjson_get_uint(version_val);
     }
 
-    return 0;
+    throw std::runtime_error("Version response holds no table version");
 }
 
 std::vector<DeltaFileReference> DeltaShareClient::GetTableChanges(const std::string& share, const std::string& schema, const std::string& table,
                                                             int64_t starting_version, std::optional<int64_t> ending_version) {
-    ERPL_TRACE_DEBUG("DELTA_SHARE", "Getting table changes for: " + share + "." + schema + "." + table);
+    vector<DeltaFileReference> files;
+    StreamTableChanges(share, schema, table, starting_version, ending_version, [&files](DeltaFileReference file) {
+        files.push_back(std::move(file));
+        return true;
+    });
+    return files;
+}
 
-    string endpoint = "/shares/" + share + "/schemas/" + schema + "/tables/" + table + "/changes";
+void DeltaShareClient::StreamTableChanges(const string& share, const string& schema, const string& table,
+                                          int64_t starting_version, std::optional<int64_t> ending_version,
+                                          const DeltaFileCallback& on_file) {
+    ERPL_TRACE_DEBUG("DELTA_SHARE", "Getting table changes for: " + share + "." + schema + "." + table);
 
-    // Build request with starting version
-    string body = "{\"startingVersion\": " + std::to_string(starting_version);
+    // The changes endpoint takes the version range as query parameters of a GET
+    string endpoint = "/shares/" + share + "/schemas/" + schema + "/tables/" + table +
+                      "/changes?startingVersion=" + std::to_string(starting_version);
     if (ending_version.has_value()) {
-        body += ", \"endingVersion\": " + std::to_string(ending_version.value());
+        endpoint += "&endingVersion=" + std::to_string(ending_version.value());
     }
-    body += "}";
 
-    DeltaShareResponse response = ExecutePost(endpoint, body);
+    StreamQueryResponse(HttpMethod::GET, endpoint, "", on_file);
+}
 
-    if (response.http_status != 200) {
-        HandleApiError(response.http_status, response.content);
-    }
+void DeltaShareClient::DownloadFile(const DeltaFileReference& file, const string& path) {
+    ERPL_TRACE_DEBUG("DELTA_SHARE", "Downloading file " + file.id + " (" + std::to_string(file.size) + " bytes)");
 
-    return ParseQueryResponse(response.content);
+    HttpRequest request(HttpMethod::GET, file.url);
+    HttpFileSink sink(path);
+    auto response = http_client_->SendStreamingRequest(request, sink);
+    if (response->Code() != 200) {
+        throw std::runtime_error("Failed to download Delta Sharing file " + file.id + " (HTTP " +
+                                 std::to_string(response->Code()) + ")");
+    }
 }
 
 // =====================================================================
 // File Reference Parsing (Consolidates duplicate extraction logic)
 // =====================================================================
 
+yyjson_doc* DeltaShareClient::ReadJson(const char* data, size_t length) const {
+    // Responses and lines are parsed one after the other, so each one reuses the
+    // memory of the one before instead of allocating its own
+    json_arena_.Reset();
+    return json_arena_.Read(data, length);
+}
+
 DeltaFileReference DeltaShareClient::ParseFileReference(yyjson_val* file_obj) const {
     DeltaFileReference file_ref;
 
@@ -429,7 +525,10 @@ DeltaFileReference DeltaShareClient::ParseFileReference(yyjson_val* file_obj) co
     }
 
     // Extract partition values if present
-    auto partition_vals = yyjson_obj_get(file_obj, "partition_values");
+    auto partition_vals = yyjson_obj_get(file_obj, "partitionValues");
+    if (!partition_vals) {
+        partition_vals = yyjson_obj_get(file_obj, "partition_values");
+    }
     if (partition_vals && yyjson_is_obj(partition_vals)) {
         yyjson_obj_iter iter = yyjson_obj_iter_with(partition_vals);
         yyjson_val* key;
@@ -442,18 +541,33 @@ DeltaFileReference DeltaShareClient::ParseFileReference(yyjson_val* file_obj) co
         }
     }
 
+    // Commit of the file in change data feed responses
+    auto version_val = yyjson_obj_get(file_obj, "version");
+    if (yyjson_is_int(version_val)) {
+        file_ref.version = yyjson_get_sint(version_val);
+    }
+    auto timestamp_val = yyjson_obj_get(file_obj, "timestamp");
+    if (yyjson_is_int(timestamp_val)) {
+        file_ref.timestamp = yyjson_get_sint(timestamp_val);
+    }
+
+    // Lists holding the file are only reusable until its URL expires
+    auto expiration_val = yyjson_obj_get(file_obj, "expirationTimestamp");
+    if (yyjson_is_int(expiration_val)) {
+        file_ref.expiration_timestamp = yyjson_get_sint(expiration_val);
+    }
+
     // Extract stats if present
     auto stats_val = yyjson_obj_get(file_obj, "stats");
-    if (stats_val) {
-        char* stats_str = duckdb_yyjson::yyjson_val_write(stats_val, 0, nullptr);
+    if (stats_val && yyjson_is_str(stats_val)) {
+        // The protocol sends the stats as a JSON encoded string
+        file_ref.stats = string(yyjson_get_str(stats_val), yyjson_get_len(stats_val));
+    } else if (stats_val) {
+        // Written into the arena of the line being parsed, nothing to free
+        size_t stats_len = 0;
+        char* stats_str = yyjson_val_write_opts(stats_val, 0, json_arena_.Allocator(), &stats_len, nullptr);
         if (stats_str) {
-            try {
-                file_ref.stats = string(stats_str);
-            } catch (...) {
-                free(stats_str);
-                throw;
-            }
-            free(stats_str);
+            file_ref.stats = string(stats_str, stats_len);
         }
     }
 
@@ -483,26 +597,22 @@ DeltaTableMetadata DeltaShareClient::ParseMetadataResponse(const string& ndjson_
             line_end = ndjson_content.length();
         }
 
-        // Extract the line
-        string line = ndjson_content.substr(pos, line_end - pos);
+        // Parse the line where it is, only a trailing carriage return is cut off
+        const char* line = ndjson_content.data() + pos;
+        size_t line_length = line_end - pos;
+        if (line_length > 0 && line[line_length - 1] == '\r') {
+            line_length--;
+        }
 
         // Skip empty lines
-        if (!line.empty() && line != "\r") {
-            // Remove trailing carriage return if present
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-
-            ERPL_TRACE_DEBUG("DELTA_SHARE", "Parsing NDJSON line " + std::to_string(line_num) + ": " + line.substr(0, 50));
+        if (line_length > 0) {
+            ERPL_TRACE_DEBUG("DELTA_SHARE", "Parsing NDJSON line " + std::to_string(line_num) + ": " + string(line, std::min<size_t>(line_length, 50)));
 
             // Parse the JSON line
-            auto doc = std::shared_ptr<yyjson_doc>(
-                yyjson_read(line.c_str(), line.length(), 0),
-                yyjson_doc_free
-            );
+            auto doc = ReadJson(line, line_length);
 
             if (doc) {
-                auto root = yyjson_doc_get_root(doc.get());
+                auto root = yyjson_doc_get_root(doc);
 
                 // Check if this is a protocol line
                 auto protocol_val = yyjson_obj_get(root, "protocol");
@@ -535,7 +645,7 @@ DeltaTableMetadata DeltaShareClient::ParseMetadataResponse(const string& ndjson_
                     }
                 }
             } else {
-                ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse NDJSON line: " + line);
+                ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse NDJSON line: " + string(line, line_length));
             }
 
             line_num++;
@@ -548,84 +658,42 @@ DeltaTableMetadata DeltaShareClient::ParseMetadataResponse(const string& ndjson_
     return metadata;
 }
 
-vector<DeltaFileReference> DeltaShareClient::ParseQueryResponse(const string& ndjson_content) {
-    ERPL_TRACE_DEBUG("DELTA_SHARE", "Parsing query response (NDJSON format)");
-
-    vector<DeltaFileReference> files;
-
-    // Parse NDJSON: each line is a separate JSON object
+bool DeltaShareClient::ParseQueryLine(const string& line, const DeltaFileCallback& on_file) const {
     // Format of each line in the response:
     // - Protocol line: {"protocol": {...}, "metadata": {...}}
     // - File line: {"file": {...}} or {"add": {...}}
     //   where file/add contains: {"url": "presigned_url", "size": 1024, "id": "file_id", ...}
+    ERPL_TRACE_DEBUG("DELTA_SHARE", "Parsing NDJSON line: " + line.substr(0, 50));
 
-    size_t pos = 0;
-    int line_num = 0;
-
-    while (pos < ndjson_content.length()) {
-        // Find the end of the current line
-        size_t line_end = ndjson_content.find('\n', pos);
-        if (line_end == string::npos) {
-            line_end = ndjson_content.length();
-        }
-
-        // Extract the line
-        string line = ndjson_content.substr(pos, line_end - pos);
-
-        // Skip empty lines
-        if (!line.empty() && line != "\r") {
-            // Remove trailing carriage return if present
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-
-            ERPL_TRACE_DEBUG("DELTA_SHARE", "Parsing NDJSON line " + std::to_string(line_num) + ": " + line.substr(0, 50));
-
-            // Parse the JSON line
-            auto doc = std::shared_ptr<yyjson_doc>(
-                yyjson_read(line.c_str(), line.length(), 0),
-                yyjson_doc_free
-            );
+    auto doc = ReadJson(line.c_str(), line.length());
+    if (!doc) {
+        ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse NDJSON line: " + line);
+        return true;
+    }
 
-            if (doc) {
-                auto root = yyjson_doc_get_root(doc.get());
+    auto root = yyjson_doc_get_root(doc);
 
-                // Check if this is a protocol/metadata line (skip for now)
-                auto protocol_val = yyjson_obj_get(root, "protocol");
-                if (protocol_val) {
-                    ERPL_TRACE_DEBUG("DELTA_SHARE", "Found protocol line in query response");
-                    line_num++;
-                    pos = line_end + 1;
-                    continue;
-                }
-
-                // Check if this is a file reference line (Delta format: {"file": {...}})
-                auto file_val = yyjson_obj_get(root, "file");
-                if (file_val && yyjson_is_obj(file_val)) {
-                    auto file_ref = ParseFileReference(file_val);
-                    files.push_back(file_ref);
-                    ERPL_TRACE_DEBUG("DELTA_SHARE", "Extracted file reference: " + file_ref.url.substr(0, 60) + "...");
-                }
+    // Check if this is a protocol/metadata line (skip for now)
+    if (yyjson_obj_get(root, "protocol")) {
+        ERPL_TRACE_DEBUG("DELTA_SHARE", "Found protocol line in query response");
+        return true;
+    }
 
-                // Check if this is an add action line (Delta format: {"add": {...}})
-                auto add_val = yyjson_obj_get(root, "add");
-                if (add_val && yyjson_is_obj(add_val)) {
-                    auto file_ref = ParseFileReference(add_val);
-                    files.push_back(file_ref);
-                    ERPL_TRACE_DEBUG("DELTA_SHARE", "Extracted add action file reference: " + file_ref.url.substr(0, 60) + "...");
-                }
-            } else {
-                ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse NDJSON line: " + line);
+    // File lines of a snapshot ({"file": {...}}) and the actions of a change data
+    // feed ({"add": {...}}, {"cdf": {...}} or {"remove": {...}})
+    for (auto action : {"file", "add", "cdf", "remove"}) {
+        auto file_val = yyjson_obj_get(root, action);
+        if (file_val && yyjson_is_obj(file_val)) {
+            auto file_ref = ParseFileReference(file_val);
+            file_ref.action = action;
+            ERPL_TRACE_DEBUG("DELTA_SHARE", "Extracted " + string(action) + " file reference: " +
+                             file_ref.url.substr(0, 60) + "...");
+            if (!on_file(std::move(file_ref))) {
+                return false;
             }
-
-            line_num++;
         }
-
-        pos = line_end + 1;
     }
-
-    ERPL_TRACE_INFO("DELTA_SHARE", "Parsed query response, found " + std::to_string(files.size()) + " file references");
-    return files;
+    return true;
 }
 
 vector<DeltaShareInfo> DeltaShareClient::ParseSharesResponse(const string& json_content) {
@@ -633,17 +701,14 @@ vector<DeltaShareInfo> DeltaShareClient::ParseSharesResponse(const string& json_
 
     vector<DeltaShareInfo> shares;
 
-    auto doc = std::shared_ptr<yyjson_doc>(
-        yyjson_read(json_content.c_str(), json_content.size(), 0),
-        yyjson_doc_free
-    );
+    auto doc = ReadJson(json_content.c_str(), json_content.size());
 
     if (!doc) {
         ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse JSON shares response");
         return shares;
     }
 
-    auto root = yyjson_doc_get_root(doc.get());
+    auto root = yyjson_doc_get_root(doc);
     auto shares_arr = yyjson_obj_get(root, "shares");
 
     if (shares_arr && yyjson_is_arr(shares_arr)) {
@@ -675,17 +740,14 @@ vector<DeltaSchemaInfo> DeltaShareClient::ParseSchemasResponse(const string& jso
 
     vector<DeltaSchemaInfo> schemas;
 
-    auto doc = std::shared_ptr<yyjson_doc>(
-        yyjson_read(json_content.c_str(), json_content.size(), 0),
-        yyjson_doc_free
-    );
+    auto doc = ReadJson(json_content.c_str(), json_content.size());
 
     if (!doc) {
         ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse JSON schemas response");
         return schemas;
     }
 
-    auto root = yyjson_doc_get_root(doc.get());
+    auto root = yyjson_doc_get_root(doc);
     auto schemas_arr = yyjson_obj_get(root, "schemas");
 
     if (schemas_arr && yyjson_is_arr(schemas_arr)) {
@@ -713,17 +775,14 @@ vector<DeltaTableInfo> DeltaShareClient::ParseTablesResponse(const string& json_
 
     vector<DeltaTableInfo> tables;
 
-    auto doc = std::shared_ptr<yyjson_doc>(
-        yyjson_read(json_content.c_str(), json_content.size(), 0),
-        yyjson_doc_free
-    );
+    auto doc = ReadJson(json_content.c_str(), json_content.size());
 
     if (!doc) {
         ERPL_TRACE_WARN("DELTA_SHARE", "Failed to parse JSON tables response");
         return tables;
     }
 
-    auto root = yyjson_doc_get_root(doc.get());
+    auto root = yyjson_doc_get_root(doc);
     auto tables_arr = yyjson_obj_get(root, "tables");
 
     if (tables_arr && yyjson_is_arr(tables_arr)) {
@@ -762,58 +821,31 @@ vector<DeltaTableInfo> DeltaShareClient::ParseTablesResponse(const string& json_
 // =====================================================================
 
 string DeltaShareQueryRequest::ToJson() const {
-    std::string json = "{";
+    // Field names and encodings of the Delta Sharing protocol: predicateHints is an
+    // array of SQL strings, jsonPredicateHints a JSON predicate encoded as a string
+    vector<string> fields;
 
-    // Add predicate hints if present
     if (!predicate_hints.empty()) {
-        json += "\"predicate_hints\": [";
-        for (size_t i = 0; i < predicate_hints.size(); ++i) {
-            json += "\"" + predicate_hints[i] + "\"";
-            if (i < predicate_hints.size() - 1) {
-                json += ", ";
-            }
-        }
-        json += "]";
-
-        if (!json_predicate_hints.empty() || limit_hint.has_value() || version.has_value()) {
-            json += ", ";
+        vector<string> hints;
+        for (auto& hint : predicate_hints) {
+            hints.push_back(DuckDbValueToJsonLiteral(Value(hint)));
         }
+        fields.push_back("\"predicateHints\": [" + StringUtil::Join(hints, ", ") + "]");
     }
 
-    // Add JSON predicate hints if present
     if (!json_predicate_hints.empty()) {
-        json += "\"json_predicate_hints\": {";
-        size_t i = 0;
-        for (auto& pair : json_predicate_hints) {
-            json += "\"" + pair.first + "\": \"" + pair.second + "\"";
-            if (i < json_predicate_hints.size() - 1) {
-                json += ", ";
-            }
-            ++i;
-        }
-        json += "}";
-
-        if (limit_hint.has_value() || version.has_value()) {
-            json += ", ";
-        }
+        fields.push_back("\"jsonPredicateHints\": " + DuckDbValueToJsonLiteral(Value(json_predicate_hints)));
     }
 
-    // Add limit hint if present
     if (limit_hint.has_value()) {
-        json += "\"limit_hint\": " + std::to_string(limit_hint.value());
-
-        if (version.has_value()) {
-            json += ", ";
-        }
+        fields.push_back("\"limitHint\": " + std::to_string(limit_hint.value()));
     }
 
-    // Add version if present
     if (version.has_value()) {
-        json += "\"version\": " + std::to_string(version.value());
+        fields.push_back("\"version\": " + std::to_string(version.value()));
     }
 
-    json += "}";
-    return json;
+    return "{" + StringUtil::Join(fields, ", ") + "}";
 }
 
 // =====================================================================
@@ -840,8 +872,24 @@ LogicalType ConvertDeltaTypeToLogicalType(const string& delta_type) {
 		return LogicalType::BOOLEAN;
 	} else if (delta_type == "date") {
 		return LogicalType::DATE;
-	} else if (delta_type == "timestamp") {
+	} else if (delta_type == "timestamp" || delta_type == "timestamp_ntz") {
 		return LogicalType::TIMESTAMP;
+	} else if (delta_type == "binary") {
+		return LogicalType::BLOB;
+	} else if (StringUtil::StartsWith(delta_type, "decimal(")) {
+		// decimal(precision,scale), the files are read cast to it
+		auto arguments = StringUtil::Split(delta_type.substr(8, delta_type.size() - 9), ',');
+		try {
+			if (arguments.size() == 2) {
+				auto width = std::stoi(arguments[0]);
+				auto scale = std::stoi(arguments[1]);
+				if (width > 0 && width <= 38 && scale >= 0 && scale <= width) {
+					return LogicalType::DECIMAL(width, scale);
+				}
+			}
+		} catch (const std::exception &) {
+		}
+		return LogicalType::VARCHAR;
 	} else {
 		// Unknown type - default to VARCHAR
 		return LogicalType::VARCHAR;
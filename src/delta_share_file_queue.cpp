@@ -0,0 +1,78 @@
+#include "delta_share_file_queue.hpp"
+#include "tracing.hpp"
+
+namespace erpl_web {
+
+DeltaFileQueue::DeltaFileQueue(ListFunction list) : list(std::move(list)) {
+    worker = std::thread(&DeltaFileQueue::Run, this);
+}
+
+DeltaFileQueue::~DeltaFileQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    // The listing notices at its next line, e.g. once a LIMIT ended the scan early
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+bool DeltaFileQueue::Next(DeltaFileReference &file, uint64_t &index) {
+    std::unique_lock<std::mutex> lock(mutex);
+    file_available.wait(lock, [this] { return !ready.empty() || finished; });
+
+    if (!ready.empty()) {
+        file = std::move(ready.front());
+        ready.pop_front();
+        index = claimed++;
+        return true;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return false;
+}
+
+uint64_t DeltaFileQueue::ListedFiles() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return listed;
+}
+
+bool DeltaFileQueue::Finished() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return finished;
+}
+
+void DeltaFileQueue::Run() {
+    std::exception_ptr list_error;
+    try {
+        list([this](DeltaFileReference file) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (stopped) {
+                    return false;
+                }
+                ready.push_back(std::move(file));
+                listed++;
+            }
+            file_available.notify_one();
+            return true;
+        });
+    } catch (...) {
+        list_error = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!stopped) {
+            error = list_error;
+        }
+        finished = true;
+        ERPL_TRACE_DEBUG("DELTA_SHARE", "Listed " + std::to_string(listed) + " files" +
+                         (list_error ? string(" before an error") : string("")));
+    }
+    file_available.notify_all();
+}
+
+} // namespace erpl_web
@@ -0,0 +1,470 @@
+#include "delta_share_pushdown.hpp"
+#include "graph_write_helpers.hpp"
+#include "yyjson.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+
+using namespace duckdb_yyjson;
+
+namespace erpl_web {
+
+DeltaSharePushdown::DeltaSharePushdown(const vector<DeltaShareColumn> &columns, const vector<column_t> &column_ids,
+                                       optional_ptr<TableFilterSet> table_filters) {
+    if (!table_filters) {
+        return;
+    }
+    for (auto &entry : table_filters->filters) {
+        ColumnFilter column_filter;
+        column_filter.output_index = entry.first;
+        auto column_id = entry.first < column_ids.size() ? column_ids[entry.first] : COLUMN_IDENTIFIER_ROW_ID;
+        if (column_id < columns.size()) {
+            column_filter.column = columns[column_id];
+        } else {
+            column_filter.virtual_column = true;
+        }
+        column_filter.filter = entry.second->Copy();
+        filters.push_back(std::move(column_filter));
+    }
+}
+
+// =====================================================================
+// jsonPredicateHints
+// =====================================================================
+
+// valueType of the Delta Sharing predicate ops, empty for types without one.
+// Timestamps are left out, their literal format differs between servers.
+static string JsonPredicateValueType(const LogicalType &type) {
+    switch (type.id()) {
+    case LogicalTypeId::BOOLEAN:
+        return "bool";
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+        return "int";
+    case LogicalTypeId::BIGINT:
+        return "long";
+    case LogicalTypeId::VARCHAR:
+        return "string";
+    case LogicalTypeId::DATE:
+        return "date";
+    case LogicalTypeId::FLOAT:
+        return "float";
+    case LogicalTypeId::DOUBLE:
+        return "double";
+    default:
+        return "";
+    }
+}
+
+static string JsonPredicateOp(const string &op, const vector<string> &children) {
+    return "{\"op\":\"" + op + "\",\"children\":[" + StringUtil::Join(children, ",") + "]}";
+}
+
+// "and" takes two children or more
+static string JsonPredicateAnd(const vector<string> &children) {
+    if (children.empty()) {
+        return "";
+    }
+    return children.size() == 1 ? children[0] : JsonPredicateOp("and", children);
+}
+
+static string JsonPredicate(const TableFilter &filter, const DeltaShareColumn &column, const string &value_type) {
+    auto column_json = "{\"op\":\"column\",\"name\":" + DuckDbValueToJsonLiteral(Value(column.name)) +
+                       ",\"valueType\":\"" + value_type + "\"}";
+
+    switch (filter.filter_type) {
+    case TableFilterType::CONSTANT_COMPARISON: {
+        auto &constant_filter = filter.Cast<ConstantFilter>();
+        auto &constant = constant_filter.constant;
+        if (constant.IsNull() || constant.type() != column.type) {
+            return "";
+        }
+        auto literal_json = "{\"op\":\"literal\",\"value\":" + DuckDbValueToJsonLiteral(Value(constant.ToString())) +
+                            ",\"valueType\":\"" + value_type + "\"}";
+        switch (constant_filter.comparison_type) {
+        case ExpressionType::COMPARE_EQUAL:
+            return JsonPredicateOp("equal", {column_json, literal_json});
+        case ExpressionType::COMPARE_NOTEQUAL:
+            return JsonPredicateOp("not", {JsonPredicateOp("equal", {column_json, literal_json})});
+        case ExpressionType::COMPARE_LESSTHAN:
+            return JsonPredicateOp("lessThan", {column_json, literal_json});
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            return JsonPredicateOp("lessThanOrEqual", {column_json, literal_json});
+        case ExpressionType::COMPARE_GREATERTHAN:
+            return JsonPredicateOp("greaterThan", {column_json, literal_json});
+        case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            return JsonPredicateOp("greaterThanOrEqual", {column_json, literal_json});
+        default:
+            return "";
+        }
+    }
+    case TableFilterType::IS_NULL:
+        return JsonPredicateOp("isNull", {column_json});
+    case TableFilterType::IS_NOT_NULL:
+        return JsonPredicateOp("not", {JsonPredicateOp("isNull", {column_json})});
+    case TableFilterType::CONJUNCTION_AND: {
+        // Leaving out a child only widens the hint
+        vector<string> children;
+        for (auto &child : filter.Cast<ConjunctionAndFilter>().child_filters) {
+            auto child_json = JsonPredicate(*child, column, value_type);
+            if (!child_json.empty()) {
+                children.push_back(child_json);
+            }
+        }
+        return JsonPredicateAnd(children);
+    }
+    case TableFilterType::CONJUNCTION_OR: {
+        // Leaving out a child would narrow it, so all of them or nothing
+        vector<string> children;
+        for (auto &child : filter.Cast<ConjunctionOrFilter>().child_filters) {
+            auto child_json = JsonPredicate(*child, column, value_type);
+            if (child_json.empty()) {
+                return "";
+            }
+            children.push_back(child_json);
+        }
+        return children.size() == 1 ? children[0] : JsonPredicateOp("or", children);
+    }
+    default:
+        // Optional and dynamic filters are not known to the server
+        return "";
+    }
+}
+
+string DeltaSharePushdown::JsonPredicateHints() const {
+    vector<string> predicates;
+    for (auto &column_filter : filters) {
+        if (column_filter.virtual_column) {
+            continue;
+        }
+        auto value_type = JsonPredicateValueType(column_filter.column.type);
+        if (value_type.empty()) {
+            continue;
+        }
+        auto predicate = JsonPredicate(*column_filter.filter, column_filter.column, value_type);
+        if (!predicate.empty()) {
+            predicates.push_back(predicate);
+        }
+    }
+    return JsonPredicateAnd(predicates);
+}
+
+// =====================================================================
+// read_parquet condition
+// =====================================================================
+
+// Types the Parquet reader returns exactly as declared, so the condition
+// compares the file column against the constant like the scan output would.
+// Timestamps are read with a time zone from most writers and left out.
+static bool FileConditionSupportsType(const LogicalType &type) {
+    switch (type.id()) {
+    case LogicalTypeId::BOOLEAN:
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+    case LogicalTypeId::FLOAT:
+    case LogicalTypeId::DOUBLE:
+    case LogicalTypeId::DECIMAL:
+    case LogicalTypeId::VARCHAR:
+    case LogicalTypeId::DATE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static string SqlComparisonOperator(ExpressionType type) {
+    switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+        return "=";
+    case ExpressionType::COMPARE_NOTEQUAL:
+        return "<>";
+    case ExpressionType::COMPARE_LESSTHAN:
+        return "<";
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        return "<=";
+    case ExpressionType::COMPARE_GREATERTHAN:
+        return ">";
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        return ">=";
+    default:
+        return "";
+    }
+}
+
+static string FilterFileCondition(const TableFilter &filter, const DeltaShareColumn &column, const string &column_sql) {
+    switch (filter.filter_type) {
+    case TableFilterType::CONSTANT_COMPARISON: {
+        auto &constant_filter = filter.Cast<ConstantFilter>();
+        auto op = SqlComparisonOperator(constant_filter.comparison_type);
+        if (op.empty() || constant_filter.constant.IsNull() || constant_filter.constant.type() != column.type) {
+            return "";
+        }
+        return column_sql + " " + op + " " + constant_filter.constant.ToSQLString();
+    }
+    case TableFilterType::IS_NULL:
+        return column_sql + " IS NULL";
+    case TableFilterType::IS_NOT_NULL:
+        return column_sql + " IS NOT NULL";
+    case TableFilterType::CONJUNCTION_AND: {
+        vector<string> children;
+        for (auto &child : filter.Cast<ConjunctionAndFilter>().child_filters) {
+            auto child_sql = FilterFileCondition(*child, column, column_sql);
+            if (!child_sql.empty()) {
+                children.push_back(child_sql);
+            }
+        }
+        return children.empty() ? "" : "(" + StringUtil::Join(children, " AND ") + ")";
+    }
+    case TableFilterType::CONJUNCTION_OR: {
+        vector<string> children;
+        for (auto &child : filter.Cast<ConjunctionOrFilter>().child_filters) {
+            auto child_sql = FilterFileCondition(*child, column, column_sql);
+            if (child_sql.empty()) {
+                return "";
+            }
+            children.push_back(child_sql);
+        }
+        return children.empty() ? "" : "(" + StringUtil::Join(children, " OR ") + ")";
+    }
+    default:
+        return "";
+    }
+}
+
+string DeltaSharePushdown::FileCondition() const {
+    vector<string> conditions;
+    for (auto &column_filter : filters) {
+        auto &column = column_filter.column;
+        // Partition columns are not in the files, their filters prune whole files
+        if (column_filter.virtual_column || column.is_partition || !FileConditionSupportsType(column.type)) {
+            continue;
+        }
+        auto condition = FilterFileCondition(*column_filter.filter, column,
+                                             KeywordHelper::WriteQuoted(column.physical_name, '"'));
+        if (!condition.empty()) {
+            conditions.push_back(condition);
+        }
+    }
+    return StringUtil::Join(conditions, " AND ");
+}
+
+// =====================================================================
+// File pruning
+// =====================================================================
+
+// What a file tells about one column. Null min/max and empty counts are unknown.
+struct DeltaShareColumnRange {
+    Value min;
+    Value max;
+    std::optional<int64_t> null_count;
+    std::optional<int64_t> num_records;
+
+    bool AllNull() const {
+        return null_count && num_records && *null_count == *num_records;
+    }
+};
+
+static bool RangeMayMatch(const TableFilter &filter, const DeltaShareColumnRange &range) {
+    switch (filter.filter_type) {
+    case TableFilterType::CONSTANT_COMPARISON: {
+        if (range.AllNull()) {
+            // Comparisons with NULL are never true
+            return false;
+        }
+        auto &constant_filter = filter.Cast<ConstantFilter>();
+        auto &constant = constant_filter.constant;
+        bool has_min = !range.min.IsNull() && range.min.type() == constant.type();
+        bool has_max = !range.max.IsNull() && range.max.type() == constant.type();
+        switch (constant_filter.comparison_type) {
+        case ExpressionType::COMPARE_EQUAL:
+            return !(has_min && constant < range.min) && !(has_max && constant > range.max);
+        case ExpressionType::COMPARE_LESSTHAN:
+            return !(has_min && range.min >= constant);
+        case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            return !(has_min && range.min > constant);
+        case ExpressionType::COMPARE_GREATERTHAN:
+            return !(has_max && range.max <= constant);
+        case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            return !(has_max && range.max < constant);
+        default:
+            return true;
+        }
+    }
+    case TableFilterType::IS_NULL:
+        return !(range.null_count && *range.null_count == 0);
+    case TableFilterType::IS_NOT_NULL:
+        return !range.AllNull();
+    case TableFilterType::CONJUNCTION_AND:
+        for (auto &child : filter.Cast<ConjunctionAndFilter>().child_filters) {
+            if (!RangeMayMatch(*child, range)) {
+                return false;
+            }
+        }
+        return true;
+    case TableFilterType::CONJUNCTION_OR:
+        for (auto &child : filter.Cast<ConjunctionOrFilter>().child_filters) {
+            if (RangeMayMatch(*child, range)) {
+                return true;
+            }
+        }
+        return false;
+    default:
+        return true;
+    }
+}
+
+static Value CastRangeValue(const Value &value, const LogicalType &type) {
+    Value result;
+    string error;
+    if (!value.DefaultTryCastAs(type, result, &error)) {
+        return Value();
+    }
+    return result;
+}
+
+// Partition values are exact: the range of a file is a single value or NULL
+static DeltaShareColumnRange PartitionRange(const DeltaFileReference &file, const DeltaShareColumn &column) {
+    DeltaShareColumnRange range;
+    range.num_records = 1;
+    auto value = file.partition_values.find(column.physical_name);
+    if (value == file.partition_values.end()) {
+        value = file.partition_values.find(column.name);
+    }
+    if (value == file.partition_values.end()) {
+        range.null_count = 1;
+        return range;
+    }
+    range.null_count = 0;
+    range.min = CastRangeValue(Value(value->second), column.type);
+    range.max = range.min;
+    return range;
+}
+
+static yyjson_val *StatsColumnValue(yyjson_val *stats, const char *key, const DeltaShareColumn &column) {
+    auto values = yyjson_obj_get(stats, key);
+    auto value = yyjson_obj_get(values, column.physical_name.c_str());
+    return value ? value : yyjson_obj_get(values, column.name.c_str());
+}
+
+static Value StatsValue(yyjson_val *value, const LogicalType &type) {
+    if (yyjson_is_str(value)) {
+        return CastRangeValue(Value(string(yyjson_get_str(value), yyjson_get_len(value))), type);
+    }
+    if (yyjson_is_uint(value)) {
+        return CastRangeValue(Value::UBIGINT(yyjson_get_uint(value)), type);
+    }
+    if (yyjson_is_sint(value)) {
+        return CastRangeValue(Value::BIGINT(yyjson_get_sint(value)), type);
+    }
+    if (yyjson_is_real(value)) {
+        return CastRangeValue(Value::DOUBLE(yyjson_get_real(value)), type);
+    }
+    if (yyjson_is_bool(value)) {
+        return CastRangeValue(Value::BOOLEAN(yyjson_get_bool(value)), type);
+    }
+    return Value();
+}
+
+// min/max stats are only bounds for some types: string maxima are truncated by
+// the writers, float maxima leave out NaN, decimals come as doubles and
+// timestamps as UTC millis while the files may be read with a time zone
+static DeltaShareColumnRange StatsRange(yyjson_val *stats, const DeltaShareColumn &column) {
+    DeltaShareColumnRange range;
+    auto num_records = yyjson_obj_get(stats, "numRecords");
+    if (yyjson_is_int(num_records)) {
+        range.num_records = yyjson_get_sint(num_records);
+    }
+    auto null_count = StatsColumnValue(stats, "nullCount", column);
+    if (yyjson_is_int(null_count)) {
+        range.null_count = yyjson_get_sint(null_count);
+    }
+
+    bool use_min = false;
+    bool use_max = false;
+    switch (column.type.id()) {
+    case LogicalTypeId::BOOLEAN:
+    case LogicalTypeId::TINYINT:
+    case LogicalTypeId::SMALLINT:
+    case LogicalTypeId::INTEGER:
+    case LogicalTypeId::BIGINT:
+    case LogicalTypeId::DATE:
+        use_min = use_max = true;
+        break;
+    case LogicalTypeId::VARCHAR:
+    case LogicalTypeId::FLOAT:
+    case LogicalTypeId::DOUBLE:
+        use_min = true;
+        break;
+    default:
+        break;
+    }
+    if (use_min) {
+        range.min = StatsValue(StatsColumnValue(stats, "minValues", column), column.type);
+    }
+    if (use_max) {
+        range.max = StatsValue(StatsColumnValue(stats, "maxValues", column), column.type);
+    }
+    return range;
+}
+
+bool DeltaSharePushdown::MayMatch(const DeltaFileReference &file) const {
+    std::shared_ptr<yyjson_doc> stats_doc;
+    bool stats_read = false;
+
+    for (auto &column_filter : filters) {
+        auto &column = column_filter.column;
+        if (column_filter.virtual_column) {
+            continue;
+        }
+
+        DeltaShareColumnRange range;
+        if (column.is_partition) {
+            range = PartitionRange(file, column);
+        } else {
+            // Parsed once per file, and only when a data column is filtered
+            if (!stats_read) {
+                stats_read = true;
+                if (file.stats) {
+                    stats_doc = std::shared_ptr<yyjson_doc>(
+                        yyjson_read(file.stats->c_str(), file.stats->size(), 0), yyjson_doc_free);
+                }
+            }
+            auto stats = stats_doc ? yyjson_doc_get_root(stats_doc.get()) : nullptr;
+            if (!yyjson_is_obj(stats)) {
+                continue;
+            }
+            range = StatsRange(stats, column);
+        }
+
+        if (!RangeMayMatch(*column_filter.filter, range)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// =====================================================================
+// Exact check
+// =====================================================================
+
+unique_ptr<Expression> DeltaSharePushdown::OutputFilter(const vector<LogicalType> &output_types) const {
+    unique_ptr<Expression> result;
+    for (auto &column_filter : filters) {
+        BoundReferenceExpression column_ref(output_types[column_filter.output_index], column_filter.output_index);
+        auto expression = column_filter.filter->ToExpression(column_ref);
+        if (result) {
+            result = make_uniq<BoundConjunctionExpression>(ExpressionType::CONJUNCTION_AND, std::move(result),
+                                                           std::move(expression));
+        } else {
+            result = std::move(expression);
+        }
+    }
+    return result;
+}
+
+} // namespace erpl_web
@@ -1,7 +1,12 @@
 #include "delta_share_scan.hpp"
+#include "delta_share_cache.hpp"
 #include "tracing.hpp"
 #include "yyjson.hpp"
 #include "telemetry.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
+
+#include <algorithm>
 
 using namespace duckdb_yyjson;
 
@@ -13,15 +18,13 @@ using duckdb::PostHogTelemetry;
 // Bind Phase
 // =====================================================================
 
-static unique_ptr<FunctionData> DeltaShareScanBind(ClientContext& context,
-                                                   TableFunctionBindInput& input,
-                                                   vector<LogicalType>& return_types,
-                                                   vector<string>& names) {
-    PostHogTelemetry::Instance().CaptureFunctionExecution("delta_share_scan");
-    ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Bind phase starting");
-
-    auto bind_data = make_uniq<DeltaShareScanBindData>();
-
+// Loads the profile and the table schema named by the first four parameters,
+// shared by delta_share_scan and delta_share_changes
+static void BindDeltaShareTable(ClientContext& context,
+                                TableFunctionBindInput& input,
+                                DeltaShareScanBindData* bind_data,
+                                vector<LogicalType>& return_types,
+                                vector<string>& names) {
     // Parse parameters: profile_path, share, schema, table
     if (input.inputs.size() < 4) {
         throw InvalidInputException("delta_share_scan requires 4 parameters: "
@@ -105,6 +108,25 @@ static unique_ptr<FunctionData> DeltaShareScanBind(ClientContext& context,
                 names.push_back(field_name);
             }
 
+            // Under column mapping the files name their columns by the physical name
+            yyjson_arr_foreach(fields_arr, idx, max, field_item) {
+                auto name_val = yyjson_obj_get(field_item, "name");
+                if (!yyjson_is_obj(field_item) || !name_val || !yyjson_is_str(name_val)) {
+                    continue;
+                }
+                DeltaShareColumn column;
+                column.name = yyjson_get_str(name_val);
+                column.physical_name = column.name;
+                auto physical_val = yyjson_obj_get(yyjson_obj_get(field_item, "metadata"), "delta.columnMapping.physicalName");
+                if (physical_val && yyjson_is_str(physical_val)) {
+                    column.physical_name = yyjson_get_str(physical_val);
+                }
+                column.type = return_types[bind_data->columns.size()];
+                auto &partition_columns = bind_data->metadata.partition_columns;
+                column.is_partition = std::find(partition_columns.begin(), partition_columns.end(), column.name) != partition_columns.end();
+                bind_data->columns.push_back(std::move(column));
+            }
+
             if (names.empty()) {
                 throw InvalidInputException("No fields extracted from schema");
             }
@@ -115,21 +137,125 @@ static unique_ptr<FunctionData> DeltaShareScanBind(ClientContext& context,
         } catch (const std::exception& e) {
             ERPL_TRACE_ERROR("DELTA_SHARE_SCAN", "Error parsing schema: " + string(e.what()));
             // Fallback to simple schema
+            return_types.clear();
+            names.clear();
+            bind_data->columns.clear();
             return_types.push_back(LogicalType::VARCHAR);
             names.push_back("data");
             ERPL_TRACE_WARN("DELTA_SHARE_SCAN", "Using fallback schema after parsing error");
         }
     }
+    bind_data->fallback_schema = bind_data->columns.empty();
+    bind_data->metadata.column_names = names;
+    bind_data->metadata.duckdb_types = return_types;
+}
+
+static unique_ptr<FunctionData> DeltaShareScanBind(ClientContext& context,
+                                                   TableFunctionBindInput& input,
+                                                   vector<LogicalType>& return_types,
+                                                   vector<string>& names) {
+    PostHogTelemetry::Instance().CaptureFunctionExecution("delta_share_scan");
+    ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Bind phase starting");
+
+    auto bind_data = make_uniq<DeltaShareScanBindData>();
+    BindDeltaShareTable(context, input, bind_data.get(), return_types, names);
+
+    auto limit_hint = input.named_parameters.find("limit_hint");
+    if (limit_hint != input.named_parameters.end() && !limit_hint->second.IsNull()) {
+        bind_data->limit_hint = limit_hint->second.GetValue<int64_t>();
+    }
 
     ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Bind phase complete");
 
     return bind_data;
 }
 
+static unique_ptr<FunctionData> DeltaShareChangesBind(ClientContext& context,
+                                                      TableFunctionBindInput& input,
+                                                      vector<LogicalType>& return_types,
+                                                      vector<string>& names) {
+    PostHogTelemetry::Instance().CaptureFunctionExecution("delta_share_changes");
+    ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Changes bind phase starting");
+
+    auto bind_data = make_uniq<DeltaShareScanBindData>();
+    BindDeltaShareTable(context, input, bind_data.get(), return_types, names);
+
+    if (input.inputs[4].IsNull()) {
+        throw InvalidInputException("delta_share_changes requires a starting_version");
+    }
+    bind_data->change_feed = true;
+    bind_data->starting_version = input.inputs[4].GetValue<int64_t>();
+    if (!input.inputs[5].IsNull()) {
+        bind_data->ending_version = input.inputs[5].GetValue<int64_t>();
+        if (bind_data->ending_version.value() < bind_data->starting_version) {
+            throw InvalidInputException("delta_share_changes: ending_version %lld is before starting_version %lld",
+                                        (long long)bind_data->ending_version.value(),
+                                        (long long)bind_data->starting_version);
+        }
+    }
+
+    // Change columns follow the table columns, as in Delta's own change data feed
+    bind_data->change_columns_start = return_types.size();
+    return_types.push_back(LogicalType::VARCHAR);
+    names.push_back("_change_type");
+    return_types.push_back(LogicalType::BIGINT);
+    names.push_back("_commit_version");
+    return_types.push_back(LogicalType::TIMESTAMP);
+    names.push_back("_commit_timestamp");
+
+    ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Changes bind phase complete");
+
+    return bind_data;
+}
+
 // =====================================================================
-// Init Global Phase (fetches metadata and file list once)
+// Init Global Phase (starts listing the files once)
 // =====================================================================
 
+// Lists the files of the current version of the table, from the file list
+// cache when the version was listed before with the same hints. Only a
+// complete listing is cached, one stopped early by a LIMIT misses files.
+static void ListDeltaShareSnapshot(DeltaShareClient& client, const DeltaShareProfile& profile, const string& share,
+                                   const string& schema, const string& table, DeltaShareQueryRequest request,
+                                   const DeltaFileCallback& on_file) {
+    auto& cache = DeltaShareFileListCache::GetInstance();
+    if (!cache.IsEnabled()) {
+        client.StreamQueryTable(share, schema, table, request, on_file);
+        return;
+    }
+
+    // Pinned, so the listed files are exactly those of the version in the key
+    try {
+        request.version = client.GetTableVersion(share, schema, table);
+    } catch (const std::exception& e) {
+        ERPL_TRACE_WARN("DELTA_SHARE_SCAN", "Not caching the file list, no table version: " + string(e.what()));
+        client.StreamQueryTable(share, schema, table, request, on_file);
+        return;
+    }
+    auto key = DeltaShareFileListCache::Key(profile, share, schema, table, request);
+    if (auto files = cache.Get(key)) {
+        ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Using " + std::to_string(files->size()) + " cached files of version " +
+                       std::to_string(request.version.value()));
+        for (auto& file : *files) {
+            if (!on_file(file)) {
+                return;
+            }
+        }
+        return;
+    }
+
+    vector<DeltaFileReference> files;
+    bool complete = true;
+    client.StreamQueryTable(share, schema, table, request, [&](DeltaFileReference file) {
+        files.push_back(file);
+        complete = on_file(std::move(file));
+        return complete;
+    });
+    if (complete) {
+        cache.Put(key, std::move(files));
+    }
+}
+
 static unique_ptr<GlobalTableFunctionState> DeltaShareScanInitGlobal(ClientContext& context,
                                                                      TableFunctionInitInput& input) {
     ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "InitGlobal phase starting");
@@ -142,34 +268,67 @@ static unique_ptr<GlobalTableFunctionState> DeltaShareScanInitGlobal(ClientConte
 
     // Store metadata from bind phase
     global_state->metadata = bind_data.metadata;
-
-    // Fetch complete file list with pre-signed URLs from Delta Sharing server
-    // This is done once in InitGlobal and shared read-only across all threads
-    try {
-        global_state->files = global_state->client->QueryTable(bind_data.share, bind_data.schema, bind_data.table);
-        ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Fetched " + std::to_string(global_state->files.size()) + " files from Delta Sharing");
-
-        if (global_state->files.empty()) {
-            ERPL_TRACE_WARN("DELTA_SHARE_SCAN", "No files found for table");
+    global_state->column_ids = input.column_ids;
+    global_state->pushdown = DeltaSharePushdown(bind_data.columns, input.column_ids, input.filters);
+    global_state->file_condition = global_state->pushdown.FileCondition();
+
+    // The server may skip files on the hints, it is free to ignore them
+    DeltaShareQueryRequest request;
+    request.json_predicate_hints = global_state->pushdown.JsonPredicateHints();
+    if (bind_data.limit_hint.has_value()) {
+        if (global_state->pushdown.HasFilters()) {
+            // The server would count rows before our filters drop any
+            ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Not sending limit hint, the scan has filters");
         } else {
-            // Log first few file URLs for debugging
-            for (size_t i = 0; i < global_state->files.size() && i < 3; ++i) {
-                ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "File " + std::to_string(i) + ": " +
-                    global_state->files[i].url.substr(0, 80) + "... (size: " +
-                    std::to_string(global_state->files[i].size) + " bytes)");
-            }
+            request.limit_hint = bind_data.limit_hint;
         }
-    } catch (const std::exception& e) {
-        throw InvalidInputException("Failed to query Delta Sharing table: " + string(e.what()));
+    }
+    if (!request.json_predicate_hints.empty()) {
+        ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Predicate hints: " + request.json_predicate_hints);
     }
 
+    // The file list is streamed into the queue on a background thread, the scan
+    // threads start reading the first files while later lines are still arriving
+    global_state->max_threads = TaskScheduler::GetScheduler(context).NumberOfThreads();
+    auto client = global_state->client;
+    auto& pushdown = global_state->pushdown;
+    auto profile = bind_data.profile;
+    auto share = bind_data.share;
+    auto schema = bind_data.schema;
+    auto table = bind_data.table;
+    auto change_feed = bind_data.change_feed;
+    auto starting_version = bind_data.starting_version;
+    auto ending_version = bind_data.ending_version;
+    global_state->files = make_uniq<DeltaFileQueue>(
+        [client, &pushdown, profile, share, schema, table, request, change_feed, starting_version,
+         ending_version](const DeltaFileQueue::FileCallback& on_file) {
+            uint64_t listed = 0;
+            uint64_t pruned = 0;
+            auto on_listed = [&](DeltaFileReference file) {
+                listed++;
+                // Pruned on partition values and stats before any file is opened
+                if (pushdown.HasFilters() && !pushdown.MayMatch(file)) {
+                    pruned++;
+                    return true;
+                }
+                return on_file(std::move(file));
+            };
+            if (change_feed) {
+                client->StreamTableChanges(share, schema, table, starting_version, ending_version, on_listed);
+            } else {
+                ListDeltaShareSnapshot(*client, profile, share, schema, table, request, on_listed);
+            }
+            ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Listed " + std::to_string(listed) + " files from Delta Sharing, pruned " +
+                           std::to_string(pruned) + " on partition values and stats");
+        });
+
     ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "InitGlobal phase complete");
 
     return global_state;
 }
 
 // =====================================================================
-// Init Local Phase (creates per-thread HTTP client)
+// Init Local Phase (creates the per-thread connection)
 // =====================================================================
 
 static unique_ptr<LocalTableFunctionState> DeltaShareScanInitLocal(ExecutionContext& context,
@@ -177,19 +336,9 @@ static unique_ptr<LocalTableFunctionState> DeltaShareScanInitLocal(ExecutionCont
                                                                    GlobalTableFunctionState* gstate) {
     ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "InitLocal phase starting for thread");
 
-    auto& global_state = *static_cast<DeltaShareGlobalState*>(gstate);
     auto local_state = make_uniq<DeltaShareLocalState>();
-
-    // Create per-thread HTTP client
-    // Each thread gets its own client instance for connection reuse via keep-alive
-    // No global synchronization needed—lock-free design
-    try {
-        local_state->http_client = global_state.client;  // Reuse shared client, it's thread-safe
-        ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Per-thread HTTP client reference initialized");
-    } catch (const std::exception& e) {
-        ERPL_TRACE_ERROR("DELTA_SHARE_SCAN", "Failed to create per-thread HTTP client: " + string(e.what()));
-        throw InvalidInputException("Failed to create per-thread HTTP client: " + string(e.what()));
-    }
+    // One connection per thread, reused for every file the thread claims
+    local_state->connection = make_uniq<Connection>(*context.client.db);
 
     ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "InitLocal phase complete");
 
@@ -197,70 +346,173 @@ static unique_ptr<LocalTableFunctionState> DeltaShareScanInitLocal(ExecutionCont
 }
 
 // =====================================================================
-// Scan Phase (with atomic lock-free work distribution)
+// File Query
 // =====================================================================
 
-static void DeltaShareScan(ClientContext& context, TableFunctionInput& input, DataChunk& output) {
-    ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Scan phase starting");
+static string QuoteDeltaShareIdentifier(const string& name) {
+    return "\"" + StringUtil::Replace(name, "\"", "\"\"") + "\"";
+}
 
-    auto& global_state = input.global_state->Cast<DeltaShareGlobalState>();
+// _change_type, _commit_version and _commit_timestamp of the rows of a file.
+// cdf files carry the change type of every row, the rows of added files were
+// inserted and those of removed files deleted by the commit.
+static string DeltaShareChangeColumn(idx_t change_column, const DeltaFileReference& file) {
+    switch (change_column) {
+    case 0:
+        if (file.action == "cdf") {
+            return "CAST(" + QuoteDeltaShareIdentifier("_change_type") + " AS VARCHAR)";
+        }
+        return file.action == "remove" ? "'delete'" : "'insert'";
+    case 1:
+        return file.version ? "CAST(" + std::to_string(*file.version) + " AS BIGINT)" : "CAST(NULL AS BIGINT)";
+    default:
+        if (!file.timestamp) {
+            return "CAST(NULL AS TIMESTAMP)";
+        }
+        return "CAST(" + Value::TIMESTAMP(Timestamp::FromEpochMs(*file.timestamp)).ToSQLString() + " AS TIMESTAMP)";
+    }
+}
 
-    // Lock-free work distribution: each thread atomically claims next file index
-    // fetch_add returns old value, so each thread gets unique file
-    idx_t file_idx = global_state.current_file_index.fetch_add(1);
+string DeltaShareFileQuery(const DeltaShareScanBindData& bind_data,
+                           const vector<column_t>& column_ids,
+                           const vector<LogicalType>& output_types,
+                           const DeltaFileReference& file,
+                           const string& condition,
+                           const string& local_path) {
+    vector<string> select_list;
+    for (idx_t i = 0; i < column_ids.size(); i++) {
+        auto column_id = column_ids[i];
+        if (bind_data.fallback_schema && column_id == 0) {
+            // Without a schema the whole row is returned as text
+            select_list.push_back("CAST(delta_file AS VARCHAR)");
+            continue;
+        }
+        if (bind_data.change_feed && column_id >= bind_data.change_columns_start &&
+            column_id < bind_data.change_columns_start + 3) {
+            select_list.push_back(DeltaShareChangeColumn(column_id - bind_data.change_columns_start, file));
+            continue;
+        }
+        if (column_id >= bind_data.columns.size()) {
+            // Row id and other virtual columns, the files have no values for them
+            select_list.push_back("CAST(NULL AS " + output_types[i].ToString() + ")");
+            continue;
+        }
 
-    // Check if all files have been assigned (this thread got index >= file count)
-    if (file_idx >= global_state.files.size()) {
-        ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "All files processed, thread returning empty result");
-        output.SetCardinality(0);
-        return;
+        auto& column = bind_data.columns[column_id];
+        auto type = column.type.ToString();
+        if (column.is_partition) {
+            auto value = file.partition_values.find(column.physical_name);
+            if (value == file.partition_values.end()) {
+                value = file.partition_values.find(column.name);
+            }
+            auto literal = value != file.partition_values.end() ? Value(value->second).ToSQLString() : string("NULL");
+            select_list.push_back("CAST(" + literal + " AS " + type + ")");
+        } else {
+            select_list.push_back("CAST(" + QuoteDeltaShareIdentifier(column.physical_name) + " AS " + type + ")");
+        }
+    }
+    if (select_list.empty()) {
+        select_list.push_back("NULL");
     }
 
-    // Get the file this thread claimed
-    auto& file_ref = global_state.files[file_idx];
+    auto& source = local_path.empty() ? file.url : local_path;
+    auto query = "SELECT " + StringUtil::Join(select_list, ", ") + " FROM read_parquet(" +
+                 Value(source).ToSQLString() + ") AS delta_file";
+    if (!condition.empty()) {
+        query += " WHERE " + condition;
+    }
+    return query;
+}
 
-    ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Thread reading Parquet file " + std::to_string(file_idx) + "/" +
-                   std::to_string(global_state.files.size()) + ": " + file_ref.url.substr(0, 80) + "...");
+// =====================================================================
+// Scan Phase (threads claim files from the queue)
+// =====================================================================
 
-    try {
-        // Use per-thread HTTP client for connection reuse
-        // The pre-signed URL is valid for a limited time and has built-in credentials
-        string parquet_query = "SELECT * FROM parquet_scan('" + file_ref.url + "')";
+static void DeltaShareScan(ClientContext& context, TableFunctionInput& input, DataChunk& output) {
+    auto& bind_data = input.bind_data->Cast<DeltaShareScanBindData>();
+    auto& global_state = input.global_state->Cast<DeltaShareGlobalState>();
+    auto& local_state = input.local_state->Cast<DeltaShareLocalState>();
+
+    while (true) {
+        if (!local_state.file_result) {
+            // Blocks until the listing has the next file or is complete
+            bool claimed;
+            try {
+                claimed = global_state.files->Next(local_state.file, local_state.file_index);
+            } catch (const std::exception& e) {
+                throw InvalidInputException("Failed to query Delta Sharing table: " + string(e.what()));
+            }
+            if (!claimed) {
+                ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "All files claimed, thread is done");
+                output.SetCardinality(0);
+                return;
+            }
 
-        ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Executing Parquet query from thread with per-thread HTTP client");
+            auto& file_ref = local_state.file;
+            ERPL_TRACE_INFO("DELTA_SHARE_SCAN", "Thread reading Parquet file " + std::to_string(local_state.file_index) +
+                           " (" + std::to_string(global_state.files->ListedFiles()) + " listed so far): " +
+                           file_ref.url.substr(0, 80) + "...");
 
-        Connection con(*context.db);
-        auto result = con.Query(parquet_query);
+            vector<LogicalType> output_types;
+            for (auto& column : output.data) {
+                output_types.push_back(column.GetType());
+            }
+            if (!local_state.filter_initialized) {
+                local_state.filter_initialized = true;
+                local_state.filter = global_state.pushdown.OutputFilter(output_types);
+                if (local_state.filter) {
+                    local_state.filter_executor = make_uniq<ExpressionExecutor>(context, *local_state.filter);
+                    local_state.filter_sel.Initialize(STANDARD_VECTOR_SIZE);
+                }
+            }
+            // Read from its local copy when the disk cache has one or could make one
+            string local_path;
+            auto& disk_cache = DeltaShareDiskCache::GetInstance();
+            if (disk_cache.IsEnabled()) {
+                auto file_name = DeltaShareDiskCache::FileName(bind_data.profile, bind_data.share, bind_data.schema,
+                                                               bind_data.table, file_ref);
+                local_state.local_copy = disk_cache.Resolve(file_name, file_ref.size, [&](const string& path) {
+                    global_state.client->DownloadFile(file_ref, path);
+                });
+                if (local_state.local_copy) {
+                    local_path = local_state.local_copy->Path();
+                }
+            }
+            // Streamed, the file is read chunk by chunk as the scan asks for it
+            local_state.file_result = local_state.connection->SendQuery(DeltaShareFileQuery(
+                bind_data, global_state.column_ids, output_types, file_ref, global_state.file_condition, local_path));
+            if (local_state.file_result->HasError()) {
+                throw IOException("Failed to read Delta Sharing file %llu (%s): %s",
+                                  (unsigned long long)local_state.file_index, file_ref.id,
+                                  local_state.file_result->GetError());
+            }
+        }
 
-        // Check if we got any data
-        if (result->HasError()) {
-            ERPL_TRACE_ERROR("DELTA_SHARE_SCAN", "Query error: " + result->GetError());
-            throw InvalidInputException("Failed to read Parquet file: " + result->GetError());
+        auto chunk = local_state.file_result->Fetch();
+        if (local_state.file_result->HasError()) {
+            throw IOException("Failed to read Delta Sharing file %llu: %s",
+                              (unsigned long long)local_state.file_index, local_state.file_result->GetError());
+        }
+        if (!chunk || chunk->size() == 0) {
+            ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Finished file " + std::to_string(local_state.file_index));
+            local_state.file_result.reset();
+            local_state.local_copy.reset();
+            continue;
         }
 
-        // Fetch result chunk
-        auto chunk = result->Fetch();
-        if (chunk && chunk->size() > 0) {
-            // Reference the chunk data into output
-            output.Reference(*chunk);
-            ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "Read " + std::to_string(chunk->size()) + " rows from file " + std::to_string(file_idx));
-        } else {
-            // Empty file - set cardinality to 0 and initialize vectors
-            for (idx_t i = 0; i < output.ColumnCount(); ++i) {
-                output.data[i].SetVectorType(VectorType::FLAT_VECTOR);
+        if (local_state.filter_executor) {
+            // Pushed down filters are not applied after the scan, every row is checked here
+            auto count = local_state.filter_executor->SelectExpression(*chunk, local_state.filter_sel);
+            if (count == 0) {
+                continue;
+            }
+            if (count < chunk->size()) {
+                chunk->Slice(local_state.filter_sel, count);
             }
-            output.SetCardinality(0);
-            ERPL_TRACE_DEBUG("DELTA_SHARE_SCAN", "File " + std::to_string(file_idx) + " is empty, returned 0 rows");
         }
 
-    } catch (const std::exception& e) {
-        ERPL_TRACE_ERROR("DELTA_SHARE_SCAN", "Failed to read Parquet file " + std::to_string(file_idx) + ": " + string(e.what()));
-
-        // Return empty result on error (caller will retry or continue)
-        for (idx_t i = 0; i < output.ColumnCount(); ++i) {
-            output.data[i].SetVectorType(VectorType::FLAT_VECTOR);
-        }
-        output.SetCardinality(0);
+        output.Reference(*chunk);
+        return;
     }
 }
 
@@ -275,19 +527,45 @@ TableFunctionSet CreateDeltaShareScanFunction() {
 
     // Create table function with parallel execution support
     // - Bind phase: parse parameters and fetch metadata
-    // - InitGlobal phase: fetch complete file list (once, shared across threads)
-    // - InitLocal phase: create per-thread HTTP client for connection reuse
-    // - Scan phase: atomic lock-free work distribution via file index
+    // - InitGlobal phase: start streaming the file list into the shared queue
+    // - InitLocal phase: create the per-thread connection the files are read on
+    // - Scan phase: threads claim files from the queue as they are listed, every chunk of a file is streamed
     TableFunction scan_function(
         {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
         DeltaShareScan,
         DeltaShareScanBind,
-        DeltaShareScanInitGlobal,  // InitGlobal: metadata + file list
-        DeltaShareScanInitLocal);  // InitLocal: per-thread HTTP client
+        DeltaShareScanInitGlobal,  // InitGlobal: metadata + file queue
+        DeltaShareScanInitLocal);  // InitLocal: per-thread connection
+    // Only the projected columns are read from the files
+    scan_function.projection_pushdown = true;
+    // Filters become predicate hints, prune files and are checked on every chunk
+    scan_function.filter_pushdown = true;
+    scan_function.named_parameters["limit_hint"] = LogicalType::BIGINT;
 
     function_set.AddFunction(scan_function);
 
     return function_set;
 }
 
+TableFunctionSet CreateDeltaShareChangesFunction() {
+    ERPL_TRACE_DEBUG("DELTA_SHARE", "Registering delta_share_changes table function");
+
+    TableFunctionSet function_set("delta_share_changes");
+
+    // Same phases as delta_share_scan, the files are the actions of the change data feed
+    TableFunction changes_function(
+        {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+         LogicalType::BIGINT, LogicalType::BIGINT},
+        DeltaShareScan,
+        DeltaShareChangesBind,
+        DeltaShareScanInitGlobal,
+        DeltaShareScanInitLocal);
+    changes_function.projection_pushdown = true;
+    changes_function.filter_pushdown = true;
+
+    function_set.AddFunction(changes_function);
+
+    return function_set;
+}
+
 } // namespace erpl_web
@@ -25,6 +25,7 @@
 #include "delta_share_scan.hpp"
 #include "delta_share_storage.hpp"
 #include "delta_share_catalog.hpp"
+#include "delta_share_cache.hpp"
 #include "microsoft_entra_secret.hpp"
 #include "business_central_secret.hpp"
 #include "business_central_functions.hpp"
@@ -42,6 +43,10 @@
 #include "graph_outlook_functions.hpp"
 #include "graph_entra_functions.hpp"
 #include "graph_teams_functions.hpp"
+#include "http_connection_pool.hpp"
+#include "http_disk_cache.hpp"
+#include "http_rate_limiter.hpp"
+#include "odata_page_prefetcher.hpp"
 #include "telemetry.hpp"
 #include "tracing.hpp"
 
@@ -171,6 +176,154 @@ static void OnTraceRotation(ClientContext &context, SetScope scope, Value &param
     erpl_web::ErplTracer::Instance().SetRotation(rotation);
 }
 
+static void OnHttpPoolEnabled(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto enabled = parameter.GetValue<bool>();
+    erpl_web::HttpConnectionPool::GetInstance().SetEnabled(enabled);
+}
+
+static void OnHttpPoolMaxIdlePerHost(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_idle = parameter.GetValue<int64_t>();
+    if (max_idle < 0) {
+        throw BinderException("HTTP pool max idle connections per host must be non-negative");
+    }
+    erpl_web::HttpConnectionPool::GetInstance().SetMaxIdlePerHost(static_cast<uint64_t>(max_idle));
+}
+
+static void OnHttpPoolIdleTimeout(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto idle_timeout_ms = parameter.GetValue<int64_t>();
+    if (idle_timeout_ms < 0) {
+        throw BinderException("HTTP pool idle timeout must be non-negative");
+    }
+    erpl_web::HttpConnectionPool::GetInstance().SetIdleTimeout(std::chrono::milliseconds(idle_timeout_ms));
+}
+
+static uint64_t GetNonNegativeSetting(const Value &parameter, const std::string &description)
+{
+    auto value = parameter.GetValue<int64_t>();
+    if (value < 0) {
+        throw BinderException(description + " must be non-negative");
+    }
+    return static_cast<uint64_t>(value);
+}
+
+static void OnHttpCacheMaxBytes(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_bytes = GetNonNegativeSetting(parameter, "HTTP cache memory limit");
+    erpl_web::HttpCachePolicy::GetInstance().SetMaxBytes(max_bytes);
+}
+
+static void OnHttpCacheMetadataTtl(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto ttl_ms = GetNonNegativeSetting(parameter, "HTTP cache metadata TTL");
+    erpl_web::HttpCachePolicy::GetInstance().SetMetadataTtl(ttl_ms);
+}
+
+static void OnHttpCacheServiceDocumentTtl(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto ttl_ms = GetNonNegativeSetting(parameter, "HTTP cache service document TTL");
+    erpl_web::HttpCachePolicy::GetInstance().SetServiceDocumentTtl(ttl_ms);
+}
+
+static void OnHttpCacheLookupTtl(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto ttl_ms = GetNonNegativeSetting(parameter, "HTTP cache lookup TTL");
+    erpl_web::HttpCachePolicy::GetInstance().SetLookupTtl(ttl_ms);
+}
+
+static void OnHttpCacheLookupMaxBytes(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_bytes = GetNonNegativeSetting(parameter, "HTTP cache lookup size limit");
+    erpl_web::HttpCachePolicy::GetInstance().SetLookupMaxBytes(max_bytes);
+}
+
+static void OnHttpCacheDirectory(ClientContext &context, SetScope scope, Value &parameter)
+{
+    erpl_web::HttpDiskCache::GetInstance().SetDirectory(parameter.ToString());
+}
+
+static void OnHttpRateLimitRequestsPerSecond(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto requests_per_second = parameter.GetValue<double>();
+    if (requests_per_second < 0) {
+        throw BinderException("HTTP rate limit must be non-negative");
+    }
+    erpl_web::HttpRateLimiter::GetInstance().SetRequestsPerSecond(requests_per_second);
+}
+
+static void OnHttpRateLimitBurst(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto burst = parameter.GetValue<int64_t>();
+    if (burst < 1) {
+        throw BinderException("HTTP rate limit burst must be at least 1");
+    }
+    erpl_web::HttpRateLimiter::GetInstance().SetBurst(static_cast<uint64_t>(burst));
+}
+
+static void OnHttpMaxRetryAfter(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_retry_after_ms = GetNonNegativeSetting(parameter, "HTTP max Retry-After");
+    erpl_web::HttpRateLimiter::GetInstance().SetMaxRetryAfter(std::chrono::milliseconds(max_retry_after_ms));
+}
+
+// OData scan settings are read at scan initialization, the callbacks only validate
+static void OnODataScanThreads(ClientContext &context, SetScope scope, Value &parameter)
+{
+    if (parameter.GetValue<int64_t>() < 1) {
+        throw BinderException("OData scan threads must be at least 1");
+    }
+}
+
+static void OnODataScanPartitionSize(ClientContext &context, SetScope scope, Value &parameter)
+{
+    if (parameter.GetValue<int64_t>() < 1) {
+        throw BinderException("OData scan partition size must be at least 1");
+    }
+}
+
+static void OnODataPrefetchDepth(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto depth = parameter.GetValue<int64_t>();
+    if (depth < 0) {
+        throw BinderException("OData prefetch depth must be non-negative");
+    }
+    erpl_web::ODataPrefetchSettings::GetInstance().SetDepth(static_cast<uint64_t>(depth));
+}
+
+static void OnODataPrefetchMaxBytes(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_bytes = parameter.GetValue<int64_t>();
+    if (max_bytes < 0) {
+        throw BinderException("OData prefetch memory limit must be non-negative");
+    }
+    erpl_web::ODataPrefetchSettings::GetInstance().SetMaxBytes(static_cast<uint64_t>(max_bytes));
+}
+
+static void OnDeltaShareFileListCacheTtl(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto ttl_ms = GetNonNegativeSetting(parameter, "Delta Sharing file list cache TTL");
+    erpl_web::DeltaShareFileListCache::GetInstance().SetTtl(ttl_ms);
+}
+
+static void OnDeltaShareFileListCacheMaxEntries(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_entries = GetNonNegativeSetting(parameter, "Delta Sharing file list cache size");
+    erpl_web::DeltaShareFileListCache::GetInstance().SetMaxEntries(max_entries);
+}
+
+static void OnDeltaShareCacheDirectory(ClientContext &context, SetScope scope, Value &parameter)
+{
+    erpl_web::DeltaShareDiskCache::GetInstance().SetDirectory(parameter.ToString());
+}
+
+static void OnDeltaShareCacheMaxBytes(ClientContext &context, SetScope scope, Value &parameter)
+{
+    auto max_bytes = GetNonNegativeSetting(parameter, "Delta Sharing cache size");
+    erpl_web::DeltaShareDiskCache::GetInstance().SetMaxBytes(max_bytes);
+}
+
 // Pragma function to enable/disable tracing
 static string EnableTracingPragmaFunction(ClientContext &context, const FunctionParameters &parameters) {
     if (parameters.values.empty()) {
@@ -249,6 +402,73 @@ static void RegisterConfiguration(DatabaseInstance &instance)
                                   LogicalTypeId::BIGINT, Value(10485760), OnTraceMaxFileSize);
     config.AddExtensionOption("erpl_trace_rotation", "Enable ERPL Web extension trace file rotation", 
                                   LogicalTypeId::BOOLEAN, Value(true), OnTraceRotation);
+
+    // HTTP connection pool options
+    config.AddExtensionOption("erpl_http_pool_enabled", "Reuse keep-alive HTTP connections across requests to the same origin",
+                                  LogicalTypeId::BOOLEAN, Value(erpl_web::HttpConnectionPool::DEFAULT_ENABLED), OnHttpPoolEnabled);
+    config.AddExtensionOption("erpl_http_pool_max_idle_per_host", "Maximum number of idle HTTP connections kept per origin",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpConnectionPool::DEFAULT_MAX_IDLE_PER_HOST),
+                                  OnHttpPoolMaxIdlePerHost);
+    config.AddExtensionOption("erpl_http_pool_idle_timeout_ms", "Idle time in milliseconds after which a pooled HTTP connection is closed",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpConnectionPool::DEFAULT_IDLE_TIMEOUT_MS),
+                                  OnHttpPoolIdleTimeout);
+
+    // HTTP response cache options
+    config.AddExtensionOption("erpl_http_cache_max_bytes", "Maximum bytes held by the HTTP response cache (0 disables caching)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpCachePolicy::DEFAULT_MAX_BYTES), OnHttpCacheMaxBytes);
+    config.AddExtensionOption("erpl_http_cache_metadata_ttl_ms", "Time in milliseconds a cached $metadata document stays valid (0 disables)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpCachePolicy::DEFAULT_METADATA_TTL_MS),
+                                  OnHttpCacheMetadataTtl);
+    config.AddExtensionOption("erpl_http_cache_service_document_ttl_ms", "Time in milliseconds a cached OData service document stays valid (0 disables)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpCachePolicy::DEFAULT_SERVICE_DOCUMENT_TTL_MS),
+                                  OnHttpCacheServiceDocumentTtl);
+    config.AddExtensionOption("erpl_http_cache_lookup_ttl_ms", "Time in milliseconds a cached small lookup response (e.g. $count) stays valid (0 disables)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpCachePolicy::DEFAULT_LOOKUP_TTL_MS),
+                                  OnHttpCacheLookupTtl);
+    config.AddExtensionOption("erpl_http_cache_directory", "Directory persisting cached $metadata and service documents across processes (empty disables)",
+                                  LogicalTypeId::VARCHAR, Value(""), OnHttpCacheDirectory);
+    config.AddExtensionOption("erpl_http_cache_lookup_max_bytes", "Largest lookup response in bytes that is kept in the HTTP cache",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpCachePolicy::DEFAULT_LOOKUP_MAX_BYTES),
+                                  OnHttpCacheLookupMaxBytes);
+
+    // Per-host HTTP rate limiting options
+    config.AddExtensionOption("erpl_http_rate_limit_requests_per_second", "Maximum requests per second sent to a single host (0 disables the ceiling, throttling responses are always honoured)",
+                                  LogicalTypeId::DOUBLE, Value::DOUBLE(erpl_web::HttpRateLimiter::DEFAULT_REQUESTS_PER_SECOND),
+                                  OnHttpRateLimitRequestsPerSecond);
+    config.AddExtensionOption("erpl_http_rate_limit_burst", "Number of requests a host may receive at once before the rate limit applies",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpRateLimiter::DEFAULT_BURST), OnHttpRateLimitBurst);
+    config.AddExtensionOption("erpl_http_max_retry_after_ms", "Longest pause in milliseconds honoured from a Retry-After header of a throttled host",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::HttpRateLimiter::DEFAULT_MAX_RETRY_AFTER_MS),
+                                  OnHttpMaxRetryAfter);
+
+    // Partitioned OData scan options
+    config.AddExtensionOption("erpl_odata_scan_threads", "Number of threads reading $skip/$top partitions of an OData entity set (1 disables partitioning)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::ODataScanOptions::DEFAULT_THREADS), OnODataScanThreads);
+    config.AddExtensionOption("erpl_odata_scan_partition_size", "Number of rows per partition of a parallel OData scan",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::ODataScanOptions::DEFAULT_PARTITION_SIZE),
+                                  OnODataScanPartitionSize);
+    config.AddExtensionOption("erpl_odata_scan_ordered", "Order partitions of a parallel OData scan by the entity key when no $orderby is given",
+                                  LogicalTypeId::BOOLEAN, Value(erpl_web::ODataScanOptions::DEFAULT_ORDERED));
+
+    // OData page prefetch options
+    config.AddExtensionOption("erpl_odata_prefetch_depth", "Number of OData pages fetched ahead in the background while a scan emits rows (0 disables prefetching)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::ODataPrefetchSettings::DEFAULT_DEPTH), OnODataPrefetchDepth);
+    config.AddExtensionOption("erpl_odata_prefetch_max_bytes", "Maximum response bytes held by prefetched OData pages per scan",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::ODataPrefetchSettings::DEFAULT_MAX_BYTES),
+                                  OnODataPrefetchMaxBytes);
+
+    // Delta Sharing cache options
+    config.AddExtensionOption("erpl_delta_share_file_list_cache_ttl_ms", "Time in milliseconds the files listed for a Delta Sharing table version are reused (0 disables)",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::DeltaShareFileListCache::DEFAULT_TTL_MS),
+                                  OnDeltaShareFileListCacheTtl);
+    config.AddExtensionOption("erpl_delta_share_file_list_cache_max_entries", "Number of Delta Sharing file lists kept in memory",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::DeltaShareFileListCache::DEFAULT_MAX_ENTRIES),
+                                  OnDeltaShareFileListCacheMaxEntries);
+    config.AddExtensionOption("erpl_delta_share_cache_directory", "Directory keeping local copies of Delta Sharing Parquet files across scans and processes (empty disables)",
+                                  LogicalTypeId::VARCHAR, Value(""), OnDeltaShareCacheDirectory);
+    config.AddExtensionOption("erpl_delta_share_cache_max_bytes", "Maximum bytes of Delta Sharing files kept in the cache directory",
+                                  LogicalTypeId::BIGINT, Value::BIGINT(erpl_web::DeltaShareDiskCache::DEFAULT_MAX_BYTES),
+                                  OnDeltaShareCacheMaxBytes);
 }
 
 static void RegisterWebFunctions(ExtensionLoader &loader)
@@ -350,6 +570,27 @@ static void RegisterWebFunctions(ExtensionLoader &loader)
         loader.RegisterFunction(std::move(info));
     }
 
+    {
+        CreateTableFunctionInfo info(erpl_web::CreateHttpFanoutFunction());
+        FunctionDescription desc;
+        desc.description = "Send one HTTP request per input row (url, optional body, headers, content_type, method) with bounded concurrency and return each row with its response.";
+        desc.parameter_names = {"requests"};
+        desc.parameter_types = {LogicalType::TABLE};
+        desc.examples = {"SELECT url, response.status FROM http_fanout((SELECT 'https://httpbin.org/anything/' || i AS url FROM range(10) t(i)), max_concurrency := 4)"};
+        desc.categories = {"http"};
+        info.descriptions.push_back(std::move(desc));
+        loader.RegisterFunction(std::move(info));
+    }
+    {
+        CreateTableFunctionInfo info(erpl_web::CreateHttpCacheStatsFunction());
+        FunctionDescription desc;
+        desc.description = "Return size and hit, miss and eviction counters of the shared HTTP response cache.";
+        desc.examples = {"SELECT hits, misses, bytes FROM http_cache_stats()"};
+        desc.categories = {"http"};
+        info.descriptions.push_back(std::move(desc));
+        loader.RegisterFunction(std::move(info));
+    }
+
     erpl::CreateBasicSecretFunctions::Register(loader);
     erpl::CreateBearerTokenSecretFunctions::Register(loader);
     erpl_web::CreateMicrosoftEntraSecretFunctions::Register(loader);
@@ -648,6 +889,18 @@ static void RegisterDeltaShareFunctions(ExtensionLoader &loader)
         info.descriptions.push_back(std::move(desc));
         loader.RegisterFunction(std::move(info));
     }
+    {
+        CreateTableFunctionInfo info(erpl_web::CreateDeltaShareChangesFunction());
+        FunctionDescription desc;
+        desc.description = "Read the change data feed of a Delta Sharing table between two versions, with _change_type, _commit_version and _commit_timestamp per row. A NULL ending_version reads up to the latest version.";
+        desc.parameter_names = {"profile_path", "share", "schema", "table", "starting_version", "ending_version"};
+        desc.parameter_types = {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                                LogicalType::BIGINT, LogicalType::BIGINT};
+        desc.examples = {"SELECT * FROM delta_share_changes('/path/to/profile.json', 'my_share', 'my_schema', 'my_table', 5, NULL)"};
+        desc.categories = {"delta", "sharing"};
+        info.descriptions.push_back(std::move(desc));
+        loader.RegisterFunction(std::move(info));
+    }
     {
         CreateTableFunctionInfo info(erpl_web::CreateDeltaShareShowSharesFunction());
         FunctionDescription desc;
@@ -17,6 +17,10 @@
 
 #include "charset_converter.hpp"
 #include "http_client.hpp"
+#include "http_connection_pool.hpp"
+#include "http_disk_cache.hpp"
+#include "http_rate_limiter.hpp"
+#include "http_single_flight.hpp"
 #include "tracing.hpp"
 
 using namespace duckdb;
@@ -621,6 +625,24 @@ std::string HttpRequest::ToCacheKey() const
     return strstream.str();
 }
 
+std::string HttpRequest::ToHeaderCacheKey() const
+{
+    // Header maps are unordered, sort them so equal requests produce equal keys
+    std::vector<std::string> sorted_headers;
+    sorted_headers.reserve(headers.size());
+    for (const auto &header : headers) {
+        sorted_headers.push_back(StringUtil::Lower(header.first) + ":" + header.second);
+    }
+    std::sort(sorted_headers.begin(), sorted_headers.end());
+
+    std::string joined;
+    for (const auto &header : sorted_headers) {
+        joined += header;
+        joined += '\n';
+    }
+    return ToCacheKey() + ":" + std::to_string(std::hash<std::string>()(joined));
+}
+
 duckdb_httplib_openssl::Headers HttpRequest::HttplibHeaders()
 {
     duckdb_httplib_openssl::Headers ret;
@@ -632,7 +654,9 @@ duckdb_httplib_openssl::Headers HttpRequest::HttplibHeaders()
     return ret;
 }
 
-duckdb_httplib_openssl::Result HttpRequest::Execute(duckdb_httplib_openssl::Client &client, bool url_encode)
+duckdb_httplib_openssl::Result HttpRequest::Execute(duckdb_httplib_openssl::Client &client, bool url_encode,
+                                                    const duckdb_httplib_openssl::ResponseHandler &response_handler,
+                                                    const duckdb_httplib_openssl::ContentReceiver &content_receiver)
 {
     auto path_str = url.ToPathQuery();
     
@@ -720,7 +744,30 @@ duckdb_httplib_openssl::Result HttpRequest::Execute(duckdb_httplib_openssl::Clie
     }
 
     duckdb_httplib_openssl::Result result;
-    if (method == HttpMethod::GET)
+    if (content_receiver)
+    {
+        // The verb specific helpers of httplib do not take a receiver for every method, a raw request does
+        duckdb_httplib_openssl::Request req;
+        req.method = method.ToString();
+        req.path = path_str;
+        req.headers = headers;
+        if (method != HttpMethod::GET && method != HttpMethod::HEAD) {
+            req.body = content;
+            if (!content_type.empty()) {
+                req.set_header("Content-Type", content_type);
+            }
+        }
+        req.response_handler = response_handler;
+        req.content_receiver = [&content_receiver](const char *data, size_t length, uint64_t, uint64_t) {
+            return content_receiver(data, length);
+        };
+
+        auto res = std::make_unique<duckdb_httplib_openssl::Response>();
+        auto err = duckdb_httplib_openssl::Error::Success;
+        auto ok = client.send(req, *res, err);
+        result = duckdb_httplib_openssl::Result(ok ? std::move(res) : nullptr, err);
+    }
+    else if (method == HttpMethod::GET)
     {
         result = client.Get(path_str.c_str(), headers);
     }
@@ -925,6 +972,16 @@ HttpClient::HttpClient()
 { }
 
 std::unique_ptr<HttpResponse> HttpClient::SendRequest(HttpRequest &request)
+{
+    return DoSendRequest(request, nullptr);
+}
+
+std::unique_ptr<HttpResponse> HttpClient::SendStreamingRequest(HttpRequest &request, HttpBodyConsumer &consumer)
+{
+    return DoSendRequest(request, &consumer);
+}
+
+std::unique_ptr<HttpResponse> HttpClient::DoSendRequest(HttpRequest &request, HttpBodyConsumer *consumer)
 {
     idx_t n_tries = 0;
     idx_t redirect_count = 0;
@@ -934,21 +991,91 @@ std::unique_ptr<HttpResponse> HttpClient::SendRequest(HttpRequest &request)
         duckdb_httplib_openssl::Error err;
 		duckdb_httplib_openssl::Response response;
 		int status;
+        std::chrono::milliseconds throttle_pause(0);
+
+        // Only the body of a successful response is streamed, redirects and errors are
+        // collected as usual so they can be followed, retried or reported.
+        int streaming_status = 0;
+        uint64_t streamed_bytes = 0;
+        bool consumer_cancelled = false;
+        std::string buffered_body;
+        duckdb_httplib_openssl::Headers streaming_headers;
+        auto response_handler = [&](const duckdb_httplib_openssl::Response &res) {
+            streaming_status = res.status;
+            streaming_headers = res.headers;
+            if (streaming_status >= 200 && streaming_status < 300) {
+                consumer->Start(res.get_header_value("Content-Type"));
+            }
+            return true;
+        };
+        auto content_receiver = [&](const char *data, size_t length) {
+            if (streaming_status < 200 || streaming_status >= 300) {
+                buffered_body.append(data, length);
+                return true;
+            }
+            streamed_bytes += length;
+            consumer_cancelled = !consumer->Consume(data, length);
+            return !consumer_cancelled;
+        };
 
         try {
             // Use the configured HTTP parameters rather than default-constructing new ones
             auto params = this->http_params;
-            auto client = CreateHttplibClient(params, request.url.ToSchemeHostAndPort());
-            auto res = request.Execute(*client, params.url_encode);
+            auto scheme_host_and_port = request.url.ToSchemeHostAndPort();
+            auto create_client = [&]() { return CreateHttplibClient(params, scheme_host_and_port); };
+
+            // Keep-alive requests borrow a client (and thereby its open socket / TLS session)
+            // from the process-wide pool, everything else gets a throw-away client.
+            auto &pool = HttpConnectionPool::GetInstance();
+            bool use_pool = UsePooledConnection(request, params);
+            auto pool_key = use_pool ? HttpConnectionPool::MakeKey(scheme_host_and_port, params) : std::string();
+
+            // Waits while the host is paused after throttling or its request budget is used up,
+            // before a pooled connection is taken so waiting threads do not hold sockets.
+            auto &rate_limiter = HttpRateLimiter::GetInstance();
+            auto rate_limit_key = HttpRateLimiter::HostKey(scheme_host_and_port);
+            rate_limiter.Acquire(rate_limit_key);
+
+            auto client = use_pool ? pool.Acquire(pool_key, create_client) : create_client();
+
+            auto res = consumer ? request.Execute(*client, params.url_encode, response_handler, content_receiver)
+                                : request.Execute(*client, params.url_encode);
             err = res.error();
+            if (consumer && consumer_cancelled && err == duckdb_httplib_openssl::Error::Canceled) {
+                // The consumer has seen enough, not a failure. The connection is left mid-body and not reused.
+                response.status = streaming_status;
+                response.headers = streaming_headers;
+                if (use_pool) {
+                    pool.Release(pool_key, std::move(client), false);
+                }
+                return HttpResponse::FromHttpLibResponse(request.method, request.url, response);
+            }
             if (err == duckdb_httplib_openssl::Error::Success) {
                     status = res->status;
                     response = res.value();
+                    if (consumer && !buffered_body.empty()) {
+                        response.body = std::move(buffered_body);
+                    }
+                    throttle_pause = rate_limiter.OnResponse(rate_limit_key, status, response.headers,
+                                                             std::chrono::milliseconds(CalculateSleepTime(n_tries + 2)));
+            }
+
+            if (use_pool) {
+                pool.Release(pool_key, std::move(client), err == duckdb_httplib_openssl::Error::Success);
             }
         } catch (IOException &e) {
 			caught_e = std::current_exception();
 		}
 
+        if (streamed_bytes > 0 && err != duckdb_httplib_openssl::Error::Success) {
+            // Part of the body already reached the consumer, a retry would hand it over twice
+            if (caught_e) {
+                std::rethrow_exception(caught_e);
+            }
+            throw IOException("%s error after streaming %llu bytes of HTTP %s to '%s'", to_string(err),
+                              (unsigned long long)streamed_bytes, request.method.ToString(), request.url.ToString());
+        }
+
         if (err == duckdb_httplib_openssl::Error::Success)
         {
             // Check for redirect status codes and handle manually to preserve auth headers
@@ -1016,6 +1143,9 @@ std::unique_ptr<HttpResponse> HttpClient::SendRequest(HttpRequest &request)
                 case 504: // Server has error
                     break;
                 default:
+                    if (consumer && status >= 200 && status < 300) {
+                        consumer->Finish();
+                    }
                     return HttpResponse::FromHttpLibResponse(request.method, request.url, response);
 			}
         }
@@ -1033,7 +1163,9 @@ std::unique_ptr<HttpResponse> HttpClient::SendRequest(HttpRequest &request)
                                   request.method.ToString(), request.url.ToString());
 			}
         }
-        else {
+        else if (throttle_pause.count() == 0) {
+            // Throttled hosts are paused by the rate limiter for every thread, the next
+            // attempt waits in Acquire. Other failures keep the local backoff.
             if (n_tries > 1) {
                 auto sleep_amount = CalculateSleepTime(n_tries);
 				std::this_thread::sleep_for(std::chrono::milliseconds(sleep_amount));
@@ -1043,6 +1175,18 @@ std::unique_ptr<HttpResponse> HttpClient::SendRequest(HttpRequest &request)
     return nullptr;
 }
 
+bool HttpClient::UsePooledConnection(const HttpRequest &request, const HttpParams &params)
+{
+    if (!params.keep_alive || !HttpConnectionPool::GetInstance().IsEnabled()) {
+        return false;
+    }
+    auto connection_it = request.headers.find("Connection");
+    if (connection_it != request.headers.end() && StringUtil::Lower(connection_it->second) == "close") {
+        return false;
+    }
+    return true;
+}
+
 uint64_t HttpClient::CalculateSleepTime(idx_t n_tries)
 {
     auto ret = ((float)http_params.retry_wait_ms * pow(http_params.retry_backoff, n_tries - 2));
@@ -1120,82 +1264,232 @@ std::unique_ptr<duckdb_httplib_openssl::Client> HttpClient::CreateHttplibClient(
 
 // ----------------------------------------------------------------------
 
+HttpCachePolicy& HttpCachePolicy::GetInstance() {
+    static HttpCachePolicy instance;
+    return instance;
+}
+
+HttpCacheClass HttpCachePolicy::Classify(const HttpRequest &request) {
+    if (request.url.ToString().find("/$metadata") != std::string::npos) {
+        return HttpCacheClass::METADATA;
+    }
+    return HttpCacheClass::NO_STORE;
+}
+
+std::string HttpCachePolicy::ClassToString(HttpCacheClass cache_class) {
+    switch (cache_class) {
+        case HttpCacheClass::NO_STORE: return "no_store";
+        case HttpCacheClass::METADATA: return "metadata";
+        case HttpCacheClass::SERVICE_DOCUMENT: return "service_document";
+        case HttpCacheClass::LOOKUP: return "lookup";
+    }
+    return "unknown";
+}
+
+std::chrono::milliseconds HttpCachePolicy::GetTtl(HttpCacheClass cache_class) const {
+    switch (cache_class) {
+        case HttpCacheClass::METADATA: return std::chrono::milliseconds(metadata_ttl_ms.load());
+        case HttpCacheClass::SERVICE_DOCUMENT: return std::chrono::milliseconds(service_document_ttl_ms.load());
+        case HttpCacheClass::LOOKUP: return std::chrono::milliseconds(lookup_ttl_ms.load());
+        case HttpCacheClass::NO_STORE: break;
+    }
+    return std::chrono::milliseconds(0);
+}
+
+bool HttpCachePolicy::ShouldStore(HttpCacheClass cache_class, const HttpResponse &response) const {
+    if (cache_class == HttpCacheClass::NO_STORE || max_bytes == 0) {
+        return false;
+    }
+    if (response.code < 200 || response.code >= 300) {
+        return false;
+    }
+    // Lookups are only worth keeping while they are small
+    if (cache_class == HttpCacheClass::LOOKUP && HttpCache::ResponseSize(response) > lookup_max_bytes) {
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------
+
 HttpCache& HttpCache::GetInstance() {
     static HttpCache instance;
     return instance;
 }
 
-HttpCache::HttpCache() {
-    cleanup_thread = std::thread(&HttpCache::GarbageCollection, this);
+uint64_t HttpCache::ResponseSize(const HttpResponse &response) {
+    uint64_t size = sizeof(HttpResponse) + response.content.size() + response.content_type.size();
+    for (const auto &header : response.headers) {
+        size += header.first.size() + header.second.size();
+    }
+    return size;
+}
+
+HttpCache::Shard &HttpCache::ShardFor(const std::string &key) {
+    return shards[std::hash<std::string>()(key) % SHARD_COUNT];
 }
 
-HttpCache::~HttpCache() {
-    {
-        std::unique_lock<std::mutex> lock(cleanup_mutex);
-        should_stop = true;
+const HttpCache::Shard &HttpCache::ShardFor(const std::string &key) const {
+    return shards[std::hash<std::string>()(key) % SHARD_COUNT];
+}
+
+void HttpCache::Erase(Shard &shard, std::list<Entry>::iterator it) {
+    cached_bytes -= it->size;
+    shard.index.erase(it->key);
+    shard.lru.erase(it);
+}
+
+std::list<HttpCache::Entry>::iterator HttpCache::OldestEntry(Shard &shard, const std::string &keep_key) {
+    for (auto it = shard.lru.rbegin(); it != shard.lru.rend(); ++it) {
+        if (it->key != keep_key) {
+            return std::prev(it.base());
+        }
     }
-    cleanup_cv.notify_one();
-    if (cleanup_thread.joinable()) {
-        cleanup_thread.join();
+    return shard.lru.end();
+}
+
+bool HttpCache::EvictLeastRecentlyUsed(const std::string &keep_key) {
+    while (true) {
+        // Shard tails are compared by their access stamp, one shard locked at a time
+        Shard *oldest_shard = nullptr;
+        uint64_t oldest_stamp = 0;
+        for (auto &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto candidate = OldestEntry(shard, keep_key);
+            if (candidate != shard.lru.end() && (!oldest_shard || candidate->last_used < oldest_stamp)) {
+                oldest_shard = &shard;
+                oldest_stamp = candidate->last_used;
+            }
+        }
+        if (!oldest_shard) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(oldest_shard->mutex);
+        auto victim = OldestEntry(*oldest_shard, keep_key);
+        // The entry was used or removed since the scan, look again
+        if (victim == oldest_shard->lru.end() || victim->last_used != oldest_stamp) {
+            continue;
+        }
+        if (victim->expiry <= std::chrono::steady_clock::now()) {
+            expirations++;
+        } else {
+            evictions++;
+        }
+        Erase(*oldest_shard, victim);
+        return true;
     }
 }
 
-std::unique_ptr<HttpResponse> HttpCache::GetCachedResponse(const HttpRequest& request) {
-    std::string cache_key = request.ToCacheKey();
-    
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    auto it = cache.find(cache_key);
-    if (it != cache.end() && it->second.expiry > std::chrono::steady_clock::now()) {
-        return std::make_unique<HttpResponse>(*it->second.response);
+std::shared_ptr<const HttpResponse> HttpCache::GetCachedResponse(const HttpRequest& request) {
+    std::string cache_key = request.ToHeaderCacheKey();
+    auto &shard = ShardFor(cache_key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(cache_key);
+    if (it == shard.index.end()) {
+        misses++;
+        return nullptr;
     }
-    return nullptr;
+    if (it->second->expiry <= std::chrono::steady_clock::now()) {
+        expirations++;
+        misses++;
+        Erase(shard, it->second);
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    it->second->last_used = ++access_clock;
+    hits++;
+    return it->second->response;
 }
 
-void HttpCache::EmplaceCacheResponse(const HttpRequest& request, std::unique_ptr<HttpResponse> response, 
+void HttpCache::EmplaceCacheResponse(const HttpRequest& request, std::shared_ptr<const HttpResponse> response, 
                                    const std::chrono::duration<double>& cache_duration) {
-    std::string cache_key = request.ToCacheKey();
+    if (!response || cache_duration <= std::chrono::duration<double>::zero()) {
+        return;
+    }
+
+    std::string cache_key = request.ToHeaderCacheKey();
     auto expiry = std::chrono::steady_clock::now() + 
                  std::chrono::duration_cast<std::chrono::steady_clock::duration>(cache_duration);
+    auto size = ResponseSize(*response);
+    auto max_bytes = HttpCachePolicy::GetInstance().GetMaxBytes();
+    if (size > max_bytes) {
+        ERPL_TRACE_DEBUG("HTTP_CACHE", "Response for " + cache_key + " exceeds the cache budget, not cached");
+        return;
+    }
+
+    auto &home = ShardFor(cache_key);
+    {
+        std::lock_guard<std::mutex> lock(home.mutex);
+        // A newer response always replaces the old one, expired or not
+        auto existing = home.index.find(cache_key);
+        if (existing != home.index.end()) {
+            Erase(home, existing->second);
+        }
+
+        home.lru.push_front(Entry{cache_key, std::move(response), expiry, size, ++access_clock});
+        home.index[cache_key] = home.lru.begin();
+        cached_bytes += size;
+        insertions++;
+    }
 
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    cache.emplace(cache_key, HttpCacheEntry(std::make_unique<HttpResponse>(*response), expiry));
+    // The new entry is never the victim, it fits the budget on its own
+    while (cached_bytes > max_bytes) {
+        if (!EvictLeastRecentlyUsed(cache_key)) {
+            break;
+        }
+    }
 }
 
 bool HttpCache::IsInCache(const HttpRequest& request) const {
-    std::string cache_key = request.ToCacheKey();
-    
-    std::lock_guard<std::mutex> lock(cache_mutex);
-    auto it = cache.find(cache_key);
-    auto found = (it != cache.end());
-    auto now = std::chrono::steady_clock::now();
-    bool valid = found && it->second.expiry > now;
-    return valid;
+    std::string cache_key = request.ToHeaderCacheKey();
+    auto &shard = ShardFor(cache_key);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(cache_key);
+    return it != shard.index.end() && it->second->expiry > std::chrono::steady_clock::now();
 }
 
-void HttpCache::GarbageCollection() {
-    while (true) {
-        std::unique_lock<std::mutex> cleanup_lock(cleanup_mutex);
-        cleanup_cv.wait_for(cleanup_lock, std::chrono::seconds(10), [this] { return should_stop; });
-        
-        if (should_stop) {
-            break;
-        }
+uint64_t HttpCache::CachedBytes() const {
+    return cached_bytes;
+}
 
-        // Remove expired entries
-        std::lock_guard<std::mutex> cache_lock(cache_mutex);
-        auto now = std::chrono::steady_clock::now();
-        for (auto it = cache.begin(); it != cache.end();) {
-            if (it->second.expiry <= now) {
-                it = cache.erase(it);
-            } else {
-                ++it;
+HttpCache::Stats HttpCache::GetStats() const {
+    Stats stats;
+    stats.hits = hits;
+    stats.misses = misses;
+    stats.insertions = insertions;
+    stats.evictions = evictions;
+    stats.expirations = expirations;
+    for (const auto &shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        stats.entries += shard.lru.size();
+    }
+    stats.bytes = cached_bytes;
+    return stats;
+}
+
+void HttpCache::Clear() {
+    for (auto &shard : shards) {
+        std::list<Entry> drained;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto &entry : shard.lru) {
+                cached_bytes -= entry.size;
             }
+            drained.swap(shard.lru);
+            shard.index.clear();
         }
     }
 }
 
 // ----------------------------------------------------------------------
 
+CachingHttpClient::CachingHttpClient(std::shared_ptr<HttpClient> http_client)
+    : http_client(std::move(http_client)) {}
+
 CachingHttpClient::CachingHttpClient(std::shared_ptr<HttpClient> http_client, 
                                    const std::chrono::duration<double>& cache_duration)
     : http_client(std::move(http_client))
@@ -1205,36 +1499,96 @@ std::shared_ptr<HttpClient> CachingHttpClient::GetHttpClient() {
     return http_client;
 }
 
-std::unique_ptr<HttpResponse> CachingHttpClient::Head(const std::string& url) {
+std::shared_ptr<const HttpResponse> CachingHttpClient::Head(const std::string& url) {
     auto request = HttpRequest(HttpMethod::HEAD, url);
     return SendRequest(request);
 }
 
-std::unique_ptr<HttpResponse> CachingHttpClient::Get(const std::string& url) {
+std::shared_ptr<const HttpResponse> CachingHttpClient::Get(const std::string& url) {
     auto request = HttpRequest(HttpMethod::GET, url);
     return SendRequest(request);
 }
 
-std::unique_ptr<HttpResponse> CachingHttpClient::SendRequest(HttpRequest& request) {
-    auto& cache = HttpCache::GetInstance();
-    
+std::shared_ptr<const HttpResponse> CachingHttpClient::SendRequest(HttpRequest& request) {
+    return SendRequest(request, HttpCachePolicy::Classify(request));
+}
+
+std::shared_ptr<const HttpResponse> CachingHttpClient::SendRequest(HttpRequest& request, HttpCacheClass cache_class) {
+    // Uncacheable requests go straight to the wrapped client, no lookup and no copy
+    if (cache_class == HttpCacheClass::NO_STORE) {
+        return http_client->SendRequest(request);
+    }
+
     // Try to get from cache first
+    auto cached_response = HttpCache::GetInstance().GetCachedResponse(request);
+    if (cached_response) {
+        return cached_response;
+    }
+
+    // Concurrent misses for the same document wait for a single request
+    return HttpSingleFlight::GetInstance().Do(request, [&]() { return FetchAndStore(request, cache_class); });
+}
+
+std::shared_ptr<const HttpResponse> CachingHttpClient::FetchAndStore(HttpRequest& request, HttpCacheClass cache_class) {
+    auto& cache = HttpCache::GetInstance();
+
+    // A flight that completed between our miss and this one already stored the response
     auto cached_response = cache.GetCachedResponse(request);
     if (cached_response) {
         return cached_response;
     }
 
-    // If not in cache, forward to wrapped client
-    auto response = http_client->SendRequest(request);
+    auto duration = CacheDuration(cache_class);
+    auto ttl = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+    auto& disk_cache = HttpDiskCache::GetInstance();
+    bool use_disk = ttl.count() > 0 && disk_cache.IsEnabled() && HttpDiskCache::IsPersistent(request, cache_class);
+
+    // A fresh entry on disk (e.g. written by an earlier process) is served like a memory hit
+    std::optional<HttpDiskCache::Entry> stored;
+    if (use_disk) {
+        stored = disk_cache.Load(request);
+        auto now = std::chrono::system_clock::now();
+        if (stored && stored->IsFresh(now)) {
+            cache.EmplaceCacheResponse(request, stored->response, stored->expiry - now);
+            return stored->response;
+        }
+    }
+
+    // If not in cache, forward to wrapped client. An expired entry with validators
+    // turns the request into a conditional one, 304 keeps the stored body.
+    std::shared_ptr<const HttpResponse> response;
+    if (stored && stored->HasValidators()) {
+        auto conditional_request = request;
+        HttpDiskCache::AddConditionalHeaders(conditional_request, *stored);
+        response = http_client->SendRequest(conditional_request);
+        if (response && response->Code() == 304) {
+            response = disk_cache.Revalidate(request, *stored, *response, ttl);
+            cache.EmplaceCacheResponse(request, response, duration);
+            return response;
+        }
+    } else {
+        response = http_client->SendRequest(request);
+    }
     
-    // Cache the response if successful
-    if (response && response->Code() >= 200 && response->Code() < 300) {
-        cache.EmplaceCacheResponse(request, std::make_unique<HttpResponse>(*response), cache_duration);
+    // Cache the response if the policy allows it for its class, the caller and
+    // the cache share the same immutable response
+    if (response && duration.count() > 0 && HttpCachePolicy::GetInstance().ShouldStore(cache_class, *response)) {
+        cache.EmplaceCacheResponse(request, response, duration);
+        if (use_disk) {
+            disk_cache.Store(request, *response, ttl);
+        }
     }
     
     return response;
 }
 
+std::chrono::steady_clock::duration CachingHttpClient::CacheDuration(HttpCacheClass cache_class) const {
+    if (cache_duration) {
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(*cache_duration);
+    }
+    return HttpCachePolicy::GetInstance().GetTtl(cache_class);
+}
+
 bool CachingHttpClient::IsInCache(const HttpRequest& request) const {
     return HttpCache::GetInstance().IsInCache(request);
 }
@@ -0,0 +1,165 @@
+#include "http_connection_pool.hpp"
+#include "tracing.hpp"
+
+#include <sstream>
+
+namespace erpl_web {
+
+HttpConnectionPool& HttpConnectionPool::GetInstance() {
+    static HttpConnectionPool instance;
+    return instance;
+}
+
+std::string HttpConnectionPool::MakeKey(const std::string &scheme_host_and_port, const HttpParams &http_params) {
+    std::stringstream key;
+    key << HttpUrl::ToLower(scheme_host_and_port)
+        << "|timeout=" << http_params.timeout
+        << "|url_encode=" << (http_params.url_encode ? 1 : 0)
+        // Server certificate verification is currently always disabled in CreateHttplibClient,
+        // the flag is part of the key so that enabling it never reuses an unverified session.
+        << "|verify=0";
+    return key.str();
+}
+
+bool HttpConnectionPool::IsHealthy(const IdleClient &idle, std::chrono::steady_clock::time_point now) const {
+    if (!idle.client || !idle.client->is_valid()) {
+        return false;
+    }
+    // httplib closes the socket itself when the server answered with `Connection: close`
+    // or when the last request failed; such a client has nothing left worth keeping.
+    if (!idle.client->is_socket_open()) {
+        return false;
+    }
+    return (now - idle.last_used) < idle_timeout;
+}
+
+void HttpConnectionPool::EvictExpired(std::deque<IdleClient> &idle_clients, std::chrono::steady_clock::time_point now,
+                                      std::vector<std::unique_ptr<Client>> &evicted) {
+    for (auto it = idle_clients.begin(); it != idle_clients.end();) {
+        if (!IsHealthy(*it, now)) {
+            evicted.push_back(std::move(it->client));
+            it = idle_clients.erase(it);
+            stats.expired++;
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::unique_ptr<HttpConnectionPool::Client> HttpConnectionPool::Acquire(const std::string &key, const ClientFactory &factory) {
+    // Clients are destroyed outside the lock, TLS shutdown can take a moment.
+    std::vector<std::unique_ptr<Client>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (enabled) {
+            auto it = idle_pool.find(key);
+            if (it != idle_pool.end()) {
+                auto now = std::chrono::steady_clock::now();
+                EvictExpired(it->second, now, evicted);
+                if (!it->second.empty()) {
+                    // Most recently used first, its socket is the least likely to be closed by the peer.
+                    auto client = std::move(it->second.back().client);
+                    it->second.pop_back();
+                    stats.reused++;
+                    ERPL_TRACE_DEBUG("HTTP_POOL", "Reusing pooled connection for " + key);
+                    return client;
+                }
+            }
+        }
+        stats.created++;
+    }
+
+    ERPL_TRACE_DEBUG("HTTP_POOL", "Creating new connection for " + key);
+    return factory();
+}
+
+void HttpConnectionPool::Release(const std::string &key, std::unique_ptr<Client> client, bool reusable) {
+    if (!client) {
+        return;
+    }
+
+    std::vector<std::unique_ptr<Client>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (!enabled || !reusable || max_idle_per_host == 0) {
+            stats.discarded++;
+            evicted.push_back(std::move(client));
+        } else {
+            auto now = std::chrono::steady_clock::now();
+            auto &idle_clients = idle_pool[key];
+            EvictExpired(idle_clients, now, evicted);
+
+            IdleClient idle{std::move(client), now};
+            if (!IsHealthy(idle, now) || idle_clients.size() >= max_idle_per_host) {
+                stats.discarded++;
+                evicted.push_back(std::move(idle.client));
+            } else {
+                idle_clients.push_back(std::move(idle));
+                stats.released++;
+            }
+        }
+    }
+}
+
+void HttpConnectionPool::SetEnabled(bool value) {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        enabled = value;
+    }
+    if (!value) {
+        Clear();
+    }
+}
+
+bool HttpConnectionPool::IsEnabled() const {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return enabled;
+}
+
+void HttpConnectionPool::SetMaxIdlePerHost(uint64_t max_idle) {
+    std::vector<std::unique_ptr<Client>> evicted;
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    max_idle_per_host = max_idle;
+    for (auto &entry : idle_pool) {
+        while (entry.second.size() > max_idle_per_host) {
+            evicted.push_back(std::move(entry.second.front().client));
+            entry.second.pop_front();
+            stats.discarded++;
+        }
+    }
+}
+
+uint64_t HttpConnectionPool::GetMaxIdlePerHost() const {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return max_idle_per_host;
+}
+
+void HttpConnectionPool::SetIdleTimeout(std::chrono::milliseconds value) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    idle_timeout = value;
+}
+
+std::chrono::milliseconds HttpConnectionPool::GetIdleTimeout() const {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return idle_timeout;
+}
+
+void HttpConnectionPool::Clear() {
+    std::unordered_map<std::string, std::deque<IdleClient>> drained;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        drained.swap(idle_pool);
+    }
+}
+
+HttpConnectionPool::Stats HttpConnectionPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    auto result = stats;
+    result.idle = 0;
+    for (const auto &entry : idle_pool) {
+        result.idle += entry.second.size();
+    }
+    return result;
+}
+
+} // namespace erpl_web
@@ -0,0 +1,246 @@
+#include "http_disk_cache.hpp"
+#include "tracing.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace erpl_web {
+
+static constexpr const char *DISK_CACHE_MAGIC = "ERPL_HTTP_CACHE_V1";
+
+// FNV-1a, file names have to be identical across processes and builds
+static uint64_t StableHash(const std::string &value) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : value) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string ToHex(uint64_t value) {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << value;
+    return ss.str();
+}
+
+// Random per thread, temporary names must not collide across threads or processes sharing the directory
+static std::string TempSuffix() {
+    thread_local std::mt19937_64 generator(std::random_device{}());
+    return ToHex(generator());
+}
+
+// Fields are length-prefixed so bodies and header values may contain anything
+static void WriteField(std::ostream &out, const std::string &value) {
+    out << value.size() << '\n';
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+    out << '\n';
+}
+
+static bool ReadField(std::istream &in, std::string &value) {
+    std::string size_line;
+    if (!std::getline(in, size_line)) {
+        return false;
+    }
+    uint64_t size = 0;
+    try {
+        size = std::stoull(size_line);
+    } catch (...) {
+        return false;
+    }
+    value.resize(size);
+    if (size > 0 && !in.read(&value[0], static_cast<std::streamsize>(size))) {
+        return false;
+    }
+    return in.get() == '\n';
+}
+
+static std::string HeaderValue(const HeaderMap &headers, const std::string &name) {
+    auto it = headers.find(name);
+    return it != headers.end() ? it->second : std::string();
+}
+
+// ----------------------------------------------------------------------
+
+HttpDiskCache& HttpDiskCache::GetInstance() {
+    static HttpDiskCache instance;
+    return instance;
+}
+
+void HttpDiskCache::SetDirectory(const std::string &value) {
+    if (!value.empty()) {
+        try {
+            std::filesystem::create_directories(value);
+        } catch (const std::filesystem::filesystem_error &e) {
+            throw InvalidInputException("Cannot use '%s' as erpl_http_cache_directory: %s", value, e.what());
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    directory = value;
+}
+
+std::string HttpDiskCache::GetDirectory() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return directory;
+}
+
+bool HttpDiskCache::IsEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !directory.empty();
+}
+
+bool HttpDiskCache::IsPersistent(const HttpRequest &request, HttpCacheClass cache_class) {
+    if (request.method != HttpMethod::GET) {
+        return false;
+    }
+    return cache_class == HttpCacheClass::METADATA || cache_class == HttpCacheClass::SERVICE_DOCUMENT;
+}
+
+std::string HttpDiskCache::DiskKey(const HttpRequest &request) {
+    // Credentials only enter the key as a hash, the key itself is stored in the entry file
+    return request.ToCacheKey() +
+           "|accept=" + HeaderValue(request.headers, "Accept") +
+           "|auth=" + ToHex(StableHash(HeaderValue(request.headers, "Authorization")));
+}
+
+std::filesystem::path HttpDiskCache::PathFor(const std::string &directory, const std::string &disk_key) {
+    return std::filesystem::path(directory) / (ToHex(StableHash(disk_key)) + ".http");
+}
+
+std::optional<HttpDiskCache::Entry> HttpDiskCache::Load(const HttpRequest &request) {
+    auto cache_directory = GetDirectory();
+    if (cache_directory.empty()) {
+        return std::nullopt;
+    }
+
+    auto disk_key = DiskKey(request);
+    auto path = PathFor(cache_directory, disk_key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return std::nullopt;
+    }
+
+    std::string magic, key, expiry_ms, code, content_type, header_count, content;
+    if (!ReadField(in, magic) || magic != DISK_CACHE_MAGIC || !ReadField(in, key) || key != disk_key ||
+        !ReadField(in, expiry_ms) || !ReadField(in, code) || !ReadField(in, content_type) ||
+        !ReadField(in, header_count)) {
+        ERPL_TRACE_DEBUG("HTTP_DISK_CACHE", "Ignoring unreadable or foreign cache entry " + path.string());
+        return std::nullopt;
+    }
+
+    HeaderMap headers;
+    try {
+        auto n_headers = std::stoull(header_count);
+        for (uint64_t i = 0; i < n_headers; i++) {
+            std::string name, value;
+            if (!ReadField(in, name) || !ReadField(in, value)) {
+                return std::nullopt;
+            }
+            headers.emplace(std::move(name), std::move(value));
+        }
+        if (!ReadField(in, content)) {
+            return std::nullopt;
+        }
+
+        auto response = std::make_shared<HttpResponse>(request.method, request.url, std::stoi(code),
+                                                       content_type, std::move(content));
+        response->headers = std::move(headers);
+
+        Entry entry;
+        entry.etag = HeaderValue(response->headers, "ETag");
+        entry.last_modified = HeaderValue(response->headers, "Last-Modified");
+        entry.expiry = std::chrono::system_clock::time_point(std::chrono::milliseconds(std::stoll(expiry_ms)));
+        entry.response = std::move(response);
+
+        if (entry.IsFresh(std::chrono::system_clock::now())) {
+            hits++;
+        }
+        return entry;
+    } catch (const std::exception &e) {
+        ERPL_TRACE_DEBUG("HTTP_DISK_CACHE", "Ignoring corrupt cache entry " + path.string() + ": " + e.what());
+        return std::nullopt;
+    }
+}
+
+void HttpDiskCache::Store(const HttpRequest &request, const HttpResponse &response, std::chrono::milliseconds ttl) {
+    Write(DiskKey(request), response, std::chrono::system_clock::now() + ttl);
+}
+
+std::shared_ptr<const HttpResponse> HttpDiskCache::Revalidate(const HttpRequest &request, const Entry &entry,
+                                                              const HttpResponse &not_modified,
+                                                              std::chrono::milliseconds ttl) {
+    // A 304 may carry updated validators and caching headers, the body stays the stored one
+    auto refreshed = std::make_shared<HttpResponse>(*entry.response);
+    for (const auto &name : {"ETag", "Last-Modified", "Cache-Control", "Expires", "Date"}) {
+        auto value = HeaderValue(not_modified.headers, name);
+        if (!value.empty()) {
+            refreshed->headers[name] = value;
+        }
+    }
+
+    revalidations++;
+    ERPL_TRACE_DEBUG("HTTP_DISK_CACHE", "Revalidated " + request.url.ToString() + " (304 Not Modified)");
+    Write(DiskKey(request), *refreshed, std::chrono::system_clock::now() + ttl);
+    return refreshed;
+}
+
+void HttpDiskCache::AddConditionalHeaders(HttpRequest &request, const Entry &entry) {
+    if (!entry.etag.empty()) {
+        request.headers["If-None-Match"] = entry.etag;
+    }
+    if (!entry.last_modified.empty()) {
+        request.headers["If-Modified-Since"] = entry.last_modified;
+    }
+}
+
+void HttpDiskCache::Write(const std::string &disk_key, const HttpResponse &response,
+                          std::chrono::system_clock::time_point expiry) {
+    auto cache_directory = GetDirectory();
+    if (cache_directory.empty()) {
+        return;
+    }
+
+    auto path = PathFor(cache_directory, disk_key);
+    // Written next to the target and renamed, readers in other processes never see a partial entry
+    std::filesystem::path tmp_path(path.string() + ".tmp." + TempSuffix());
+
+    try {
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            auto expiry_ms = std::chrono::duration_cast<std::chrono::milliseconds>(expiry.time_since_epoch()).count();
+            WriteField(out, DISK_CACHE_MAGIC);
+            WriteField(out, disk_key);
+            WriteField(out, std::to_string(expiry_ms));
+            WriteField(out, std::to_string(response.code));
+            WriteField(out, response.content_type);
+            WriteField(out, std::to_string(response.headers.size()));
+            for (const auto &header : response.headers) {
+                WriteField(out, header.first);
+                WriteField(out, header.second);
+            }
+            WriteField(out, response.content);
+            if (!out) {
+                throw std::runtime_error("write failed");
+            }
+        }
+        std::filesystem::rename(tmp_path, path);
+        writes++;
+    } catch (const std::exception &e) {
+        // The disk cache is an optimization, failing to persist never fails the request
+        ERPL_TRACE_WARN("HTTP_DISK_CACHE", "Failed to write cache entry " + path.string() + ": " + e.what());
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+    }
+}
+
+HttpDiskCache::Stats HttpDiskCache::GetStats() const {
+    Stats stats;
+    stats.hits = hits;
+    stats.revalidations = revalidations;
+    stats.writes = writes;
+    return stats;
+}
+
+} // namespace erpl_web
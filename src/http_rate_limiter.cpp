@@ -0,0 +1,212 @@
+#include "http_rate_limiter.hpp"
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace erpl_web {
+
+// Seconds since the epoch of a UTC calendar date, timegm is not available everywhere
+static int64_t UtcToEpochSeconds(const std::tm &tm) {
+    int64_t year = tm.tm_year + 1900;
+    int64_t month = tm.tm_mon + 1;
+    year -= month <= 2 ? 1 : 0;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + tm.tm_mday - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    int64_t days = era * 146097 + day_of_era - 719468;
+    return days * 86400 + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+}
+
+static std::optional<int64_t> ParseInteger(const std::string &value) {
+    auto trimmed = value;
+    StringUtil::Trim(trimmed);
+    if (trimmed.empty() || !std::all_of(trimmed.begin(), trimmed.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return std::nullopt;
+    }
+    try {
+        return std::stoll(trimmed);
+    } catch (...) {
+        return std::nullopt;
+    }
+}
+
+// ----------------------------------------------------------------------
+
+HttpRateLimiter& HttpRateLimiter::GetInstance() {
+    static HttpRateLimiter instance;
+    return instance;
+}
+
+std::string HttpRateLimiter::HostKey(const std::string &scheme_host_and_port) {
+    return HttpUrl::ToLower(scheme_host_and_port);
+}
+
+std::optional<std::chrono::milliseconds> HttpRateLimiter::ParseRetryAfter(const std::string &value,
+                                                                          std::chrono::system_clock::time_point now) {
+    auto seconds = ParseInteger(value);
+    if (seconds) {
+        return std::chrono::milliseconds(*seconds * 1000);
+    }
+
+    // IMF-fixdate, e.g. "Wed, 21 Oct 2015 07:28:00 GMT"
+    std::tm tm = {};
+    std::istringstream ss(value);
+    ss.imbue(std::locale::classic());
+    ss >> std::get_time(&tm, "%a, %d %b %Y %H:%M:%S");
+    if (ss.fail()) {
+        return std::nullopt;
+    }
+    auto retry_at = std::chrono::system_clock::time_point(std::chrono::seconds(UtcToEpochSeconds(tm)));
+    if (retry_at <= now) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(retry_at - now);
+}
+
+void HttpRateLimiter::Refill(HostState &state, std::chrono::steady_clock::time_point now) const {
+    auto capacity = static_cast<double>(std::max<uint64_t>(burst, 1));
+    if (state.last_refill == std::chrono::steady_clock::time_point{}) {
+        state.tokens = capacity;
+    } else {
+        std::chrono::duration<double> elapsed = now - state.last_refill;
+        state.tokens = std::min(capacity, state.tokens + elapsed.count() * requests_per_second);
+    }
+    state.last_refill = now;
+}
+
+void HttpRateLimiter::Pause(HostState &state, std::chrono::steady_clock::time_point now, std::chrono::milliseconds pause) {
+    // Pauses only ever extend, a shorter hint from a concurrent response never cuts one short
+    state.paused_until = std::max(state.paused_until, now + pause);
+}
+
+void HttpRateLimiter::Acquire(const std::string &host) {
+    bool waited = false;
+    while (true) {
+        std::chrono::steady_clock::duration wait{0};
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto now = std::chrono::steady_clock::now();
+            auto &state = hosts[host];
+            if (state.paused_until > now) {
+                wait = state.paused_until - now;
+            } else if (requests_per_second <= 0) {
+                return;
+            } else {
+                Refill(state, now);
+                if (state.tokens >= 1) {
+                    state.tokens -= 1;
+                    return;
+                }
+                wait = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>((1 - state.tokens) / requests_per_second));
+            }
+        }
+
+        if (!waited) {
+            waits++;
+            waited = true;
+        }
+        wait_ms += std::chrono::duration_cast<std::chrono::milliseconds>(wait).count();
+        std::this_thread::sleep_for(wait);
+    }
+}
+
+std::chrono::milliseconds HttpRateLimiter::OnResponse(const std::string &host, int status,
+                                                      const duckdb_httplib_openssl::Headers &headers,
+                                                      std::chrono::milliseconds fallback_pause) {
+    auto system_now = std::chrono::system_clock::now();
+    std::optional<std::chrono::milliseconds> announced;
+    bool budget_exhausted = false;
+    for (const auto &header : headers) {
+        auto name = StringUtil::Lower(header.first);
+        if (name == "retry-after") {
+            announced = ParseRetryAfter(header.second, system_now);
+        } else if (name == "x-ms-retry-after-ms") {
+            auto ms = ParseInteger(header.second);
+            if (ms) {
+                announced = std::chrono::milliseconds(*ms);
+            }
+        } else if (StringUtil::StartsWith(name, "x-ms-ratelimit-") && name.find("remaining") != std::string::npos) {
+            auto remaining = ParseInteger(header.second);
+            budget_exhausted = budget_exhausted || (remaining && *remaining == 0);
+        }
+    }
+
+    std::chrono::milliseconds pause(0);
+    if (IsThrottlingStatus(status)) {
+        pause = announced.value_or(fallback_pause);
+        throttled++;
+    } else if (budget_exhausted) {
+        pause = std::chrono::milliseconds(EXHAUSTED_BUDGET_PAUSE_MS);
+    }
+    if (pause.count() <= 0) {
+        return std::chrono::milliseconds(0);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pause > max_retry_after) {
+        ERPL_TRACE_WARN("HTTP_RATE_LIMIT", "Capping announced pause of " + std::to_string(pause.count()) + " ms for " +
+                        host + " to " + std::to_string(max_retry_after.count()) + " ms");
+        pause = max_retry_after;
+    }
+    ERPL_TRACE_INFO("HTTP_RATE_LIMIT", "Pausing requests to " + host + " for " + std::to_string(pause.count()) +
+                    " ms (HTTP " + std::to_string(status) + ")");
+    Pause(hosts[host], std::chrono::steady_clock::now(), pause);
+    return pause;
+}
+
+std::chrono::milliseconds HttpRateLimiter::PauseRemaining(const std::string &host) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = hosts.find(host);
+    auto now = std::chrono::steady_clock::now();
+    if (it == hosts.end() || it->second.paused_until <= now) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(it->second.paused_until - now);
+}
+
+void HttpRateLimiter::SetRequestsPerSecond(double value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    requests_per_second = value;
+}
+
+double HttpRateLimiter::GetRequestsPerSecond() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requests_per_second;
+}
+
+void HttpRateLimiter::SetBurst(uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    burst = value;
+}
+
+void HttpRateLimiter::SetMaxRetryAfter(std::chrono::milliseconds value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    max_retry_after = value;
+}
+
+std::chrono::milliseconds HttpRateLimiter::GetMaxRetryAfter() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return max_retry_after;
+}
+
+HttpRateLimiter::Stats HttpRateLimiter::GetStats() const {
+    Stats stats;
+    stats.throttled = throttled;
+    stats.waits = waits;
+    stats.wait_ms = wait_ms;
+    return stats;
+}
+
+void HttpRateLimiter::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    hosts.clear();
+}
+
+} // namespace erpl_web
@@ -0,0 +1,68 @@
+#include "http_single_flight.hpp"
+#include "tracing.hpp"
+
+namespace erpl_web {
+
+HttpSingleFlight& HttpSingleFlight::GetInstance() {
+    static HttpSingleFlight instance;
+    return instance;
+}
+
+std::string HttpSingleFlight::FlightKey(const HttpRequest &request) {
+    return request.ToHeaderCacheKey();
+}
+
+std::shared_ptr<const HttpResponse> HttpSingleFlight::Do(const HttpRequest &request, const FetchFunction &fetch) {
+    return Do(FlightKey(request), fetch);
+}
+
+std::shared_ptr<const HttpResponse> HttpSingleFlight::Do(const std::string &key, const FetchFunction &fetch) {
+    std::promise<std::shared_ptr<const HttpResponse>> promise;
+    SharedResult result;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = in_flight.find(key);
+        if (it != in_flight.end()) {
+            result = it->second;
+            coalesced++;
+        } else {
+            result = promise.get_future().share();
+            in_flight.emplace(key, result);
+            leader = true;
+            executed++;
+        }
+    }
+
+    if (!leader) {
+        ERPL_TRACE_DEBUG("HTTP_SINGLE_FLIGHT", "Waiting for in-flight request " + key);
+        // Rethrows the exception of the leading request
+        return result.get();
+    }
+
+    try {
+        promise.set_value(fetch());
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        in_flight.erase(key);
+    }
+    return result.get();
+}
+
+uint64_t HttpSingleFlight::InFlight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return in_flight.size();
+}
+
+HttpSingleFlight::Stats HttpSingleFlight::GetStats() const {
+    Stats stats;
+    stats.executed = executed;
+    stats.coalesced = coalesced;
+    return stats;
+}
+
+} // namespace erpl_web
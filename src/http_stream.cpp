@@ -0,0 +1,306 @@
+#include "http_stream.hpp"
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace erpl_web {
+
+NdjsonLineSplitter::NdjsonLineSplitter(LineCallback on_line) : on_line(std::move(on_line)) { }
+
+bool NdjsonLineSplitter::Consume(const char *data, size_t length) {
+    const char *end = data + length;
+    while (data < end) {
+        auto newline = static_cast<const char *>(std::memchr(data, '\n', end - data));
+        if (!newline) {
+            line.append(data, end - data);
+            break;
+        }
+        line.append(data, newline - data);
+        data = newline + 1;
+        if (!EmitLine()) {
+            return false;
+        }
+    }
+    max_buffered_bytes = std::max<uint64_t>(max_buffered_bytes, line.size());
+    return true;
+}
+
+void NdjsonLineSplitter::Finish() {
+    EmitLine();
+}
+
+bool NdjsonLineSplitter::EmitLine() {
+    max_buffered_bytes = std::max<uint64_t>(max_buffered_bytes, line.size());
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    if (line.empty()) {
+        return true;
+    }
+    line_count++;
+    auto proceed = on_line(line);
+    line.clear();
+    return proceed;
+}
+
+// ----------------------------------------------------------------------
+
+JsonArrayItemStreamer::JsonArrayItemStreamer(std::vector<MemberPath> array_paths, ItemCallback on_item)
+    : array_paths(std::move(array_paths)), on_item(std::move(on_item)) {
+    for (const auto &path : this->array_paths) {
+        key_depth = std::max(key_depth, path.size());
+    }
+}
+
+std::vector<JsonArrayItemStreamer::MemberPath> JsonArrayItemStreamer::ODataItemPaths() {
+    return {{"value"}, {"d", "results"}, {"d"}};
+}
+
+void JsonArrayItemStreamer::KeepItemMembers(std::unordered_set<std::string> members) {
+    kept_members = std::move(members);
+    filter_members = true;
+}
+
+bool JsonArrayItemStreamer::InFilteredItem() const {
+    return filter_members && array_depth != SIZE_MAX && frames.size() == array_depth + 1 && frames.back().is_object;
+}
+
+bool JsonArrayItemStreamer::IsItemArray() const {
+    for (const auto &path : array_paths) {
+        if (path.size() != frames.size()) {
+            continue;
+        }
+        bool matches = true;
+        for (size_t i = 0; i < path.size() && matches; i++) {
+            matches = frames[i].is_object && frames[i].key == path[i];
+        }
+        if (matches) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void JsonArrayItemStreamer::Flush(const char *run, const char *end) {
+    if (run < end && !skipping_member) {
+        (array_depth != SIZE_MAX ? item : envelope).append(run, end - run);
+    }
+}
+
+bool JsonArrayItemStreamer::EmitItem() {
+    while (!item.empty() && std::isspace(static_cast<unsigned char>(item.back()))) {
+        item.pop_back();
+    }
+    if (item.empty()) {
+        return true;
+    }
+    max_buffered_bytes = std::max<uint64_t>(max_buffered_bytes, item.size() + envelope.size());
+    item_count++;
+    auto proceed = on_item(item);
+    item.clear();
+    return proceed;
+}
+
+bool JsonArrayItemStreamer::Consume(const char *data, size_t length) {
+    const char *end = data + length;
+    // Bytes are copied in runs, only the separators of the item array are left out
+    const char *run = data;
+    for (const char *pos = data; pos < end; pos++) {
+        char c = *pos;
+
+        if (in_string) {
+            if (escaped) {
+                escaped = false;
+                if (reading_key) {
+                    frames.back().key.push_back(c);
+                }
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                in_string = false;
+                if (reading_key && InFilteredItem()) {
+                    if (kept_members.count(frames.back().key) > 0) {
+                        item_members++;
+                    } else {
+                        // The key is taken back out of the item, its value is skipped up to the next member
+                        Flush(run, pos + 1);
+                        item.resize(member_start);
+                        run = pos + 1;
+                        skipping_member = true;
+                    }
+                }
+                reading_key = false;
+            } else if (reading_key) {
+                frames.back().key.push_back(c);
+            }
+            continue;
+        }
+
+        // Separators of the item array itself are not part of any item
+        if (array_depth != SIZE_MAX && frames.size() == array_depth) {
+            if (c == ',') {
+                Flush(run, pos);
+                run = pos + 1;
+                if (!EmitItem()) {
+                    return false;
+                }
+                continue;
+            }
+            if (c == ']') {
+                Flush(run, pos);
+                // The bracket starts the next run, which goes to the envelope
+                run = pos;
+                if (!EmitItem()) {
+                    return false;
+                }
+                frames.pop_back();
+                array_depth = SIZE_MAX;
+                continue;
+            }
+            if (item.empty() && run == pos && std::isspace(static_cast<unsigned char>(c))) {
+                run = pos + 1;
+                continue;
+            }
+        }
+
+        // Commas between the members of a filtered item are written anew before every kept member
+        if (InFilteredItem()) {
+            if (c == ',') {
+                Flush(run, pos);
+                run = pos + 1;
+                skipping_member = false;
+                frames.back().expecting_key = true;
+                continue;
+            }
+            if (c == '}') {
+                Flush(run, pos);
+                run = pos;
+                skipping_member = false;
+            } else if (c == '"' && frames.back().expecting_key) {
+                Flush(run, pos);
+                run = pos;
+                member_start = item.size();
+                if (item_members > 0) {
+                    item.push_back(',');
+                }
+            }
+        }
+
+        switch (c) {
+        case '"':
+            in_string = true;
+            if (!frames.empty() && frames.back().is_object && frames.back().expecting_key &&
+                (frames.size() <= key_depth || InFilteredItem())) {
+                reading_key = true;
+                frames.back().key.clear();
+            }
+            break;
+        case '{':
+            frames.push_back(Frame{true, true, std::string()});
+            if (frames.size() == array_depth + 1) {
+                item_members = 0;
+            }
+            break;
+        case '[': {
+            bool is_item_array = !found_array && array_depth == SIZE_MAX && IsItemArray();
+            frames.push_back(Frame{false, false, std::string()});
+            if (is_item_array) {
+                // The bracket still belongs to the envelope, the items follow it
+                Flush(run, pos + 1);
+                run = pos + 1;
+                found_array = true;
+                array_depth = frames.size();
+            }
+            break;
+        }
+        case '}':
+        case ']':
+            if (!frames.empty()) {
+                frames.pop_back();
+            }
+            break;
+        case ':':
+            if (!frames.empty() && frames.back().is_object) {
+                frames.back().expecting_key = false;
+            }
+            break;
+        case ',':
+            if (!frames.empty() && frames.back().is_object) {
+                frames.back().expecting_key = true;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    Flush(run, end);
+    max_buffered_bytes = std::max<uint64_t>(max_buffered_bytes, item.size() + envelope.size());
+    return true;
+}
+
+void JsonArrayItemStreamer::Finish() {
+    if (finished) {
+        return;
+    }
+    finished = true;
+    if (!frames.empty() || in_string) {
+        throw std::runtime_error("JSON body ended after " + std::to_string(item_count) +
+                                 " items before the document was complete");
+    }
+    ERPL_TRACE_DEBUG("HTTP_STREAM", "Streamed " + std::to_string(item_count) + " array items, largest buffer " +
+                     std::to_string(max_buffered_bytes) + " bytes");
+}
+
+// ----------------------------------------------------------------------
+
+HttpCharsetConsumer::HttpCharsetConsumer(HttpBodyConsumer &consumer)
+    : consumer(consumer) {
+}
+
+void HttpCharsetConsumer::Start(const std::string &content_type) {
+    auto charset_converter = std::make_unique<CharsetConverter>(content_type);
+    converter = charset_converter->NeedsConversion() ? std::move(charset_converter) : nullptr;
+    consumer.Start(content_type);
+}
+
+bool HttpCharsetConsumer::Consume(const char *data, size_t length) {
+    if (!converter) {
+        return consumer.Consume(data, length);
+    }
+    auto converted = converter->convert(std::string(data, length));
+    return consumer.Consume(converted.data(), converted.size());
+}
+
+void HttpCharsetConsumer::Finish() {
+    consumer.Finish();
+}
+
+// ----------------------------------------------------------------------
+
+HttpFileSink::HttpFileSink(const std::string &path)
+    : path(path), out(path, std::ios::binary | std::ios::trunc) {
+    if (!out) {
+        throw duckdb::IOException("Could not open '%s' for writing", path);
+    }
+}
+
+bool HttpFileSink::Consume(const char *data, size_t length) {
+    out.write(data, static_cast<std::streamsize>(length));
+    if (!out) {
+        throw duckdb::IOException("Failed to write %llu bytes to '%s'", (unsigned long long)length, path);
+    }
+    bytes_written += length;
+    return true;
+}
+
+void HttpFileSink::Finish() {
+    out.close();
+    if (out.fail()) {
+        throw duckdb::IOException("Failed to close '%s'", path);
+    }
+    ERPL_TRACE_DEBUG("HTTP_STREAM", "Wrote " + std::to_string(bytes_written) + " bytes to " + path);
+}
+
+} // namespace erpl_web
@@ -25,6 +25,8 @@ public:
     explicit CharsetConverter(const std::string& content_type);
 
     std::string convert(const std::string& input) const;
+    // True for single-byte charsets, whose bytes convert one by one, so a body can be converted chunk by chunk
+    bool NeedsConversion() const;
 
 private:
     mutable std::optional<std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>> utf8Converter;
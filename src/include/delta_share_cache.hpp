@@ -0,0 +1,175 @@
+#pragma once
+
+#include "delta_share_types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace erpl_web {
+
+// Files listed for one version of a shared table. A version of a Delta table
+// never changes, so the list the server returned for a version and a set of
+// hints stays correct for as long as its pre-signed URLs are valid; repeated
+// scans of an unchanged table only ask the server for the table version.
+//
+// Entries expire after the TTL or shortly before the first of their URLs
+// does, whichever comes first, and the least recently used entry is dropped
+// once max_entries are held.
+class DeltaShareFileListCache {
+public:
+    static constexpr uint64_t DEFAULT_TTL_MS = 10 * 60 * 1000; // 10 minutes
+    static constexpr uint64_t DEFAULT_MAX_ENTRIES = 64;
+    // Left to a scan started from an entry to read its files before the URLs expire
+    static constexpr std::chrono::milliseconds EXPIRY_MARGIN{5 * 60 * 1000};
+
+    using Files = std::shared_ptr<const std::vector<DeltaFileReference>>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t entries = 0;
+    };
+
+    static DeltaShareFileListCache& GetInstance();
+
+    void SetTtl(uint64_t value) { ttl_ms = value; }
+    uint64_t GetTtl() const { return ttl_ms; }
+    // Drops least recently used entries down to the new limit
+    void SetMaxEntries(uint64_t value);
+    uint64_t GetMaxEntries() const { return max_entries; }
+    bool IsEnabled() const { return ttl_ms > 0 && max_entries > 0; }
+
+    // Key of the files a request returns. Only a request naming a version
+    // yields the same files every time, the version is part of the key.
+    static std::string Key(const DeltaShareProfile &profile, const std::string &share, const std::string &schema,
+                           const std::string &table, const DeltaShareQueryRequest &request);
+
+    // When a list received at `now` has to be requested again
+    static std::chrono::system_clock::time_point ExpiryOf(const std::vector<DeltaFileReference> &files,
+                                                          std::chrono::system_clock::time_point now,
+                                                          std::chrono::milliseconds ttl);
+
+    // Null when the key is unknown or its entry expired
+    Files Get(const std::string &key);
+    void Put(const std::string &key, std::vector<DeltaFileReference> files);
+    void Clear();
+
+    Stats GetStats() const;
+
+private:
+    DeltaShareFileListCache() = default;
+
+    struct Entry {
+        std::string key;
+        Files files;
+        std::chrono::system_clock::time_point expiry;
+    };
+
+    void EvictLocked(uint64_t limit);
+
+    mutable std::mutex mutex;
+    // Most recently used first
+    std::list<Entry> lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+    std::atomic<uint64_t> ttl_ms{DEFAULT_TTL_MS};
+    std::atomic<uint64_t> max_entries{DEFAULT_MAX_ENTRIES};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+class DeltaShareLocalCopy;
+
+// Opt-in local copies of the Parquet files of shared tables, enabled by
+// pointing erpl_delta_share_cache_directory at a directory.
+//
+// Files of a Delta table are immutable and keep their id for as long as they
+// belong to the table, while their pre-signed URLs change with every listing.
+// Copies are therefore named after the table and file id, so a file is
+// downloaded once and read locally by every later scan that lists it. Once
+// the directory holds more than max_bytes of copies the least recently read
+// ones are removed. Copies a scan is reading are never removed.
+class DeltaShareDiskCache {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 10ULL * 1024 * 1024 * 1024; // 10 GiB
+
+    // Downloads the file to the given path
+    using DownloadFunction = std::function<void(const std::string &path)>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t downloads = 0;
+        uint64_t evictions = 0;
+    };
+
+    static DeltaShareDiskCache& GetInstance();
+
+    // An empty directory disables the cache, a missing one is created
+    void SetDirectory(const std::string &directory);
+    std::string GetDirectory() const;
+    bool IsEnabled() const;
+    void SetMaxBytes(uint64_t value) { max_bytes = value; }
+    uint64_t GetMaxBytes() const { return max_bytes; }
+
+    // Name of the local copy of a file, empty for files without an id
+    static std::string FileName(const DeltaShareProfile &profile, const std::string &share, const std::string &schema,
+                                const std::string &table, const DeltaFileReference &file);
+
+    // Local copy of the file, downloaded first when missing. Null when the
+    // cache is disabled or the copy could not be written, the file is then
+    // read from its URL. The copy is not evicted while the result is alive.
+    std::unique_ptr<DeltaShareLocalCopy> Resolve(const std::string &file_name, uint64_t size,
+                                                 const DownloadFunction &download);
+
+    Stats GetStats() const;
+
+private:
+    friend class DeltaShareLocalCopy;
+
+    DeltaShareDiskCache() = default;
+
+    void Acquire(const std::string &file_name);
+    void Release(const std::string &file_name);
+    // Removes the least recently read copies not in use until max_bytes are held
+    void Evict(const std::string &cache_directory);
+
+    mutable std::mutex mutex;
+    std::string directory;
+    // Serializes evictions, the directory is listed and trimmed as a whole
+    std::mutex eviction_mutex;
+    // Readers per copy, held while a copy is checked and removed
+    std::mutex in_use_mutex;
+    std::unordered_map<std::string, uint64_t> in_use;
+
+    std::atomic<uint64_t> max_bytes{DEFAULT_MAX_BYTES};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> downloads{0};
+    std::atomic<uint64_t> evictions{0};
+};
+
+// A local copy being read, released when destroyed
+class DeltaShareLocalCopy {
+public:
+    DeltaShareLocalCopy(DeltaShareDiskCache &cache, std::string file_name, std::string path);
+    ~DeltaShareLocalCopy();
+
+    DeltaShareLocalCopy(const DeltaShareLocalCopy &) = delete;
+    DeltaShareLocalCopy &operator=(const DeltaShareLocalCopy &) = delete;
+
+    const std::string &Path() const { return path; }
+
+private:
+    DeltaShareDiskCache &cache;
+    std::string file_name;
+    std::string path;
+};
+
+} // namespace erpl_web
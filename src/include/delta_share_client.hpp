@@ -2,8 +2,11 @@
 
 #include "delta_share_types.hpp"
 #include "http_client.hpp"
+#include "http_stream.hpp"
+#include "json_arena.hpp"
 #include "timeout_http_client.hpp"
 #include "yyjson.hpp"
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -12,6 +15,9 @@ using namespace duckdb_yyjson;
 
 namespace erpl_web {
 
+// Receives the files of a streamed response, returning false stops the stream
+using DeltaFileCallback = std::function<bool(DeltaFileReference file)>;
+
 // Delta Sharing REST API client
 class DeltaShareClient {
 public:
@@ -30,17 +36,31 @@ public:
     DeltaTableMetadata GetTableMetadata(const string& share, const string& schema, const string& table);
     std::vector<DeltaFileReference> QueryTable(const std::string& share, const std::string& schema, const std::string& table,
                                           const std::optional<DeltaShareQueryRequest>& query_request = std::nullopt);
+    // Hands every file of the query response to on_file as soon as its line has
+    // arrived; on_file returns false to stop reading the response
+    void StreamQueryTable(const string& share, const string& schema, const string& table,
+                          const std::optional<DeltaShareQueryRequest>& query_request,
+                          const DeltaFileCallback& on_file);
 
     // Get table version
     int64_t GetTableVersion(const string& share, const string& schema, const string& table);
 
-    // Change Data Feed (for future implementation)
+    // Change Data Feed: the add, cdf and remove actions of the commits between the versions
     std::vector<DeltaFileReference> GetTableChanges(const std::string& share, const std::string& schema, const std::string& table,
                                                int64_t starting_version, std::optional<int64_t> ending_version = std::nullopt);
+    void StreamTableChanges(const string& share, const string& schema, const string& table,
+                            int64_t starting_version, std::optional<int64_t> ending_version,
+                            const DeltaFileCallback& on_file);
+
+    // Downloads a listed file to a local path. Pre-signed URLs carry their own
+    // authorization, the bearer token is not sent to the storage.
+    void DownloadFile(const DeltaFileReference& file, const string& path);
 
 private:
     DeltaShareProfile profile_;
     shared_ptr<TimeoutHttpClient> http_client_;
+    // Backs the document of the response or NDJSON line being parsed
+    mutable JsonArena json_arena_;
 
     // Helper methods for URL building and request execution
     string BuildUrl(const string& path) const;
@@ -50,16 +70,25 @@ private:
     // HTTP request execution
     DeltaShareResponse ExecuteGet(const string& endpoint, const HeaderMap& headers = {});
     DeltaShareResponse ExecutePost(const string& endpoint, const string& body = "", const HeaderMap& headers = {});
+    // The body of a successful response goes to the consumer, the returned content only holds error bodies.
+    // GET requests send no body.
+    DeltaShareResponse ExecuteStreamingRequest(HttpMethod method, const string& endpoint, const string& body,
+                                               HttpBodyConsumer& consumer);
+    void StreamQueryResponse(HttpMethod method, const string& endpoint, const string& body,
+                             const DeltaFileCallback& on_file);
 
     // Response parsing helpers
     DeltaTableMetadata ParseMetadataResponse(const string& ndjson_content);
-    vector<DeltaFileReference> ParseQueryResponse(const string& ndjson_content);
+    // Returns false when on_file stopped the stream
+    bool ParseQueryLine(const string& line, const DeltaFileCallback& on_file) const;
     vector<DeltaShareInfo> ParseSharesResponse(const string& json_content);
     vector<DeltaSchemaInfo> ParseSchemasResponse(const string& json_content, const string& share_name);
     vector<DeltaTableInfo> ParseTablesResponse(const string& json_content, const string& share_name, const string& schema_name);
 
     // Internal NDJSON and file reference parsing
     DeltaFileReference ParseFileReference(yyjson_val* file_obj) const;
+    // Parses into the arena, invalidating the previously parsed document
+    yyjson_doc* ReadJson(const char* data, size_t length) const;
 
     // Validation and error handling
     void ValidateProfile() const;
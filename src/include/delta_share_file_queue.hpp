@@ -0,0 +1,63 @@
+#pragma once
+
+#include "delta_share_types.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace erpl_web {
+
+// Files of a Delta Sharing response, listed on a background thread while the
+// scan threads already read the first ones. The response is streamed line by
+// line, so the first file can be claimed as soon as its line has arrived
+// instead of after the whole list of a table with many thousands of files.
+//
+// Files are kept until they are claimed; they are small compared to the
+// Parquet data and the listing is not held back, so a slow reader never keeps
+// the server response waiting.
+class DeltaFileQueue {
+public:
+    // Receives every file of the response, returning false stops the listing
+    using FileCallback = std::function<bool(DeltaFileReference file)>;
+    // Lists the files into the callback, e.g. DeltaShareClient::StreamQueryTable
+    using ListFunction = std::function<void(const FileCallback &)>;
+
+    explicit DeltaFileQueue(ListFunction list);
+    ~DeltaFileQueue();
+
+    DeltaFileQueue(const DeltaFileQueue &) = delete;
+    DeltaFileQueue &operator=(const DeltaFileQueue &) = delete;
+
+    // Blocks until a file is available and claims it with its position in the
+    // response. Returns false once every file was claimed, and rethrows an
+    // error raised while listing to every caller.
+    bool Next(DeltaFileReference &file, uint64_t &index);
+
+    // Files listed so far
+    uint64_t ListedFiles() const;
+    bool Finished() const;
+
+private:
+    void Run();
+
+    ListFunction list;
+
+    mutable std::mutex mutex;
+    std::condition_variable file_available;
+    std::deque<DeltaFileReference> ready;
+    uint64_t listed = 0;
+    uint64_t claimed = 0;
+    bool finished = false;
+    bool stopped = false;
+    std::exception_ptr error;
+
+    // Declared last so every member above is initialized before the worker starts
+    std::thread worker;
+};
+
+} // namespace erpl_web
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "delta_share_types.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/planner/expression.hpp"
+
+using namespace duckdb;
+
+namespace erpl_web {
+
+// Table filters DuckDB pushed into delta_share_scan, bound to the columns they
+// apply to. They are used three times before the exact check on the output:
+// as jsonPredicateHints so the server can skip files, to prune the returned
+// files on their partition values and stats, and as a condition on the
+// read_parquet of every file so its row groups can be skipped. Every
+// translation is conservative, a filter that cannot be translated keeps
+// files and rows rather than dropping them.
+class DeltaSharePushdown {
+public:
+    DeltaSharePushdown() = default;
+    // filters are keyed by the position in column_ids, like the scan output
+    DeltaSharePushdown(const vector<DeltaShareColumn> &columns, const vector<column_t> &column_ids,
+                       optional_ptr<TableFilterSet> filters);
+
+    bool HasFilters() const { return !filters.empty(); }
+
+    // Delta Sharing JSON predicate of the filters, empty when none translates
+    string JsonPredicateHints() const;
+
+    // SQL condition on the data columns of a file by their physical names,
+    // empty when none translates
+    string FileCondition() const;
+
+    // False when the partition values or the min/max/nullCount stats of the
+    // file prove that none of its rows passes the filters
+    bool MayMatch(const DeltaFileReference &file) const;
+
+    // All filters as one expression over the scan output, null without filters
+    unique_ptr<Expression> OutputFilter(const vector<LogicalType> &output_types) const;
+
+private:
+    struct ColumnFilter {
+        idx_t output_index;
+        DeltaShareColumn column;
+        // Row id and other virtual columns only take part in the exact check
+        bool virtual_column = false;
+        unique_ptr<TableFilter> filter;
+    };
+
+    vector<ColumnFilter> filters;
+};
+
+} // namespace erpl_web
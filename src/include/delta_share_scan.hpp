@@ -1,8 +1,13 @@
 #pragma once
 
 #include "delta_share_types.hpp"
+#include "delta_share_cache.hpp"
 #include "delta_share_client.hpp"
+#include "delta_share_file_queue.hpp"
+#include "delta_share_pushdown.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/execution/expression_executor.hpp"
 #include <memory>
 
 using namespace duckdb;
@@ -16,7 +21,19 @@ struct DeltaShareScanBindData : public TableFunctionData {
     string schema;
     string table;
     DeltaTableMetadata metadata;
-    // Note: files, current_file_index, and finished are stored in global state instead
+    vector<DeltaShareColumn> columns;
+    // No usable schema: every row is returned as text in a single "data" column
+    bool fallback_schema = false;
+    // limitHint of the query request, LIMIT itself is not visible to table functions
+    std::optional<int64_t> limit_hint;
+
+    // delta_share_changes: the files are the actions of the commits in the version
+    // range, and _change_type, _commit_version and _commit_timestamp follow the
+    // table columns from change_columns_start on
+    bool change_feed = false;
+    int64_t starting_version = 0;
+    std::optional<int64_t> ending_version;
+    idx_t change_columns_start = 0;
 
     // Constructor and copy prevention
     DeltaShareScanBindData() = default;
@@ -25,30 +42,62 @@ struct DeltaShareScanBindData : public TableFunctionData {
 };
 
 // Global state for delta_share_scan (extends GlobalTableFunctionState)
-// Follows DuckDB Parquet extension pattern with atomic work distribution
+// Threads claim files one at a time from the queue and read them completely,
+// while the query response is still being listed into it
 struct DeltaShareGlobalState : public GlobalTableFunctionState {
     // Shared metadata (read-only)
     shared_ptr<DeltaShareClient> client;
     DeltaTableMetadata metadata;
-    vector<DeltaFileReference> files;
+    // Table columns in output order, COLUMN_IDENTIFIER_ROW_ID and other virtual ids included
+    vector<column_t> column_ids;
+    // Pushed down filters, the files they rule out never reach the queue
+    DeltaSharePushdown pushdown;
+    // Condition of every file query, empty without translatable filters
+    string file_condition;
+    idx_t max_threads = 1;
+
+    // Declared after everything its listing thread uses, so it stops first
+    unique_ptr<DeltaFileQueue> files;
 
-    // Lock-free work distribution (Parquet pattern)
-    // Atomic index for thread-safe file claiming without locks
-    atomic<idx_t> current_file_index = 0;
-    // Note: current_batch unused (implicit in current_file_index)
-    // Note: finished unused (implicit when current_file_index >= files.size())
+    idx_t MaxThreads() const override {
+        return max_threads;
+    }
 };
 
 // Local state for delta_share_scan (extends LocalTableFunctionState)
-// Follows DuckDB Parquet extension pattern with per-thread resources
+// The Parquet files are read by DuckDB's own multi-file reader on a connection of
+// the thread, so pushed down columns, row group parallelism and remote reads all
+// come from read_parquet. Every chunk of a file is streamed before the next claim.
 struct DeltaShareLocalState : public LocalTableFunctionState {
-    // Per-thread HTTP client for connection reuse via keep-alive
-    // Each thread gets its own client—no global synchronization needed
-    shared_ptr<DeltaShareClient> http_client;
-    // Note: current_file_index is managed via atomic in global state
+    unique_ptr<Connection> connection;
+    // Disk cache copy of the file being read, declared first so it outlives the result
+    unique_ptr<DeltaShareLocalCopy> local_copy;
+    // Result of the file being read, null between files
+    unique_ptr<QueryResult> file_result;
+    DeltaFileReference file;
+    uint64_t file_index = 0;
+    // Exact check of the pushed down filters, built with the first file
+    bool filter_initialized = false;
+    unique_ptr<Expression> filter;
+    unique_ptr<ExpressionExecutor> filter_executor;
+    SelectionVector filter_sel;
 };
 
+// Query reading the projected columns of one Delta file with read_parquet: data
+// columns by their physical name, partition columns as the file's value, both
+// cast to their declared type. output_types are the scan output types in
+// column_ids order, they give the type of virtual columns such as the row id.
+// A condition, see DeltaSharePushdown::FileCondition, lets the reader skip row groups.
+// A local_path, see DeltaShareDiskCache, is read instead of the file's URL.
+string DeltaShareFileQuery(const DeltaShareScanBindData &bind_data,
+                           const vector<column_t> &column_ids,
+                           const vector<LogicalType> &output_types,
+                           const DeltaFileReference &file,
+                           const string &condition = "",
+                           const string &local_path = "");
+
 // Table function set creation
 TableFunctionSet CreateDeltaShareScanFunction();
+TableFunctionSet CreateDeltaShareChangesFunction();
 
 } // namespace erpl_web
@@ -66,6 +66,10 @@ struct DeltaFileReference {
     string id;                                 // File ID
     map<string, string> partition_values;      // Partition values if table is partitioned
     std::optional<std::string> stats;               // JSON statistics (minValues, maxValues, etc.)
+    string action;                             // Line the file came from: file, add, cdf or remove
+    std::optional<int64_t> version;            // Commit version (change data feed)
+    std::optional<int64_t> timestamp;          // Commit timestamp in ms since epoch (change data feed)
+    std::optional<int64_t> expiration_timestamp; // When the pre-signed URL expires, in ms since epoch
 };
 
 // Table metadata from Delta Sharing server
@@ -76,10 +80,20 @@ struct DeltaTableMetadata {
     vector<string> column_names;               // Column names in order
 };
 
+// Column of a shared table as declared by its Delta schema
+struct DeltaShareColumn {
+    string name;
+    // Name of the column in the Parquet files, differs from name under column mapping
+    string physical_name;
+    LogicalType type;
+    // Partition columns are not stored in the files, their values come with each file
+    bool is_partition = false;
+};
+
 // Query request for Delta Sharing /query endpoint
 struct DeltaShareQueryRequest {
     vector<string> predicate_hints;            // SQL predicates for filtering (e.g., "col1 > 100")
-    map<string, string> json_predicate_hints;  // JSON predicate format for complex filters
+    string json_predicate_hints;               // JSON predicate (Delta Sharing predicate ops) for file skipping
     std::optional<int64_t> limit_hint;         // Row limit hint
     std::optional<int64_t> version;            // Specific table version to query
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "duckdb/function/table_function.hpp"
+#include "json_arena.hpp"
 #include "yyjson.hpp"
 #include <string>
 
@@ -11,14 +12,12 @@ struct GraphJsonArrayScanBindData : public duckdb::TableFunctionData {
     duckdb_yyjson::yyjson_doc *parsed_doc = nullptr;
     duckdb_yyjson::yyjson_arr_iter item_iter = {};
     bool done = false;
-
-    ~GraphJsonArrayScanBindData() override {
-        ResetDoc();
-    }
+    // Backs parsed_doc; a scan re-initialised for its next response reuses the memory
+    JsonArena arena;
 
     bool InitIterator(const char *array_key = "value") {
         ResetDoc();
-        parsed_doc = duckdb_yyjson::yyjson_read(json_response.c_str(), json_response.length(), 0);
+        parsed_doc = arena.Read(json_response.c_str(), json_response.length());
         json_response.clear();
         json_response.shrink_to_fit();
         if (!parsed_doc) {
@@ -37,10 +36,8 @@ struct GraphJsonArrayScanBindData : public duckdb::TableFunctionData {
 
 private:
     void ResetDoc() {
-        if (parsed_doc) {
-            duckdb_yyjson::yyjson_doc_free(parsed_doc);
-            parsed_doc = nullptr;
-        }
+        parsed_doc = nullptr;
+        arena.Reset();
     }
 };
 
@@ -7,8 +7,11 @@
 #endif
 #endif
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
+#include <list>
 #include <optional>
 #include "duckdb.hpp"
 #include "odata_edm.hpp"
@@ -198,6 +201,9 @@ public:
     void AddODataVersionHeaders();
 
     std::string ToCacheKey() const;
+    // Cache key plus all headers, requests with different credentials or Accept
+    // headers never share a cached response
+    std::string ToHeaderCacheKey() const;
 
 public:
     HttpMethod method;
@@ -212,7 +218,28 @@ private:
 
 private:
     duckdb_httplib_openssl::Headers HttplibHeaders();
-    duckdb_httplib_openssl::Result Execute(duckdb_httplib_openssl::Client &client, bool url_encode);
+    // With a content receiver the body is handed over in chunks instead of being collected in the response
+    duckdb_httplib_openssl::Result Execute(duckdb_httplib_openssl::Client &client, bool url_encode,
+                                           const duckdb_httplib_openssl::ResponseHandler &response_handler = nullptr,
+                                           const duckdb_httplib_openssl::ContentReceiver &content_receiver = nullptr);
+};
+
+// ----------------------------------------------------------------------
+
+// Receives the body of a successful response chunk by chunk as it arrives from
+// the socket, so a large page never has to be held in memory as a whole.
+// Implementations live in http_stream.hpp.
+class HttpBodyConsumer
+{
+public:
+    virtual ~HttpBodyConsumer() = default;
+
+    // Called with the content type of a successful response before its first chunk
+    virtual void Start(const std::string &content_type) { }
+    // Returning false cancels the transfer
+    virtual bool Consume(const char *data, size_t length) = 0;
+    // Called once after the last chunk of a completed transfer
+    virtual void Finish() = 0;
 };
 
 // ----------------------------------------------------------------------
@@ -266,49 +293,147 @@ public:
     std::unique_ptr<HttpResponse> Get(const std::string &url);
     
     std::unique_ptr<HttpResponse> SendRequest(HttpRequest &request);
+    // The body of a 2xx response goes to the consumer and the returned response carries
+    // status and headers only, other responses keep their (error) body as content.
+    std::unique_ptr<HttpResponse> SendStreamingRequest(HttpRequest &request, HttpBodyConsumer &consumer);
 private:
     HttpParams http_params;
 
 private:
     std::unique_ptr<duckdb_httplib_openssl::Client> CreateHttplibClient(const HttpParams &http_params,
                                                                         const std::string &scheme_host_and_port);
+    static bool UsePooledConnection(const HttpRequest &request, const HttpParams &params);
+
+    std::unique_ptr<HttpResponse> DoSendRequest(HttpRequest &request, HttpBodyConsumer *consumer);
 
     uint64_t CalculateSleepTime(idx_t n_tries);
 };
 
 // ----------------------------------------------------------------------
 
-struct HttpCacheEntry {
-    HttpCacheEntry(std::unique_ptr<HttpResponse> resp, 
-                  std::chrono::time_point<std::chrono::steady_clock> exp)
-        : response(std::move(resp)), expiry(exp)     
-    {}
+// What a cached response is used for, decides whether and how long it is kept.
+// Entity set pages are read once by a scan and never stored.
+enum class HttpCacheClass {
+    NO_STORE,
+    METADATA,
+    SERVICE_DOCUMENT,
+    LOOKUP
+};
+
+// Process-wide cache policy, set through the erpl_http_cache_* settings.
+class HttpCachePolicy {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 64ULL * 1024 * 1024;        // 64 MiB
+    static constexpr uint64_t DEFAULT_METADATA_TTL_MS = 10 * 60 * 1000;       // 10 minutes
+    static constexpr uint64_t DEFAULT_SERVICE_DOCUMENT_TTL_MS = 5 * 60 * 1000; // 5 minutes
+    static constexpr uint64_t DEFAULT_LOOKUP_TTL_MS = 30 * 1000;               // 30 seconds
+    static constexpr uint64_t DEFAULT_LOOKUP_MAX_BYTES = 256ULL * 1024;        // 256 KiB
+
+    static HttpCachePolicy& GetInstance();
+
+    // Class of a request sent without an explicit one: $metadata documents are
+    // recognized by their URL, everything else is not stored. Service documents
+    // and lookups are marked by their callers.
+    static HttpCacheClass Classify(const HttpRequest &request);
+    static std::string ClassToString(HttpCacheClass cache_class);
+
+    // A TTL of 0 disables caching for the class
+    std::chrono::milliseconds GetTtl(HttpCacheClass cache_class) const;
+    // Whether a successful response of the given class may be stored at all
+    bool ShouldStore(HttpCacheClass cache_class, const HttpResponse &response) const;
+
+    void SetMaxBytes(uint64_t value) { max_bytes = value; }
+    uint64_t GetMaxBytes() const { return max_bytes; }
+    void SetMetadataTtl(uint64_t value_ms) { metadata_ttl_ms = value_ms; }
+    void SetServiceDocumentTtl(uint64_t value_ms) { service_document_ttl_ms = value_ms; }
+    void SetLookupTtl(uint64_t value_ms) { lookup_ttl_ms = value_ms; }
+    void SetLookupMaxBytes(uint64_t value) { lookup_max_bytes = value; }
+    uint64_t GetLookupMaxBytes() const { return lookup_max_bytes; }
+
+private:
+    HttpCachePolicy() = default;
 
-    std::unique_ptr<HttpResponse> response;
-    std::chrono::time_point<std::chrono::steady_clock> expiry;
+    std::atomic<uint64_t> max_bytes{DEFAULT_MAX_BYTES};
+    std::atomic<uint64_t> metadata_ttl_ms{DEFAULT_METADATA_TTL_MS};
+    std::atomic<uint64_t> service_document_ttl_ms{DEFAULT_SERVICE_DOCUMENT_TTL_MS};
+    std::atomic<uint64_t> lookup_ttl_ms{DEFAULT_LOOKUP_TTL_MS};
+    std::atomic<uint64_t> lookup_max_bytes{DEFAULT_LOOKUP_MAX_BYTES};
 };
 
+// Process-wide cache of HTTP responses, split into shards so concurrent lookups
+// (e.g. many catalog threads resolving $metadata) rarely contend on one lock.
+// Entries are keyed by HttpRequest::ToHeaderCacheKey.
+//
+// Cached responses are immutable and handed out as shared pointers, a hit never
+// copies the body. The byte budget of the HttpCachePolicy applies to the cache as
+// a whole: an insert evicts the least recently used entries across all shards, never
+// the entry it just stored. Entries carry an access stamp so the tails of the shards
+// can be compared. Expired entries are dropped lazily when they are looked up or
+// reached by eviction.
 class HttpCache {
 public:
+    static constexpr idx_t SHARD_COUNT = 16;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t insertions = 0;
+        uint64_t evictions = 0;
+        uint64_t expirations = 0;
+        uint64_t entries = 0;
+        uint64_t bytes = 0;
+    };
+
     static HttpCache& GetInstance();
 
-    std::unique_ptr<HttpResponse> GetCachedResponse(const HttpRequest& request);
-    void EmplaceCacheResponse(const HttpRequest& request, std::unique_ptr<HttpResponse> response, 
+    std::shared_ptr<const HttpResponse> GetCachedResponse(const HttpRequest& request);
+    void EmplaceCacheResponse(const HttpRequest& request, std::shared_ptr<const HttpResponse> response, 
                             const std::chrono::duration<double>& cache_duration);
     bool IsInCache(const HttpRequest& request) const;
+    uint64_t CachedBytes() const;
+    Stats GetStats() const;
+    void Clear();
+
+    // Approximate number of bytes a cached response keeps alive
+    static uint64_t ResponseSize(const HttpResponse &response);
 
 private:
-    HttpCache();
-    ~HttpCache();
-    void GarbageCollection();
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const HttpResponse> response;
+        std::chrono::steady_clock::time_point expiry;
+        uint64_t size;
+        // Value of access_clock when the entry was stored or last hit
+        uint64_t last_used;
+    };
 
-    std::unordered_map<std::string, HttpCacheEntry> cache;
-    mutable std::mutex cache_mutex;
-    
-    std::thread cleanup_thread;
-    std::mutex cleanup_mutex;
-    std::condition_variable cleanup_cv;
-    bool should_stop{false};
+    struct Shard {
+        mutable std::mutex mutex;
+        // Most recently used entry first
+        std::list<Entry> lru;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    };
+
+    HttpCache() = default;
+
+    Shard &ShardFor(const std::string &key);
+    const Shard &ShardFor(const std::string &key) const;
+    // These expect the shard mutex to be held
+    void Erase(Shard &shard, std::list<Entry>::iterator it);
+    static std::list<Entry>::iterator OldestEntry(Shard &shard, const std::string &keep_key);
+    // Evicts the least recently used entry of the whole cache other than keep_key,
+    // returns false if there is none
+    bool EvictLeastRecentlyUsed(const std::string &keep_key);
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<uint64_t> cached_bytes{0};
+    std::atomic<uint64_t> access_clock{0};
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> insertions{0};
+    std::atomic<uint64_t> evictions{0};
+    std::atomic<uint64_t> expirations{0};
 };
 
 // ----------------------------------------------------------------------
@@ -316,18 +441,25 @@ private:
 class CachingHttpClient
 {
 public:
+    // Without a cache duration the TTLs of the HttpCachePolicy apply
+    CachingHttpClient(std::shared_ptr<HttpClient> http_client);
     CachingHttpClient(std::shared_ptr<HttpClient> http_client, 
-                     const std::chrono::duration<double>& cache_duration = std::chrono::seconds(30));
+                     const std::chrono::duration<double>& cache_duration);
 
     std::shared_ptr<HttpClient> GetHttpClient();
-    std::unique_ptr<HttpResponse> Head(const std::string& url);
-    std::unique_ptr<HttpResponse> Get(const std::string& url);
-    std::unique_ptr<HttpResponse> SendRequest(HttpRequest& request);
+    std::shared_ptr<const HttpResponse> Head(const std::string& url);
+    std::shared_ptr<const HttpResponse> Get(const std::string& url);
+    std::shared_ptr<const HttpResponse> SendRequest(HttpRequest& request);
+    std::shared_ptr<const HttpResponse> SendRequest(HttpRequest& request, HttpCacheClass cache_class);
     bool IsInCache(const HttpRequest& request) const;
 
 private:
+    std::chrono::steady_clock::duration CacheDuration(HttpCacheClass cache_class) const;
+    // Cache miss path: disk cache, (conditional) request and storing the result
+    std::shared_ptr<const HttpResponse> FetchAndStore(HttpRequest& request, HttpCacheClass cache_class);
+
     std::shared_ptr<HttpClient> http_client;
-    std::chrono::duration<double> cache_duration;
+    std::optional<std::chrono::duration<double>> cache_duration;
 };
 
 } // namespace erpl_web
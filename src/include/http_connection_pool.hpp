@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "http_client.hpp"
+
+namespace erpl_web {
+
+// Process-wide pool of keep-alive httplib clients, keyed by origin.
+//
+// Each httplib client owns at most one socket (and TLS session), so a client that
+// is checked out of the pool is used exclusively by the caller until it is released.
+// The pool key combines scheme, host and port with every client setting that is
+// applied at construction time (timeouts, url encoding, TLS verification), so a
+// client is never reused with a different configuration than it was created for.
+class HttpConnectionPool {
+public:
+    using Client = duckdb_httplib_openssl::Client;
+    using ClientFactory = std::function<std::unique_ptr<Client>()>;
+
+    static constexpr bool DEFAULT_ENABLED = true;
+    static constexpr uint64_t DEFAULT_MAX_IDLE_PER_HOST = 8;
+    static constexpr uint64_t DEFAULT_IDLE_TIMEOUT_MS = 30000; // 30 sec
+
+    struct Stats {
+        uint64_t created = 0;
+        uint64_t reused = 0;
+        uint64_t released = 0;
+        uint64_t discarded = 0;
+        uint64_t expired = 0;
+        uint64_t idle = 0;
+    };
+
+    static HttpConnectionPool& GetInstance();
+
+    static std::string MakeKey(const std::string &scheme_host_and_port, const HttpParams &http_params);
+
+    // Returns an idle client for the key if a healthy one is available, otherwise
+    // creates a new one through the factory.
+    std::unique_ptr<Client> Acquire(const std::string &key, const ClientFactory &factory);
+
+    // Hands a client back to the pool. Clients that are not reusable (transport
+    // error, `Connection: close`, ...) or exceed the per-host idle limit are dropped.
+    // The limit only bounds idle clients, Acquire never waits for one to come back.
+    void Release(const std::string &key, std::unique_ptr<Client> client, bool reusable);
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+    void SetMaxIdlePerHost(uint64_t max_idle);
+    uint64_t GetMaxIdlePerHost() const;
+    void SetIdleTimeout(std::chrono::milliseconds idle_timeout);
+    std::chrono::milliseconds GetIdleTimeout() const;
+
+    void Clear();
+    Stats GetStats() const;
+
+private:
+    HttpConnectionPool() = default;
+
+    struct IdleClient {
+        std::unique_ptr<Client> client;
+        std::chrono::steady_clock::time_point last_used;
+    };
+
+    bool IsHealthy(const IdleClient &idle, std::chrono::steady_clock::time_point now) const;
+    void EvictExpired(std::deque<IdleClient> &idle_clients, std::chrono::steady_clock::time_point now,
+                      std::vector<std::unique_ptr<Client>> &evicted);
+
+    mutable std::mutex pool_mutex;
+    std::unordered_map<std::string, std::deque<IdleClient>> idle_pool;
+
+    bool enabled = DEFAULT_ENABLED;
+    uint64_t max_idle_per_host = DEFAULT_MAX_IDLE_PER_HOST;
+    std::chrono::milliseconds idle_timeout = std::chrono::milliseconds(DEFAULT_IDLE_TIMEOUT_MS);
+
+    Stats stats;
+};
+
+} // namespace erpl_web
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+#include "http_client.hpp"
+
+namespace erpl_web {
+
+// Opt-in persistent cache for cacheable GET responses ($metadata and service
+// documents), enabled by pointing erpl_http_cache_directory at a directory.
+//
+// Every entry is one file holding the response together with its ETag and
+// Last-Modified validators. A fresh entry is served without a request, an
+// expired one is revalidated with If-None-Match / If-Modified-Since so an
+// unchanged document costs a single 304 round-trip instead of a download.
+// Entries expire by wall clock because they are shared between processes.
+class HttpDiskCache {
+public:
+    struct Entry {
+        std::shared_ptr<const HttpResponse> response;
+        std::string etag;
+        std::string last_modified;
+        std::chrono::system_clock::time_point expiry;
+
+        bool IsFresh(std::chrono::system_clock::time_point now) const { return now < expiry; }
+        bool HasValidators() const { return !etag.empty() || !last_modified.empty(); }
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t revalidations = 0;
+        uint64_t writes = 0;
+    };
+
+    static HttpDiskCache& GetInstance();
+
+    // An empty directory disables the cache, a missing one is created
+    void SetDirectory(const std::string &directory);
+    std::string GetDirectory() const;
+    bool IsEnabled() const;
+
+    // Only GETs of long-lived documents are persisted, lookups expire too quickly to be worth a file
+    static bool IsPersistent(const HttpRequest &request, HttpCacheClass cache_class);
+
+    std::optional<Entry> Load(const HttpRequest &request);
+    void Store(const HttpRequest &request, const HttpResponse &response, std::chrono::milliseconds ttl);
+    // Extends a stored entry after the server answered 304 Not Modified and returns its response
+    std::shared_ptr<const HttpResponse> Revalidate(const HttpRequest &request, const Entry &entry,
+                                                   const HttpResponse &not_modified, std::chrono::milliseconds ttl);
+
+    static void AddConditionalHeaders(HttpRequest &request, const Entry &entry);
+
+    Stats GetStats() const;
+
+private:
+    HttpDiskCache() = default;
+
+    // The in-memory cache key plus the headers that select a different representation
+    static std::string DiskKey(const HttpRequest &request);
+    static std::filesystem::path PathFor(const std::string &directory, const std::string &disk_key);
+    void Write(const std::string &disk_key, const HttpResponse &response, std::chrono::system_clock::time_point expiry);
+
+    mutable std::mutex mutex;
+    std::string directory;
+
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> revalidations{0};
+    std::atomic<uint64_t> writes{0};
+};
+
+} // namespace erpl_web
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "http_client.hpp"
+
+namespace erpl_web {
+
+// Process-wide per-host request throttling shared by all HttpClient instances.
+//
+// Every request takes a token from the bucket of its host; the bucket refills at
+// the configured requests per second (0 disables the ceiling). When a server
+// throttles (429 / 503) the host is paused for the time announced by its
+// Retry-After or x-ms-retry-after-ms header, or for the client's backoff when it
+// sends none, and every thread targeting that host waits out the same pause
+// instead of retrying on its own. An exhausted x-ms-ratelimit-*-remaining budget
+// pauses the host briefly before the server starts rejecting requests.
+class HttpRateLimiter {
+public:
+    static constexpr double DEFAULT_REQUESTS_PER_SECOND = 0; // no ceiling
+    static constexpr uint64_t DEFAULT_BURST = 10;
+    static constexpr uint64_t DEFAULT_MAX_RETRY_AFTER_MS = 120000; // 2 minutes
+    static constexpr uint64_t EXHAUSTED_BUDGET_PAUSE_MS = 1000;
+
+    struct Stats {
+        uint64_t throttled = 0;
+        uint64_t waits = 0;
+        uint64_t wait_ms = 0;
+    };
+
+    static HttpRateLimiter& GetInstance();
+
+    static std::string HostKey(const std::string &scheme_host_and_port);
+
+    // Blocks until the host is not paused and a token is available
+    void Acquire(const std::string &host);
+    // Learns from the response of a request to the host and returns the pause it applied
+    std::chrono::milliseconds OnResponse(const std::string &host, int status,
+                                         const duckdb_httplib_openssl::Headers &headers,
+                                         std::chrono::milliseconds fallback_pause);
+
+    // Retry-After is either delta seconds or an HTTP date
+    static std::optional<std::chrono::milliseconds> ParseRetryAfter(const std::string &value,
+                                                                     std::chrono::system_clock::time_point now);
+    static bool IsThrottlingStatus(int status) { return status == 429 || status == 503; }
+
+    std::chrono::milliseconds PauseRemaining(const std::string &host) const;
+
+    void SetRequestsPerSecond(double value);
+    double GetRequestsPerSecond() const;
+    void SetBurst(uint64_t value);
+    void SetMaxRetryAfter(std::chrono::milliseconds value);
+    std::chrono::milliseconds GetMaxRetryAfter() const;
+
+    Stats GetStats() const;
+    void Clear();
+
+private:
+    struct HostState {
+        double tokens = 0;
+        std::chrono::steady_clock::time_point last_refill{};
+        std::chrono::steady_clock::time_point paused_until{};
+    };
+
+    HttpRateLimiter() = default;
+
+    // Both expect the mutex to be held
+    void Refill(HostState &state, std::chrono::steady_clock::time_point now) const;
+    void Pause(HostState &state, std::chrono::steady_clock::time_point now, std::chrono::milliseconds pause);
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, HostState> hosts;
+    double requests_per_second = DEFAULT_REQUESTS_PER_SECOND;
+    uint64_t burst = DEFAULT_BURST;
+    std::chrono::milliseconds max_retry_after{DEFAULT_MAX_RETRY_AFTER_MS};
+
+    std::atomic<uint64_t> throttled{0};
+    std::atomic<uint64_t> waits{0};
+    std::atomic<uint64_t> wait_ms{0};
+};
+
+} // namespace erpl_web
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "http_client.hpp"
+
+namespace erpl_web {
+
+// Coalesces identical concurrent requests: the first caller of a key performs
+// the request, callers arriving while it is in flight wait for it and share its
+// response (or its exception). Nothing is kept once the request completed,
+// reuse over time is the job of the HttpCache.
+class HttpSingleFlight {
+public:
+    using FetchFunction = std::function<std::shared_ptr<const HttpResponse>()>;
+
+    struct Stats {
+        uint64_t executed = 0;
+        uint64_t coalesced = 0;
+    };
+
+    static HttpSingleFlight& GetInstance();
+
+    // Requests are identical if their cache key and all of their headers match,
+    // so callers with different credentials never share a response.
+    static std::string FlightKey(const HttpRequest &request);
+
+    std::shared_ptr<const HttpResponse> Do(const std::string &key, const FetchFunction &fetch);
+    std::shared_ptr<const HttpResponse> Do(const HttpRequest &request, const FetchFunction &fetch);
+
+    uint64_t InFlight() const;
+    Stats GetStats() const;
+
+private:
+    HttpSingleFlight() = default;
+
+    using SharedResult = std::shared_future<std::shared_ptr<const HttpResponse>>;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, SharedResult> in_flight;
+
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> coalesced{0};
+};
+
+} // namespace erpl_web
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "charset_converter.hpp"
+#include "http_client.hpp"
+
+namespace erpl_web {
+
+// Body consumers for HttpClient::SendStreamingRequest. Each keeps at most one
+// record (a line, an array item) besides the chunk it is handed, so peak memory
+// follows the largest record instead of the size of the page.
+
+// Splits a newline delimited JSON body (Delta Sharing) into lines. Carriage
+// returns are stripped and empty lines skipped; the last line needs no newline.
+class NdjsonLineSplitter : public HttpBodyConsumer
+{
+public:
+    // Returning false stops the transfer
+    using LineCallback = std::function<bool(const std::string &line)>;
+
+    explicit NdjsonLineSplitter(LineCallback on_line);
+
+    bool Consume(const char *data, size_t length) override;
+    void Finish() override;
+
+    uint64_t LineCount() const { return line_count; }
+    // Largest number of bytes held back while waiting for the end of a line
+    uint64_t MaxBufferedBytes() const { return max_buffered_bytes; }
+
+private:
+    bool EmitLine();
+
+    LineCallback on_line;
+    std::string line;
+    uint64_t line_count = 0;
+    uint64_t max_buffered_bytes = 0;
+};
+
+// Hands out the items of the first JSON array found at one of the given member
+// paths one by one as raw JSON text, e.g. the entities of an OData {"value": [...]}
+// or {"d": {"results": [...]}} page. Everything around the array is kept as the
+// envelope with the array emptied, so members such as @odata.nextLink or __count
+// can be read once the body is complete.
+//
+// The streamer only follows the structure of the document to find the item
+// boundaries, the items themselves are left to the caller to parse. Members of
+// object items the caller does not need can be left out as they stream by, so
+// an entity is parsed with its projected properties only.
+class JsonArrayItemStreamer : public HttpBodyConsumer
+{
+public:
+    // The item may be changed or moved from, e.g. to parse it in situ
+    using ItemCallback = std::function<bool(std::string &item)>;
+    using MemberPath = std::vector<std::string>;
+
+    JsonArrayItemStreamer(std::vector<MemberPath> array_paths, ItemCallback on_item);
+
+    // value (v4), d.results and d (v2)
+    static std::vector<MemberPath> ODataItemPaths();
+
+    // Only these members of object items are kept in the item text, by default all are
+    void KeepItemMembers(std::unordered_set<std::string> members);
+
+    bool Consume(const char *data, size_t length) override;
+    void Finish() override;
+
+    bool FoundArray() const { return found_array; }
+    uint64_t ItemCount() const { return item_count; }
+    const std::string &Envelope() const { return envelope; }
+    uint64_t MaxBufferedBytes() const { return max_buffered_bytes; }
+
+private:
+    struct Frame {
+        bool is_object;
+        bool expecting_key;
+        std::string key;
+    };
+
+    bool IsItemArray() const;
+    // Whether the innermost open value is an object item whose members are filtered
+    bool InFilteredItem() const;
+    bool EmitItem();
+    // Moves the bytes since `run` to the item or the envelope, whichever is being read
+    void Flush(const char *run, const char *end);
+
+    std::vector<MemberPath> array_paths;
+    // Keys are only recorded as deep as the longest path, not inside the items
+    size_t key_depth = 0;
+    ItemCallback on_item;
+
+    std::vector<Frame> frames;
+    bool in_string = false;
+    bool escaped = false;
+    bool reading_key = false;
+    // Depth of the item array while it is open, SIZE_MAX otherwise
+    size_t array_depth = SIZE_MAX;
+    bool found_array = false;
+    bool finished = false;
+
+    bool filter_members = false;
+    std::unordered_set<std::string> kept_members;
+    // Members of the current item written so far, where the current one starts and whether it is skipped
+    size_t item_members = 0;
+    size_t member_start = 0;
+    bool skipping_member = false;
+
+    std::string item;
+    std::string envelope;
+    uint64_t item_count = 0;
+    uint64_t max_buffered_bytes = 0;
+};
+
+// Converts a body in a single-byte charset (e.g. ISO-8859-1 as named by the
+// Content-Type of some SAP systems) to UTF-8 on its way to the wrapped consumer.
+// UTF-8 bodies are passed through untouched.
+class HttpCharsetConsumer : public HttpBodyConsumer
+{
+public:
+    explicit HttpCharsetConsumer(HttpBodyConsumer &consumer);
+
+    void Start(const std::string &content_type) override;
+    bool Consume(const char *data, size_t length) override;
+    void Finish() override;
+
+private:
+    HttpBodyConsumer &consumer;
+    std::unique_ptr<CharsetConverter> converter;
+};
+
+// Writes the body to a file, e.g. to download a large export without keeping it in memory
+class HttpFileSink : public HttpBodyConsumer
+{
+public:
+    explicit HttpFileSink(const std::string &path);
+
+    bool Consume(const char *data, size_t length) override;
+    void Finish() override;
+
+    uint64_t BytesWritten() const { return bytes_written; }
+
+private:
+    std::string path;
+    std::ofstream out;
+    uint64_t bytes_written = 0;
+};
+
+} // namespace erpl_web
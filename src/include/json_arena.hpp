@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "yyjson.hpp"
+
+namespace erpl_web {
+
+// Bump allocator behind a yyjson_alc. Reading a document through it costs a
+// block allocation at most instead of a malloc per buffer yyjson sets up or
+// grows, and freeing the document costs nothing. Reset() drops every document
+// at once but keeps the memory, so a scan reading page after page of similar
+// size stops touching the heap after its first page. Not thread-safe, an arena
+// belongs to one reader at a time.
+class JsonArena {
+public:
+    static constexpr size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+
+    explicit JsonArena(size_t initial_block_size = INITIAL_BLOCK_SIZE);
+
+    JsonArena(const JsonArena &) = delete;
+    JsonArena &operator=(const JsonArena &) = delete;
+
+    const duckdb_yyjson::yyjson_alc *Allocator() const { return &alc; }
+
+    // Reads `size` bytes; with YYJSON_READ_INSITU they must be followed by
+    // YYJSON_PADDING_SIZE zero bytes and stay alive as long as the document.
+    // The document is valid until the next Reset() and needs no yyjson_doc_free.
+    duckdb_yyjson::yyjson_doc *Read(char *data, size_t size, duckdb_yyjson::yyjson_read_flag flags = 0);
+    duckdb_yyjson::yyjson_doc *Read(const char *data, size_t size);
+
+    // Invalidates all documents read so far, the memory is kept for the next ones
+    void Reset();
+
+    uint64_t DocumentCount() const { return document_count; }
+    // Allocations yyjson asked for
+    uint64_t RequestCount() const { return request_count; }
+    // Allocations that reached the heap
+    uint64_t HeapAllocationCount() const { return heap_allocation_count; }
+    size_t Capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    static void *Malloc(void *ctx, size_t size);
+    static void *Realloc(void *ctx, void *ptr, size_t old_size, size_t size);
+    static void Free(void *ctx, void *ptr);
+
+    void *Allocate(size_t size);
+    void *Reallocate(void *ptr, size_t old_size, size_t size);
+    void AddBlock(size_t min_size);
+
+    duckdb_yyjson::yyjson_alc alc;
+    std::vector<Block> blocks;
+    // Bump offset into the last block and the start of its latest allocation,
+    // which is the only one that can grow in place
+    size_t offset = 0;
+    char *last_allocation = nullptr;
+    size_t next_block_size;
+
+    uint64_t document_count = 0;
+    uint64_t request_count = 0;
+    uint64_t heap_allocation_count = 0;
+};
+
+// Hands out arenas to documents that live side by side, e.g. the pages a scan
+// buffers or prefetches. An arena is reset and returned to the pool once the
+// last holder of its document lets go of it. Acquire is thread-safe.
+class JsonArenaPool : public std::enable_shared_from_this<JsonArenaPool> {
+public:
+    struct Stats {
+        uint64_t arenas = 0;
+        uint64_t documents = 0;
+        uint64_t requests = 0;
+        uint64_t heap_allocations = 0;
+    };
+
+    ~JsonArenaPool();
+
+    std::shared_ptr<JsonArena> Acquire();
+
+    // Totals of the arenas currently back in the pool
+    Stats GetStats() const;
+
+private:
+    void Release(JsonArena *arena);
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<JsonArena>> idle;
+};
+
+} // namespace erpl_web
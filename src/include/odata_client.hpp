@@ -16,12 +16,12 @@ namespace erpl_web {
 template <typename TContent>
 class ODataResponse {
 public:
-    ODataResponse(std::unique_ptr<HttpResponse> http_response) 
+    ODataResponse(std::shared_ptr<const HttpResponse> http_response) 
         : http_response(std::move(http_response))
     { }
 
     std::string ContentType() { 
-        return http_response->ContentType(); 
+        return http_response != nullptr ? http_response->ContentType() : released_content_type; 
     }
 
     std::shared_ptr<TContent> Content()
@@ -33,26 +33,46 @@ public:
 
         ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Parsing HTTP response content");
         ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Content type: " + http_response->ContentType());
-        ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Content size: " + std::to_string(http_response->Content().length()) + " bytes");
+        ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Content size: " + std::to_string(http_response->content.size()) + " bytes");
         
-        // For now, use default v4 version - the derived classes will override this
+        // For now, use default v4 version - the derived classes will override this.
+        // The converted body is handed over, the content parses it in place.
         parsed_content = CreateODataContent(http_response->Content(), ODataVersion::V4);
         
         ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Successfully parsed content");
         return parsed_content;
     }
 
+    // Parses the body if that did not happen yet and drops the raw bytes, so
+    // a page is held once, as its parsed content, while it waits to be scanned
+    void ReleaseRawContent()
+    {
+        if (http_response == nullptr) {
+            return;
+        }
+        Content();
+        released_content_type = http_response->ContentType();
+        http_response.reset();
+        ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Released raw response content");
+    }
+
 protected:
-    std::unique_ptr<HttpResponse> http_response;
+    std::shared_ptr<const HttpResponse> http_response;
     std::shared_ptr<TContent> parsed_content;
+    std::string released_content_type;
 
 private:
-    virtual std::shared_ptr<TContent> CreateODataContent(const std::string& content, ODataVersion odata_version) = 0;
+    virtual std::shared_ptr<TContent> CreateODataContent(std::string content, ODataVersion odata_version) = 0;
 };
 
 class ODataEntitySetResponse : public ODataResponse<ODataEntitySetContent> {
 public:
-    ODataEntitySetResponse(std::unique_ptr<HttpResponse> http_response, ODataVersion odata_version = ODataVersion::V4);
+    // Pages of a client that passes its arena pool are parsed into arenas reused across pages
+    ODataEntitySetResponse(std::shared_ptr<const HttpResponse> http_response, ODataVersion odata_version = ODataVersion::V4,
+                           std::shared_ptr<JsonArenaPool> arena_pool = nullptr);
+    // A page parsed while it was received, it has no raw content
+    ODataEntitySetResponse(std::shared_ptr<ODataEntitySetContent> content, std::string content_type,
+                           ODataVersion odata_version, size_t content_length);
     virtual ~ODataEntitySetResponse() = default; 
         
     std::string MetadataContextUrl();
@@ -61,21 +81,25 @@ public:
     std::vector<std::vector<duckdb::Value>> ToRows(std::vector<std::string> &column_names, 
                                                    std::vector<duckdb::LogicalType> &column_types);
     
-    // Expose raw response content for downstream processing (e.g., expand extraction)
-    std::string RawContent() const { return http_response->Content(); }
+    // Raw response body; throws once ReleaseRawContent dropped it
+    std::string RawContent() const;
+    // Size of the body as received, still known after it was released
+    size_t ContentLength() const { return content_length; }
     
     ODataVersion GetODataVersion() const { return odata_version; }
 private:
-    std::shared_ptr<ODataEntitySetContent> CreateODataContent(const std::string& content, ODataVersion odata_version) override;
+    std::shared_ptr<ODataEntitySetContent> CreateODataContent(std::string content, ODataVersion odata_version) override;
     
     ODataVersion odata_version;
+    size_t content_length = 0;
+    std::shared_ptr<JsonArenaPool> arena_pool;
 };
 
 // ----------------------------------------------------------------------
 
 class ODataServiceResponse : public ODataResponse<ODataServiceContent> {
 public:
-    ODataServiceResponse(std::unique_ptr<HttpResponse> http_response, ODataVersion odata_version = ODataVersion::V4);
+    ODataServiceResponse(std::shared_ptr<const HttpResponse> http_response, ODataVersion odata_version = ODataVersion::V4);
     virtual ~ODataServiceResponse() = default;
 
     std::string MetadataContextUrl();
@@ -83,7 +107,7 @@ public:
     
     ODataVersion GetODataVersion() const { return odata_version; }
 private:
-    std::shared_ptr<ODataServiceContent> CreateODataContent(const std::string& content, ODataVersion odata_version) override;
+    std::shared_ptr<ODataServiceContent> CreateODataContent(std::string content, ODataVersion odata_version) override;
     
     ODataVersion odata_version;
 };
@@ -149,6 +173,8 @@ public:
     virtual bool HasInputParameters() const { return false; }
 
     std::string Url() const { return url.ToString(); }
+    // True once a page was fetched, i.e. Get(true) can follow its next link
+    bool HasResponse() const { return current_response != nullptr; }
     std::shared_ptr<HttpClient> GetHttpClient() const { return http_client->GetHttpClient(); }
     std::shared_ptr<HttpAuthParams> AuthParams() const { return auth_params; }
 protected:
@@ -159,7 +185,9 @@ protected:
     ODataVersion odata_version;
     std::string metadata_context_url; // For Datasphere dual-URL pattern
 
-    std::unique_ptr<HttpResponse> DoHttpGet(const HttpUrl& url) {
+    // Result pages are read once and bypass the HTTP cache, callers fetching
+    // reusable documents pass their cache class explicitly.
+    std::shared_ptr<const HttpResponse> DoHttpGet(const HttpUrl& url, HttpCacheClass cache_class = HttpCacheClass::NO_STORE) {
         // Create a copy of the URL to modify with input parameters
         HttpUrl modified_url = url;
         
@@ -180,7 +208,7 @@ protected:
             http_request.AuthHeadersFromParams(*auth_params);
         }
 
-        auto http_response = http_client->SendRequest(http_request);
+        auto http_response = http_client->SendRequest(http_request, cache_class);
 
         if (http_response == nullptr || http_response->Code() != 200) {
             std::stringstream ss;
@@ -193,7 +221,7 @@ protected:
         return http_response;
     }
 
-    std::unique_ptr<HttpResponse> DoMetadataHttpGet(const std::string& metadata_url_raw) 
+    std::shared_ptr<const HttpResponse> DoMetadataHttpGet(const std::string& metadata_url_raw) 
     {
         // Sanitize: strip any query from a $metadata URL (e.g., remove "$format=json")
         std::string sanitized_raw = metadata_url_raw;
@@ -233,15 +261,16 @@ protected:
         }
         ERPL_TRACE_DEBUG("ODATA_CLIENT", request_trace.str());
         
-        std::unique_ptr<HttpResponse> metadata_response;
+        std::shared_ptr<const HttpResponse> metadata_response;
         for (size_t num_retries = 3; num_retries > 0; --num_retries) {
             ERPL_TRACE_DEBUG("ODATA_CLIENT", "Metadata request attempt " + std::to_string(4 - num_retries) + " of 3");
-            // Use a fresh non-cached HTTP client for metadata to mirror http_get behavior exactly
+            // Use a fresh HTTP client for metadata to mirror http_get behavior exactly,
+            // the document itself is kept in the HTTP cache under the metadata TTL.
             HttpParams meta_params;
             meta_params.url_encode = false;
             meta_params.keep_alive = false;
-            HttpClient meta_client(meta_params);
-            metadata_response = meta_client.SendRequest(metadata_request);
+            CachingHttpClient meta_client(std::make_shared<HttpClient>(meta_params));
+            metadata_response = meta_client.SendRequest(metadata_request, HttpCacheClass::METADATA);
             if (metadata_response != nullptr && metadata_response->Code() == 200) {
                 // Trace successful metadata response
                 std::stringstream response_trace;
@@ -333,8 +362,16 @@ public:
     virtual ~ODataEntitySetClient() = default;
 
     std::shared_ptr<ODataEntitySetResponse> Get(bool get_next = false) override;
+    // Same as Get, but the page is parsed while it is received instead of
+    // after its body was read, so the response has no raw content
+    std::shared_ptr<ODataEntitySetResponse> GetPage(bool get_next = false);
     std::string GetMetadataContextUrl() override;
 
+    // Properties GetPage keeps of every entity, the others are skipped while the page
+    // is received. Unset keeps all of them.
+    void SetProjectedProperties(std::optional<std::unordered_set<std::string>> properties);
+    const std::optional<std::unordered_set<std::string>> &ProjectedProperties() const { return projected_properties; }
+
     std::vector<std::string> GetResultNames();
     std::vector<duckdb::LogicalType> GetResultTypes();
     
@@ -355,8 +392,33 @@ public:
     // Public access to entity type information for navigation property filtering
     EntityType GetCurrentEntityType();
 
+    // Key property names of the current entity type, empty when metadata is unavailable
+    std::vector<std::string> GetKeyPropertyNames();
+
+    // Number of entities addressed by the current URL (honours $filter) via the /$count segment.
+    // Returns std::nullopt when the service does not support $count. Counts are small lookups
+    // and cached as such unless the caller needs a current one.
+    std::optional<uint64_t> GetCount(HttpCacheClass cache_class = HttpCacheClass::LOOKUP);
+
+    // Streaming counterpart of Get / ToRows: reads the current page, or with get_next the page
+    // the previously streamed one links to, and hands every entity to on_row as soon as it is
+    // parsed instead of building the page document. Returns false when there is no such page.
+    bool StreamRows(const std::vector<std::string> &column_names,
+                    const std::vector<duckdb::LogicalType> &column_types,
+                    const ODataJsonRowReader::RowCallback &on_row,
+                    bool get_next = false);
+
 private:
     EntitySet GetCurrentEntitySetType();
+    std::shared_ptr<ODataEntitySetResponse> Fetch(bool get_next, bool stream_page);
+    std::shared_ptr<ODataEntitySetResponse> DoHttpGetPage(const HttpUrl &page_url);
+
+    // Next link of the last page read by StreamRows
+    std::optional<std::string> streamed_next_url;
+    std::optional<std::unordered_set<std::string>> projected_properties;
+
+    // Arenas the pages of this client are parsed into, shared by the pages in flight
+    std::shared_ptr<JsonArenaPool> arena_pool = std::make_shared<JsonArenaPool>();
     
     // For Datasphere input parameters: storage for input parameters
     std::map<std::string, std::string> input_parameters;
@@ -2,7 +2,15 @@
 
 #include "odata_edm.hpp"
 #include "http_client.hpp"
+#include "http_stream.hpp"
+#include "json_arena.hpp"
 #include "yyjson.hpp"
+#include "duckdb/common/string_map_set.hpp"
+#include "duckdb/common/types/vector_buffer.hpp"
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace duckdb_yyjson;
 
@@ -18,14 +26,40 @@ public:
     virtual void PrettyPrint() = 0;
 };
 
+class ODataColumnDecoder;
+class ODataStringDictionary;
+
+// Maps an entity property to a column of the output chunk for columnar decoding
+struct ODataColumnBinding {
+    std::string property_name;
+    duckdb::LogicalType type;
+    duckdb::idx_t output_index;
+    // Decoder compiled from `type`, set once per scan; DecodeRows compiles one when missing
+    std::shared_ptr<const ODataColumnDecoder> decoder;
+    // Optional for VARCHAR columns: while enabled, DecodeRows records the values
+    // here instead of in the output vector and the owner flushes the chunk
+    std::shared_ptr<ODataStringDictionary> dictionary;
+};
+
 class ODataEntitySetContent : public ODataContent {
 public:
     virtual ~ODataEntitySetContent() = default;
     virtual std::optional<std::string> NextUrl() = 0;
     virtual std::vector<std::vector<duckdb::Value>> ToRows(std::vector<std::string> &column_names, 
                                                            std::vector<duckdb::LogicalType> &column_types) = 0;
+
+    // Columnar access: number of entities on the page, and decoding of the rows
+    // [row_offset, row_offset + row_count) straight into the bound output vectors,
+    // starting at output_offset. Missing or undecodable values become NULL.
+    virtual duckdb::idx_t RowCount() = 0;
+    virtual void DecodeRows(duckdb::idx_t row_offset, duckdb::idx_t row_count,
+                            const std::vector<ODataColumnBinding> &columns,
+                            duckdb::DataChunk &output, duckdb::idx_t output_offset) = 0;
     // Optional total row count for OData v4 when $count=true is used
     virtual std::optional<uint64_t> TotalCount() { return std::nullopt; }
+    // Entity object of a row of the parsed page, so that e.g. $expand columns are
+    // decoded from the same document as the rows; nullptr if the content is not JSON
+    virtual yyjson_val *Entity(duckdb::idx_t row) { return nullptr; }
 };
 
 struct ODataEntitySetReference {
@@ -43,11 +77,40 @@ public:
 };
 
 // -------------------------------------------------------------------------------------------------
+
+// The bytes of a page parsed in situ. Strings of the DOM point into them, so a
+// VARCHAR vector can reference the buffer instead of copying its strings; the
+// vector then keeps the buffer alive for as long as it holds them.
+class ODataPageBuffer : public duckdb::VectorBuffer {
+public:
+    explicit ODataPageBuffer(std::string content);
+    // Empty, the entities of a streamed page are appended as they arrive
+    ODataPageBuffer();
+
+    char *Data() { return &bytes[0]; }
+    // Size of the content, without the zero padding the in-situ parser needs
+    size_t Size() const { return size; }
+
+    // Copies the bytes followed by the zero padding into the buffer. The copy
+    // never moves, the buffer grows by blocks.
+    char *Append(const char *data, size_t length);
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::string bytes;
+    size_t size;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t block_capacity = 0;
+    size_t block_used = 0;
+};
+
 class ODataJsonContentMixin {
 public:
     static bool IsJsonContentType(const std::string& content_type);
 
-    ODataJsonContentMixin(const std::string& content);
+    // Takes over the content and parses it in situ, into the arena when one is given
+    ODataJsonContentMixin(std::string content, std::shared_ptr<JsonArena> arena = nullptr);
 
     // OData version support
     void SetODataVersion(ODataVersion version) { odata_version = version; }
@@ -55,12 +118,21 @@ public:
     
     // Auto-detect OData version from JSON content
     static ODataVersion DetectODataVersion(const std::string& content);
+    // Same detection on the document this content already parsed
+    ODataVersion DetectedODataVersion() const;
 
 protected:
+    // For readers that decode values without holding a document
+    ODataJsonContentMixin() = default;
+
+    // Owns the bytes the strings of `doc` point into
+    duckdb::buffer_ptr<ODataPageBuffer> page_buffer;
     std::shared_ptr<yyjson_doc> doc;
     ODataVersion odata_version = ODataVersion::V4; // Default to v4 for backward compatibility
 
-    void ThrowTypeError(yyjson_val *json_value, const std::string &expected);
+    static ODataVersion DetectODataVersion(yyjson_val *root);
+
+    static void ThrowTypeError(yyjson_val *json_value, const std::string &expected);
     void PrettyPrint();
     std::string MetadataContextUrl();
     std::optional<std::string> NextUrl();
@@ -70,26 +142,31 @@ protected:
     std::string GetMetadataContextUrl(yyjson_val* root);
     std::optional<std::string> GetNextUrl(yyjson_val* root);
     
-    duckdb::Value DeserializeJsonValue(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
-    duckdb::Value DeserializeJsonBool(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonSignedInt8(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonUnsignedInt8(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonSignedInt16(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonUnsignedInt16(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonSignedInt32(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonUnsignedInt32(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonSignedInt64(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonUnsignedInt64(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonFloat(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonDouble(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonString(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonDecimal(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
-    duckdb::Value DeserializeJsonDate(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonTime(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonTimestamp(yyjson_val *json_value);
-    duckdb::Value DeserializeJsonEnum(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
-    duckdb::Value DeserializeJsonArray(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
-    duckdb::Value DeserializeJsonObject(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
+    // Conversions are stateless; ODataColumnDecoder calls them for the values
+    // its own fast paths do not handle.
+    friend class ODataColumnDecoder;
+    friend class ODataStringDictionary;
+
+    static duckdb::Value DeserializeJsonValue(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
+    static duckdb::Value DeserializeJsonBool(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonSignedInt8(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonUnsignedInt8(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonSignedInt16(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonUnsignedInt16(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonSignedInt32(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonUnsignedInt32(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonSignedInt64(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonUnsignedInt64(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonFloat(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonDouble(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonString(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonDecimal(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
+    static duckdb::Value DeserializeJsonDate(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonTime(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonTimestamp(yyjson_val *json_value);
+    static duckdb::Value DeserializeJsonEnum(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
+    static duckdb::Value DeserializeJsonArray(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
+    static duckdb::Value DeserializeJsonObject(yyjson_val *json_value, const duckdb::LogicalType &duck_type);
 
     std::string GetStringProperty(yyjson_val *json_value, const std::string &property_name) const;
 
@@ -98,11 +175,161 @@ protected:
     std::vector<std::string> ParseJsonPath(const std::string& path);
 };
 
+// Decoder for one column, compiled from the column type once per scan. Decoding
+// a cell is then a single indirect call into a writer specialised for the type
+// instead of a switch on the LogicalTypeId per value. STRUCT and LIST columns
+// compile a decoder per field or for the element type and write straight into
+// the child vectors. Values are the same DeserializeJsonValue produces.
+class ODataColumnDecoder {
+public:
+    explicit ODataColumnDecoder(const duckdb::LogicalType &type);
+
+    const duckdb::LogicalType &Type() const { return type; }
+
+    // Writes a value, nullptr for a missing property, into `row` of a vector of
+    // Type(). Throws when the value cannot be converted, the caller decides
+    // whether that makes the cell NULL.
+    void Write(yyjson_val *json_value, duckdb::Vector &target, duckdb::idx_t row) const {
+        if (!json_value || yyjson_is_null(json_value)) {
+            duckdb::FlatVector::SetNull(target, row, true);
+            return;
+        }
+        write(*this, json_value, target, row);
+    }
+
+    // Points `row` of a VARCHAR vector at the string in the parsed document
+    // instead of copying it; the caller has added the document's page buffer to
+    // the vector. False for values that need converting, Write handles those.
+    static bool WriteStringReference(yyjson_val *json_value, duckdb::Vector &target, duckdb::idx_t row);
+
+private:
+    using WriteFunction = void (*)(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                   duckdb::Vector &target, duckdb::idx_t row);
+
+    template <class T, duckdb::Value (*FALLBACK)(yyjson_val *)>
+    static void WriteInteger(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                             duckdb::Vector &target, duckdb::idx_t row);
+    template <class T, duckdb::Value (*FALLBACK)(yyjson_val *)>
+    static void WriteFloating(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                              duckdb::Vector &target, duckdb::idx_t row);
+    template <duckdb::Value (*CONVERT)(yyjson_val *)>
+    static void WriteConverted(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                               duckdb::Vector &target, duckdb::idx_t row);
+    template <duckdb::Value (*CONVERT)(yyjson_val *, const duckdb::LogicalType &)>
+    static void WriteConvertedWithType(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                       duckdb::Vector &target, duckdb::idx_t row);
+    static void WriteBool(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                          duckdb::Vector &target, duckdb::idx_t row);
+    static void WriteString(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                            duckdb::Vector &target, duckdb::idx_t row);
+    static void WriteStruct(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                            duckdb::Vector &target, duckdb::idx_t row);
+    static void WriteList(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                          duckdb::Vector &target, duckdb::idx_t row);
+    static void WriteUnsupported(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                 duckdb::Vector &target, duckdb::idx_t row);
+
+    duckdb::LogicalType type;
+    WriteFunction write;
+    // STRUCT fields in declaration order, or the single LIST element
+    std::vector<std::string> field_names;
+    std::vector<ODataColumnDecoder> children;
+};
+
+// Collects the values of a VARCHAR column over one output chunk as its distinct
+// strings plus a selection into them. Flush hands the chunk to DuckDB as a
+// dictionary vector, so a company code, currency or unit repeated on every row
+// is stored once and hashing or grouping downstream can work per distinct value.
+// A column whose chunk turns out mostly distinct is flushed flat and decoded
+// without the dictionary for the rest of the scan.
+class ODataStringDictionary {
+public:
+    ODataStringDictionary();
+
+    // False once the values were found not to repeat
+    bool Enabled() const { return enabled; }
+
+    // Records the value of `row` of the chunk; null or missing values become NULL
+    void Write(yyjson_val *json_value, duckdb::idx_t row);
+    void SetNull(duckdb::idx_t row);
+
+    // Moves the rows [0, count) into `target` and starts the next chunk
+    void Flush(duckdb::Vector &target, duckdb::idx_t count);
+
+    duckdb::idx_t DictionaryChunks() const { return dictionary_chunks; }
+
+private:
+    // Entry 0 of the distinct values is the NULL every missing value points to
+    static constexpr duckdb::sel_t NULL_ENTRY = 0;
+
+    duckdb::sel_t Insert(const char *data, duckdb::idx_t length);
+    void Reset();
+
+    bool enabled = true;
+    // Handed over to the output vector by Flush, so a fresh one is made per chunk
+    duckdb::unique_ptr<duckdb::Vector> values;
+    duckdb::SelectionVector selection;
+    duckdb::string_map_t<duckdb::sel_t> positions;
+    duckdb::idx_t value_count = 0;
+    duckdb::idx_t dictionary_chunks = 0;
+};
+
+// Finds the projected properties of entity objects without a key scan per
+// property. Servers write the properties of every entity in the same order, so
+// their positions are learned from one object and later objects are read
+// positionally, stopping after the last projected property. An object whose keys
+// do not line up is learned anew through a hash of the property names and
+// becomes the layout for the following ones. A property absent from the layout
+// is still looked up by name, it may be present in other objects.
+class ODataPropertyLayout {
+public:
+    explicit ODataPropertyLayout(const std::vector<std::string> &property_names);
+
+    const std::vector<std::string> &PropertyNames() const { return property_names; }
+
+    // Sets values[i] to the value of property i, nullptr when the property is
+    // absent or `object` is not a JSON object. Like yyjson_obj_get, the first
+    // occurrence of a key wins.
+    void Resolve(yyjson_val *object, yyjson_val **values);
+
+    uint64_t PositionalObjects() const { return positional_objects; }
+    uint64_t LearnedObjects() const { return learned_objects; }
+
+private:
+    static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+    struct Slot {
+        size_t position;
+        size_t property;
+    };
+
+    void Learn(yyjson_val *object, yyjson_val **values);
+    void ResolveAbsent(yyjson_val *object, yyjson_val **values) const;
+
+    std::vector<std::string> property_names;
+    // First property index per distinct name
+    std::unordered_map<std::string, size_t> property_by_name;
+    std::vector<size_t> first_property;
+
+    bool learned = false;
+    size_t object_size = 0;
+    // Distinct properties present in the layout, ordered by position
+    std::vector<Slot> slots;
+    // Distinct properties not present in the layout
+    std::vector<size_t> absent;
+
+    uint64_t positional_objects = 0;
+    uint64_t learned_objects = 0;
+};
+
 // -------------------------------------------------------------------------------------------------
 
 class ODataEntitySetJsonContent : public ODataEntitySetContent, public ODataJsonContentMixin {
 public:
-    ODataEntitySetJsonContent(const std::string& content);
+    ODataEntitySetJsonContent(std::string content, std::shared_ptr<JsonArena> arena = nullptr);
+    // A page read by ODataEntitySetPageReader, the envelope and every entity parsed on their own
+    ODataEntitySetJsonContent(duckdb::buffer_ptr<ODataPageBuffer> page_buffer, std::shared_ptr<yyjson_doc> envelope,
+                              std::vector<yyjson_val *> entities);
     virtual ~ODataEntitySetJsonContent() = default;
 
     std::string MetadataContextUrl() override;
@@ -112,12 +339,97 @@ public:
     std::vector<std::vector<duckdb::Value>> ToRows(std::vector<std::string> &column_names, 
                                                    std::vector<duckdb::LogicalType> &column_types) override;
 
+    duckdb::idx_t RowCount() override;
+    void DecodeRows(duckdb::idx_t row_offset, duckdb::idx_t row_count,
+                    const std::vector<ODataColumnBinding> &columns,
+                    duckdb::DataChunk &output, duckdb::idx_t output_offset) override;
+
     std::optional<uint64_t> TotalCount() override;
+    yyjson_val *Entity(duckdb::idx_t row) override;
+
+private:
+    // Entity objects of the value array, resolved once so row ranges can be addressed directly
+    std::vector<yyjson_val *> entities;
+    bool entities_indexed = false;
+    // Key layout of the entities for the properties last decoded
+    std::unique_ptr<ODataPropertyLayout> layout;
+
+    void IndexEntities();
+    ODataPropertyLayout &LayoutFor(const std::vector<std::string> &property_names);
+};
+
+// Reads an OData v2 (d.results, __next, __count) or v4 (value, @odata.nextLink,
+// @odata.count) entity set page chunk by chunk as HttpClient::SendStreamingRequest
+// receives it. JsonArrayItemStreamer finds the entities, each is parsed once on
+// its own and handed out as a row right away, so memory stays at one entity
+// however large the page is. Properties other than the columns are skipped by the
+// streamer and never parsed. Rows are the same as ODataEntitySetJsonContent::ToRows
+// returns for the whole page.
+class ODataJsonRowReader : public HttpBodyConsumer, public ODataJsonContentMixin {
+public:
+    // Returning false stops reading the page
+    using RowCallback = std::function<bool(std::vector<duckdb::Value> &row)>;
+
+    ODataJsonRowReader(const std::vector<std::string> &column_names,
+                       const std::vector<duckdb::LogicalType> &column_types,
+                       RowCallback on_row);
+
+    bool Consume(const char *data, size_t length) override;
+    void Finish() override;
+
+    // Envelope members, available after Finish
+    std::optional<std::string> NextLink();
+    std::optional<uint64_t> TotalCount();
+    std::string ContextUrl();
+    duckdb::idx_t RowsRead() const { return rows_read; }
+
+private:
+    bool EmitRow(std::string &entity);
+
+    std::vector<duckdb::LogicalType> column_types;
+    RowCallback on_row;
+    JsonArrayItemStreamer items;
+    ODataPropertyLayout layout;
+    std::vector<yyjson_val *> row_values;
+    // Holds one entity at a time, reset after every row
+    JsonArena arena;
+    duckdb::idx_t rows_read = 0;
+};
+
+// Reads an entity set page for odata_read as it is received. JsonArrayItemStreamer
+// finds the entities, each is copied into the page buffer and parsed there in situ
+// once, so the page is never held as raw body and document at the same time and
+// parsing overlaps the transfer. The content decodes like a page parsed as a whole.
+class ODataEntitySetPageReader : public HttpBodyConsumer {
+public:
+    // Without an arena the page gets one of its own
+    explicit ODataEntitySetPageReader(std::shared_ptr<JsonArena> arena = nullptr);
+
+    bool Consume(const char *data, size_t length) override;
+    void Finish() override;
+
+    // Only these properties of the entities are kept, e.g. the projected columns
+    // and expanded navigation properties of a scan. By default all are kept.
+    void KeepProperties(std::unordered_set<std::string> properties);
+
+    // The page, once it was received completely
+    std::shared_ptr<ODataEntitySetJsonContent> Content();
+    uint64_t BytesRead() const { return bytes_read; }
+
+private:
+    bool AddEntity(std::string &entity);
+
+    std::shared_ptr<JsonArena> arena;
+    JsonArrayItemStreamer items;
+    duckdb::buffer_ptr<ODataPageBuffer> page_buffer;
+    std::vector<yyjson_val *> entities;
+    uint64_t bytes_read = 0;
+    bool finished = false;
 };
 
 class ODataServiceJsonContent : public ODataServiceContent, public ODataJsonContentMixin {
 public:
-    ODataServiceJsonContent(const std::string& content);
+    ODataServiceJsonContent(std::string content);
     virtual ~ODataServiceJsonContent() = default;
 
     std::string MetadataContextUrl() override;
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace erpl_web {
+
+// Process-wide prefetch configuration, set through the erpl_odata_prefetch_* settings.
+// A depth of 0 disables prefetching and pages are fetched on demand.
+class ODataPrefetchSettings {
+public:
+    static constexpr uint64_t DEFAULT_DEPTH = 2;
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 64ULL * 1024 * 1024; // 64 MiB
+
+    static ODataPrefetchSettings& GetInstance();
+
+    void SetDepth(uint64_t value) { depth = value; }
+    uint64_t GetDepth() const { return depth; }
+    void SetMaxBytes(uint64_t value) { max_bytes = value; }
+    uint64_t GetMaxBytes() const { return max_bytes; }
+
+private:
+    ODataPrefetchSettings() = default;
+
+    std::atomic<uint64_t> depth{DEFAULT_DEPTH};
+    std::atomic<uint64_t> max_bytes{DEFAULT_MAX_BYTES};
+};
+
+// Fetches the pages of a paged response on a background thread while the
+// consumer decodes and emits the previous ones.
+//
+// The worker keeps at most `depth` pages ready and stops fetching ahead once the
+// ready pages hold `max_bytes` or more (one page is always allowed so a large
+// page never stalls the scan). The fetch function is only ever called from the
+// worker thread, so it may own all pagination state (e.g. the next link).
+template <typename TPage>
+class ODataPagePrefetcher {
+public:
+    // Fetches the next page, nullptr once there are no more pages
+    using FetchFunction = std::function<std::shared_ptr<TPage>()>;
+    // Approximate number of bytes a fetched page keeps alive
+    using SizeFunction = std::function<uint64_t(const TPage &)>;
+
+    ODataPagePrefetcher(FetchFunction fetch, SizeFunction size, uint64_t depth, uint64_t max_bytes)
+        : fetch(std::move(fetch)), size(std::move(size)), depth(depth == 0 ? 1 : depth), max_bytes(max_bytes) {
+        worker = std::thread(&ODataPagePrefetcher::Run, this);
+    }
+
+    ~ODataPagePrefetcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+        }
+        space_available.notify_all();
+        // An in-flight request is allowed to finish, its result is discarded
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    ODataPagePrefetcher(const ODataPagePrefetcher &) = delete;
+    ODataPagePrefetcher &operator=(const ODataPagePrefetcher &) = delete;
+
+    // Blocks until the next page is available. Returns nullptr at the end of the
+    // sequence and rethrows an error raised while fetching.
+    std::shared_ptr<TPage> Next() {
+        std::unique_lock<std::mutex> lock(mutex);
+        page_available.wait(lock, [this] { return !ready.empty() || finished; });
+
+        if (!ready.empty()) {
+            auto entry = std::move(ready.front());
+            ready.pop_front();
+            ready_bytes -= entry.second;
+            lock.unlock();
+            space_available.notify_all();
+            return std::move(entry.first);
+        }
+        if (error) {
+            auto pending_error = error;
+            error = nullptr;
+            std::rethrow_exception(pending_error);
+        }
+        return nullptr;
+    }
+
+    uint64_t ReadyPages() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ready.size();
+    }
+
+    uint64_t ReadyBytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ready_bytes;
+    }
+
+private:
+    bool HasSpace() const {
+        return ready.empty() || (ready.size() < depth && ready_bytes < max_bytes);
+    }
+
+    void Run() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                space_available.wait(lock, [this] { return stopped || HasSpace(); });
+                if (stopped) {
+                    return;
+                }
+            }
+
+            std::shared_ptr<TPage> page;
+            std::exception_ptr fetch_error;
+            uint64_t page_bytes = 0;
+            try {
+                page = fetch();
+                if (page) {
+                    page_bytes = size(*page);
+                }
+            } catch (...) {
+                fetch_error = std::current_exception();
+            }
+
+            bool done = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (fetch_error) {
+                    error = fetch_error;
+                    finished = true;
+                } else if (!page) {
+                    finished = true;
+                } else {
+                    ready.emplace_back(std::move(page), page_bytes);
+                    ready_bytes += page_bytes;
+                }
+                done = finished || stopped;
+            }
+            page_available.notify_all();
+            if (done) {
+                return;
+            }
+        }
+    }
+
+    FetchFunction fetch;
+    SizeFunction size;
+    const uint64_t depth;
+    const uint64_t max_bytes;
+
+    mutable std::mutex mutex;
+    std::condition_variable page_available;
+    std::condition_variable space_available;
+    std::deque<std::pair<std::shared_ptr<TPage>, uint64_t>> ready;
+    uint64_t ready_bytes = 0;
+    bool finished = false;
+    bool stopped = false;
+    std::exception_ptr error;
+
+    // Declared last so every member above is initialized before the worker starts
+    std::thread worker;
+};
+
+} // namespace erpl_web
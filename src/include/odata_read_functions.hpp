@@ -9,12 +9,16 @@
 #include <map>
 #include <memory>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <algorithm>
+#include <atomic>
+#include <optional>
 #include <unordered_map>
 
 #include "odata_client.hpp"
 #include "odata_edm.hpp"
+#include "odata_page_prefetcher.hpp"
 #include "odata_predicate_pushdown_helper.hpp"
 
 using namespace duckdb;
@@ -35,6 +39,45 @@ struct SchemaInfo {
     bool has_expand;
 };
 
+// Maps a projected expand path to a column of the output chunk
+struct ODataExpandBinding {
+    std::string expand_path;
+    // Position of the path in the expanded data schema
+    duckdb::idx_t expand_index;
+    duckdb::idx_t output_index;
+};
+
+// Options for partitioned (multi-threaded) scans. Unset values are resolved from
+// the erpl_odata_scan_* settings when the scan is initialized.
+struct ODataScanOptions {
+    static constexpr duckdb::idx_t DEFAULT_THREADS = 1;
+    static constexpr duckdb::idx_t DEFAULT_PARTITION_SIZE = 10000;
+    static constexpr bool DEFAULT_ORDERED = true;
+
+    std::optional<duckdb::idx_t> threads;
+    std::optional<duckdb::idx_t> partition_size;
+    std::optional<bool> ordered;
+
+    void ResolveDefaults(ClientContext &context);
+};
+
+// A contiguous $skip/$top range of the entity set, claimed by one worker thread
+struct ODataScanPartition {
+    duckdb::idx_t index;
+    duckdb::idx_t skip;
+    // Unset for the last partition of a scan without a user $top, it reads to the end
+    // of the entity set so rows added after $count was taken are not dropped
+    std::optional<duckdb::idx_t> top;
+    // Rows of the range according to $count, used for progress reporting
+    duckdb::idx_t expected_rows = 0;
+
+    // Ranges of partition_size rows covering count entities, narrowed by a user
+    // supplied $skip/$top. Empty when the range fits into a single partition.
+    static std::vector<ODataScanPartition> Plan(duckdb::idx_t count, std::optional<duckdb::idx_t> user_skip,
+                                                std::optional<duckdb::idx_t> user_top,
+                                                duckdb::idx_t partition_size);
+};
+
 // ============================================================================
 // Core Data Binding Class - Focused on DuckDB integration
 // ============================================================================
@@ -79,6 +122,11 @@ public:
     void UpdateUrlFromPredicatePushdown();
     void PrefetchFirstPage();
 
+    // Partitioned scan support: split the entity set into $skip/$top ranges using $count
+    ODataScanOptions &ScanOptions();
+    std::vector<ODataScanPartition> PlanPartitions();
+    duckdb::unique_ptr<ODataReadBindData> CreatePartitionReader(const ODataScanPartition &partition) const;
+
     // Progress reporting
     double GetProgressFraction() const;
 
@@ -127,13 +175,27 @@ private:
     std::map<std::string, std::string> input_parameters;
     std::string expand_clause;
     bool has_expanded_data = false;
+    ODataScanOptions scan_options;
+    // Deterministic ordering appended to partition URLs so $skip/$top ranges are stable
+    std::string partition_orderby;
     
     // State tracking
     bool first_page_cached_ = false;
-    // Tracks how many rows have been emitted so far to align expanded cache row-wise
-    size_t emitted_row_index_ = 0;
+    // Names and types of all columns, resolved on the first chunk of the scan
+    std::unique_ptr<SchemaInfo> schema_info_;
+    // Output columns decoded straight from the page JSON with their compiled
+    // decoders, the expanded ones decoded from the same page, and the ones
+    // outside the schema that stay NULL; built on the first chunk
+    std::vector<ODataColumnBinding> page_bindings_;
+    std::vector<ODataExpandBinding> page_expand_bindings_;
+    std::vector<idx_t> page_null_columns_;
+    bool page_bindings_compiled_ = false;
     bool service_root_mode_ = false;
 
+    // Background fetch of the following pages; owns the client's pagination
+    // state while running. Declared last so it is stopped before anything it uses.
+    std::unique_ptr<ODataPagePrefetcher<ODataEntitySetResponse>> page_prefetcher;
+
     // Helper methods
     void InitializeComponents(bool service_root_mode = false);
 
@@ -150,13 +212,15 @@ private:
     void EnsureInitialized();
     SchemaInfo PrepareSchemaInfo();
     void FetchAdditionalPagesIfNeeded(const SchemaInfo& schema_info);
+    void StartPagePrefetchIfNeeded();
+    std::shared_ptr<ODataEntitySetResponse> FetchNextPage();
     void ProcessPageResponse(std::shared_ptr<ODataEntitySetResponse> response, const SchemaInfo& schema_info);
     idx_t EmitRowsToOutput(duckdb::DataChunk &output, const SchemaInfo& schema_info);
     void EmitSingleRowToOutput(duckdb::DataChunk &output, const std::vector<duckdb::Value> &row, idx_t row_index, const SchemaInfo& schema_info);
+    idx_t EmitPageRowsToOutput(duckdb::DataChunk &output, idx_t output_offset, idx_t max_rows, const SchemaInfo& schema_info);
     duckdb::idx_t GetOriginalColumnIndex(idx_t activated_column_index) const;
     duckdb::Value GetColumnValue(duckdb::idx_t original_column_index, const std::vector<duckdb::Value> &row, const SchemaInfo& schema_info);
     bool IsExpandedColumn(duckdb::idx_t original_column_index, const SchemaInfo& schema_info) const;
-    duckdb::Value GetExpandedColumnValue(duckdb::idx_t original_column_index, const SchemaInfo& schema_info);
     duckdb::Value GetRegularColumnValue(duckdb::idx_t original_column_index, const std::vector<duckdb::Value> &row, const SchemaInfo& schema_info);
     void UpdateProgressTracking(idx_t rows_emitted);
 
@@ -186,8 +250,14 @@ public:
     explicit ODataDataExtractor(std::shared_ptr<ODataEntitySetClient> odata_client);
     
     // Core extraction methods
-    void ExtractExpandedDataFromResponse(const std::string& response_content);
-    duckdb::Value ExtractExpandedDataForRow(const std::string& row_id, const std::string& expand_path);
+    // Refines fallback collection types from the entities of the first page
+    void InferExpandedTypesFromPage(ODataEntitySetContent& page);
+    // Decodes the expanded data of the rows [row_offset, row_offset + row_count)
+    // of a page into the bound output columns, in the same pass and from the same
+    // document as the regular columns, so nothing outlives the page
+    void DecodeExpandedRows(ODataEntitySetContent& page, duckdb::idx_t row_offset, duckdb::idx_t row_count,
+                            const std::vector<ODataExpandBinding>& columns,
+                            duckdb::DataChunk& output, duckdb::idx_t output_offset);
     
     // Schema management
     void SetExpandedDataSchema(const std::vector<std::string>& expand_paths);
@@ -202,11 +272,8 @@ public:
     // Performance and memory management
     void SetBatchSize(size_t batch_size);
     void EnableCompression(bool enable);
-    void ClearCache();
-    size_t GetCacheSize() const;
     
-    // Error handling and validation
-    bool ValidateExpandedData(const std::string& expand_path) const;
+    // Error handling
     std::string GetLastError() const;
     void ResetErrorState();
 
@@ -228,7 +295,6 @@ private:
     
     std::vector<std::string> expanded_data_schema;
     std::vector<duckdb::LogicalType> expanded_data_types;
-    std::map<std::string, std::vector<duckdb::Value>> expanded_data_cache;
     // Top-level expanded column names (iterate columns)
     std::vector<std::string> expand_paths;
     // Full nested expand paths for recursive inference
@@ -244,10 +310,8 @@ private:
     mutable std::mutex error_mutex_;
     
     // Processing methods
-    void ProcessODataV4ExpandedData(duckdb_yyjson::yyjson_val* value_arr);
-    void ProcessODataV2ExpandedData(duckdb_yyjson::yyjson_val* results_arr);
-    void ProcessExpandedDataRows(duckdb_yyjson::yyjson_val* rows_arr, const std::string& response_format);
-    duckdb::LogicalType GetExpandedTargetType(const std::string& expand_path) const;
+    // Expanded value of an entity, unwrapping the v2 {"results": [...]} collection
+    static duckdb_yyjson::yyjson_val* ExpandPayload(duckdb_yyjson::yyjson_val* entity, const std::string& expand_path);
     duckdb::Value ParseJsonToDuckDBValue(const std::string& json_str, const duckdb::LogicalType& target_type);
     duckdb::Value ParseJsonValueToDuckDBValue(duckdb_yyjson::yyjson_val* value, const duckdb::LogicalType& target_type);
     
@@ -269,10 +333,7 @@ private:
     void LogError(const std::string& context, const std::string& error_msg) const;
     bool ShouldRetryAfterError(const std::string& context) const;
     duckdb::Value CreateFallbackValue(const duckdb::LogicalType& target_type) const;
-    
-    // Memory optimization
-    void OptimizeCacheMemory();
-    void CompressCacheData();
+
 };
 
 // ============================================================================
@@ -349,16 +410,61 @@ public:
     bool HasMoreRows() const;
     size_t Size() const;
     void Clear();
+
+    // Pre-built rows (e.g. service root listings) are emitted before page rows
+    bool HasPrebuiltRows() const;
+
+    // Parsed pages are kept as-is and decoded column-wise on emission; a cursor
+    // per page tracks how many of its rows have been emitted.
+    void AddPage(std::shared_ptr<ODataEntitySetContent> page);
+    bool HasPageRows() const;
+    // Called for every page range DecodePageRows decoded, to fill further
+    // columns from the same page before the page can be released
+    using PageRangeCallback = std::function<void(ODataEntitySetContent &page, idx_t row_offset,
+                                                 idx_t row_count, idx_t output_offset)>;
+    idx_t DecodePageRows(const std::vector<ODataColumnBinding> &columns, duckdb::DataChunk &output,
+                         idx_t output_offset, idx_t max_rows,
+                         const PageRangeCallback &on_range = nullptr);
     
     // Page management
     void SetHasNextPage(bool has_next);
     bool HasNextPage() const;
 
 private:
+    struct PageCursor {
+        std::shared_ptr<ODataEntitySetContent> content;
+        idx_t row_count = 0;
+        idx_t offset = 0;
+    };
+
     std::deque<std::vector<duckdb::Value>> row_buffer_;
+    std::deque<PageCursor> pages_;
+    size_t page_rows_remaining_ = 0;
     bool has_next_page_ = false;
 };
 
+// ============================================================================
+// Scan State - Work distribution for partitioned scans
+// ============================================================================
+struct ODataReadGlobalState : public GlobalTableFunctionState {
+    // Empty for regular (single-threaded, server-driven paging) scans
+    std::vector<ODataScanPartition> partitions;
+    std::atomic<duckdb::idx_t> next_partition{0};
+    std::atomic<duckdb::idx_t> rows_emitted{0};
+    duckdb::idx_t total_rows = 0;
+    duckdb::idx_t max_threads = 1;
+
+    bool IsPartitioned() const { return !partitions.empty(); }
+    duckdb::idx_t MaxThreads() const override { return max_threads; }
+};
+
+struct ODataReadLocalState : public LocalTableFunctionState {
+    // Reader for the partition currently claimed by this thread
+    duckdb::unique_ptr<ODataReadBindData> partition_reader;
+    // Used as batch index so DuckDB can restore the partition order
+    duckdb::idx_t partition_index = 0;
+};
+
 // ============================================================================
 // Helper Functions for ODataReadBind Modularization
 // ============================================================================
@@ -377,6 +483,8 @@ namespace ODataReadBindHelpers {
 // ============================================================================
 void ODataReadScan(ClientContext &context, TableFunctionInput &data, DataChunk &output);
 unique_ptr<GlobalTableFunctionState> ODataReadTableInitGlobalState(ClientContext &context, TableFunctionInitInput &input);
+unique_ptr<LocalTableFunctionState> ODataReadTableInitLocalState(ExecutionContext &context, TableFunctionInitInput &input, GlobalTableFunctionState *global_state);
+OperatorPartitionData ODataReadGetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input);
 unique_ptr<FunctionData> ODataReadBind(ClientContext &context, TableFunctionBindInput &input, vector<LogicalType> &return_types, vector<string> &names);
 double ODataReadTableProgress(ClientContext &, const FunctionData *func_data, const GlobalTableFunctionState *);
 TableFunctionSet CreateODataReadFunction();
@@ -37,6 +37,15 @@ public:
 
     // Normalize expand and percent-encode ONLY nested $filter values inside option sections
     static std::string normalizeAndSanitizeExpand(const std::string &expand_value);
+
+    // Read a query parameter (matches both `$key` and `%24key` spellings), value is returned as-is
+    static std::optional<std::string> getQueryParam(const HttpUrl &url, const std::string &key);
+
+    // Replace (or append) a query parameter; the value must already be encoded
+    static void setQueryParam(HttpUrl &url, const std::string &key, const std::string &value);
+
+    // Remove all occurrences of a query parameter
+    static void removeQueryParam(HttpUrl &url, const std::string &key);
 };
 
 } // namespace erpl_web
@@ -207,6 +207,10 @@ private:
     // across all pages.
     std::vector<duckdb::column_t> active_column_ids_;
 
+    // Fetches the pages behind pending_next_url_ in the background while the
+    // current page is emitted. Declared after request_orchestrator_, which it uses.
+    std::unique_ptr<ODataPagePrefetcher<OdpRequestOrchestrator::OdpRequestResult>> page_prefetcher_;
+
     // ========================================================================
     // Initialization and Setup
     // ========================================================================
@@ -272,6 +276,14 @@ private:
      */
     void FetchAndLoadNextPage();
 
+    /**
+     * @brief Start prefetching the pages following pending_next_url_.
+     *
+     * Does nothing when there is no next page or prefetching is disabled
+     * (erpl_odata_prefetch_depth = 0); pages are then fetched on demand.
+     */
+    void StartPagePrefetch();
+
     // ========================================================================
     // Error Handling and Recovery
     // ========================================================================
@@ -26,6 +26,10 @@ public:
     
     // Send request with default timeout
     std::unique_ptr<HttpResponse> SendRequest(const HttpRequest& request);
+
+    // Streams the body into the consumer on the calling thread, the consumer must not
+    // outlive a timed out request. A stalled transfer is ended by the read timeout.
+    std::unique_ptr<HttpResponse> SendStreamingRequest(const HttpRequest& request, HttpBodyConsumer& consumer);
     
     // Set default timeout
     void SetDefaultTimeout(std::chrono::milliseconds timeout);
@@ -38,5 +38,7 @@ TableFunctionSet CreateHttpPutFunction();
 TableFunctionSet CreateHttpPatchFunction();
 TableFunctionSet CreateHttpDeleteFunction();
 TableFunctionSet CreateHttpHeadFunction();
+TableFunction CreateHttpFanoutFunction();
+TableFunction CreateHttpCacheStatsFunction();
 
 } // namespace erpl_web
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "json_arena.hpp"
+#include "tracing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace duckdb_yyjson;
+
+namespace erpl_web {
+
+static constexpr size_t JSON_ARENA_ALIGNMENT = alignof(std::max_align_t);
+
+static size_t AlignJsonArenaSize(size_t size) {
+    return (size + JSON_ARENA_ALIGNMENT - 1) & ~(JSON_ARENA_ALIGNMENT - 1);
+}
+
+JsonArena::JsonArena(size_t initial_block_size) : next_block_size(std::max<size_t>(initial_block_size, 1024)) {
+    alc.malloc = Malloc;
+    alc.realloc = Realloc;
+    alc.free = Free;
+    alc.ctx = this;
+}
+
+yyjson_doc *JsonArena::Read(char *data, size_t size, yyjson_read_flag flags) {
+    document_count++;
+    return yyjson_read_opts(data, size, flags, &alc, nullptr);
+}
+
+yyjson_doc *JsonArena::Read(const char *data, size_t size) {
+    // Without YYJSON_READ_INSITU the input is copied, never written to
+    return Read(const_cast<char *>(data), size, 0);
+}
+
+void JsonArena::Reset() {
+    if (blocks.size() > 1) {
+        // The last document did not fit the first block, one block of the size
+        // all of them had together serves the next one
+        auto total = Capacity();
+        blocks.clear();
+        AddBlock(total);
+    }
+    offset = 0;
+    last_allocation = nullptr;
+}
+
+size_t JsonArena::Capacity() const {
+    size_t total = 0;
+    for (const auto &block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+void JsonArena::AddBlock(size_t min_size) {
+    auto size = std::max(next_block_size, AlignJsonArenaSize(min_size));
+    blocks.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+    next_block_size = size * 2;
+    offset = 0;
+    last_allocation = nullptr;
+    heap_allocation_count++;
+}
+
+void *JsonArena::Allocate(size_t size) {
+    size = AlignJsonArenaSize(size);
+    if (blocks.empty() || blocks.back().size - offset < size) {
+        AddBlock(size);
+    }
+    last_allocation = blocks.back().data.get() + offset;
+    offset += size;
+    return last_allocation;
+}
+
+void *JsonArena::Reallocate(void *ptr, size_t old_size, size_t size) {
+    if (!ptr) {
+        return Allocate(size);
+    }
+    // The reader grows its value buffer while it goes, as long as nothing was
+    // allocated behind that buffer it grows in place
+    if (ptr == last_allocation) {
+        auto start = static_cast<size_t>(last_allocation - blocks.back().data.get());
+        if (blocks.back().size - start >= AlignJsonArenaSize(size)) {
+            offset = start + AlignJsonArenaSize(size);
+            return ptr;
+        }
+    }
+    auto moved = Allocate(size);
+    std::memcpy(moved, ptr, std::min(old_size, size));
+    return moved;
+}
+
+void *JsonArena::Malloc(void *ctx, size_t size) {
+    auto arena = static_cast<JsonArena *>(ctx);
+    arena->request_count++;
+    return arena->Allocate(size);
+}
+
+void *JsonArena::Realloc(void *ctx, void *ptr, size_t old_size, size_t size) {
+    auto arena = static_cast<JsonArena *>(ctx);
+    arena->request_count++;
+    return arena->Reallocate(ptr, old_size, size);
+}
+
+void JsonArena::Free(void *ctx, void *ptr) {
+    // Memory goes back all at once on Reset
+}
+
+// ----------------------------------------------------------------------
+
+JsonArenaPool::~JsonArenaPool() {
+    auto stats = GetStats();
+    if (stats.documents > 0) {
+        ERPL_TRACE_DEBUG("JSON_ARENA", "Read " + std::to_string(stats.documents) + " documents through " +
+                         std::to_string(stats.arenas) + " arenas: " + std::to_string(stats.requests) +
+                         " allocations served by " + std::to_string(stats.heap_allocations) + " heap allocations");
+    }
+}
+
+std::shared_ptr<JsonArena> JsonArenaPool::Acquire() {
+    std::unique_ptr<JsonArena> arena;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idle.empty()) {
+            arena = std::move(idle.back());
+            idle.pop_back();
+        }
+    }
+    if (!arena) {
+        arena = std::make_unique<JsonArena>();
+    }
+
+    std::weak_ptr<JsonArenaPool> weak_pool = shared_from_this();
+    return std::shared_ptr<JsonArena>(arena.release(), [weak_pool](JsonArena *released) {
+        if (auto pool = weak_pool.lock()) {
+            pool->Release(released);
+        } else {
+            delete released;
+        }
+    });
+}
+
+void JsonArenaPool::Release(JsonArena *arena) {
+    arena->Reset();
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.emplace_back(arena);
+}
+
+JsonArenaPool::Stats JsonArenaPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    for (const auto &arena : idle) {
+        stats.arenas++;
+        stats.documents += arena->DocumentCount();
+        stats.requests += arena->RequestCount();
+        stats.heap_allocations += arena->HeapAllocationCount();
+    }
+    return stats;
+}
+
+} // namespace erpl_web
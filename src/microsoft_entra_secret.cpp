@@ -1,5 +1,6 @@
 #include "microsoft_entra_secret.hpp"
 #include "http_client.hpp"
+#include "http_single_flight.hpp"
 #include "tracing.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "yyjson.hpp"
@@ -107,8 +108,11 @@ static MicrosoftTokenResponse AcquireTokenWithRefreshToken(
                         "application/x-www-form-urlencoded", body);
     request.headers.emplace("Accept", "application/json");
 
-    HttpClient http;
-    auto resp = http.SendRequest(request);
+    // Concurrent binds refreshing the same token share one round-trip
+    auto resp = HttpSingleFlight::GetInstance().Do(request, [&]() -> std::shared_ptr<const HttpResponse> {
+        HttpClient http;
+        return http.SendRequest(request);
+    });
     if (!resp) {
         throw duckdb::IOException("No response from Microsoft Entra refresh token endpoint");
     }
@@ -398,8 +402,11 @@ std::string MicrosoftEntraTokenManager::AcquireTokenWithClientCredentials(
     HttpRequest request(HttpMethod::POST, token_url, "application/x-www-form-urlencoded", body);
     request.headers.emplace("Accept", "application/json");
 
-    HttpClient http;
-    auto resp = http.SendRequest(request);
+    // Concurrent binds acquiring the same token share one round-trip
+    auto resp = HttpSingleFlight::GetInstance().Do(request, [&]() -> std::shared_ptr<const HttpResponse> {
+        HttpClient http;
+        return http.SendRequest(request);
+    });
 
     if (!resp) {
         ERPL_TRACE_ERROR("MS_ENTRA_TOKEN", "No response from token endpoint");
@@ -202,6 +202,8 @@ duckdb::TableFunction ODataTableEntry::GetScanFunction(duckdb::ClientContext &co
     duckdb::TableFunction table_function("odata_table_scan", {}, ODataReadScan, ODataReadBind, ODataReadTableInitGlobalState);
     table_function.filter_pushdown = true;
     table_function.projection_pushdown = true;
+    table_function.init_local = ODataReadTableInitLocalState;
+    table_function.get_partition_data = ODataReadGetPartitionData;
     table_function.table_scan_progress = ODataReadTableProgress;
     
     return table_function;
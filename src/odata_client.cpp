@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cctype>
 #include <cpptrace/cpptrace.hpp>
 
 #include "odata_client.hpp"
@@ -9,15 +11,29 @@ namespace erpl_web {
 
 // ----------------------------------------------------------------------
 
-ODataEntitySetResponse::ODataEntitySetResponse(std::unique_ptr<HttpResponse> http_response, ODataVersion odata_version)
+ODataEntitySetResponse::ODataEntitySetResponse(std::shared_ptr<const HttpResponse> http_response, ODataVersion odata_version,
+                                               std::shared_ptr<JsonArenaPool> arena_pool)
     : ODataResponse(std::move(http_response))
     , odata_version(odata_version)
+    , arena_pool(std::move(arena_pool))
 { 
+    content_length = this->http_response ? this->http_response->content.size() : 0;
     ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Created OData entity set response");
     ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Response content type: " + ContentType());
     ERPL_TRACE_DEBUG("ODATA_RESPONSE", std::string("OData version: ") + (odata_version == ODataVersion::V2 ? "V2" : "V4"));
 }
 
+ODataEntitySetResponse::ODataEntitySetResponse(std::shared_ptr<ODataEntitySetContent> content, std::string content_type,
+                                               ODataVersion odata_version, size_t content_length)
+    : ODataResponse(nullptr)
+    , odata_version(odata_version)
+    , content_length(content_length)
+{
+    parsed_content = std::move(content);
+    released_content_type = std::move(content_type);
+    ERPL_TRACE_DEBUG("ODATA_RESPONSE", "Created OData entity set response from a streamed page");
+}
+
 std::string ODataEntitySetResponse::MetadataContextUrl()
 {
     return Content()->MetadataContextUrl();
@@ -28,6 +44,14 @@ std::optional<std::string> ODataEntitySetResponse::NextUrl()
     return Content()->NextUrl();
 }
 
+std::string ODataEntitySetResponse::RawContent() const
+{
+    if (http_response == nullptr) {
+        throw std::runtime_error("Raw content of the OData response was already released, use the parsed content");
+    }
+    return http_response->Content();
+}
+
 std::vector<std::vector<duckdb::Value>> ODataEntitySetResponse::ToRows(std::vector<std::string> &column_names, 
                                                              std::vector<duckdb::LogicalType> &column_types)
 {
@@ -138,17 +162,19 @@ std::string ODataEntitySetClient::GetMetadataContextUrl()
     return metadata_context_url;
 }
 
-std::shared_ptr<ODataEntitySetContent> ODataEntitySetResponse::CreateODataContent(const std::string& content, ODataVersion odata_version)
+std::shared_ptr<ODataEntitySetContent> ODataEntitySetResponse::CreateODataContent(std::string content, ODataVersion odata_version)
 {
     ERPL_TRACE_DEBUG("ODATA_CONTENT", "Creating OData content from response");
     ERPL_TRACE_DEBUG("ODATA_CONTENT", "Content type: " + ContentType());
     ERPL_TRACE_DEBUG("ODATA_CONTENT", "Content size: " + std::to_string(content.length()) + " bytes");
     
     if (ODataJsonContentMixin::IsJsonContentType(ContentType())) {
-        auto detected_version = ODataJsonContentMixin::DetectODataVersion(content);
+        // The version is read off the document the content parses anyway, the page is parsed once
+        auto content_obj = std::make_shared<ODataEntitySetJsonContent>(
+            std::move(content), arena_pool ? arena_pool->Acquire() : nullptr);
+        auto detected_version = content_obj->DetectedODataVersion();
         ERPL_TRACE_DEBUG("ODATA_CONTENT", std::string("Detected OData version from response: ") + (detected_version == ODataVersion::V2 ? "V2" : "V4"));
         ERPL_TRACE_DEBUG("ODATA_CONTENT", std::string("Metadata suggested version: ") + (odata_version == ODataVersion::V2 ? "V2" : "V4"));
-        auto content_obj = std::make_shared<ODataEntitySetJsonContent>(content);
         content_obj->SetODataVersion(detected_version);
         return content_obj;
     }
@@ -158,6 +184,59 @@ std::shared_ptr<ODataEntitySetContent> ODataEntitySetResponse::CreateODataConten
 }
 
 std::shared_ptr<ODataEntitySetResponse> ODataEntitySetClient::Get(bool get_next)
+{
+    return Fetch(get_next, false);
+}
+
+std::shared_ptr<ODataEntitySetResponse> ODataEntitySetClient::GetPage(bool get_next)
+{
+    return Fetch(get_next, true);
+}
+
+void ODataEntitySetClient::SetProjectedProperties(std::optional<std::unordered_set<std::string>> properties)
+{
+    projected_properties = std::move(properties);
+}
+
+std::shared_ptr<ODataEntitySetResponse> ODataEntitySetClient::DoHttpGetPage(const HttpUrl &page_url)
+{
+    auto http_request = HttpRequest(HttpMethod::GET, AddInputParametersToUrl(page_url));
+    http_request.SetODataVersion(odata_version);
+    http_request.AddODataVersionHeaders();
+    if (auth_params != nullptr) {
+        http_request.AuthHeadersFromParams(*auth_params);
+    }
+
+    // Result pages are never cached, the page goes straight from the socket into its parsed content.
+    // A body in another charset than UTF-8 is converted on the way, as Content() does for buffered responses.
+    ODataEntitySetPageReader reader(arena_pool->Acquire());
+    if (projected_properties) {
+        reader.KeepProperties(projected_properties.value());
+    }
+    HttpCharsetConsumer utf8_reader(reader);
+    auto http_response = http_client->GetHttpClient()->SendStreamingRequest(http_request, utf8_reader);
+    if (http_response->Code() != 200) {
+        std::stringstream ss;
+        ss << "Failed to get OData response: " << http_response->Code() << std::endl;
+        ss << "Content: " << std::endl << http_response->Content() << std::endl;
+        throw std::runtime_error(ss.str());
+    }
+    if (!ODataJsonContentMixin::IsJsonContentType(http_response->ContentType())) {
+        ERPL_TRACE_ERROR("ODATA_CONTENT", "Unsupported content type: " + http_response->ContentType());
+        throw std::runtime_error("Unsupported OData content type: " + http_response->ContentType());
+    }
+
+    auto content = reader.Content();
+    if (odata_version == ODataVersion::UNKNOWN) {
+        odata_version = content->GetODataVersion();
+        ERPL_TRACE_INFO("ODATA_CLIENT", std::string("Detected OData version from response: ") +
+                        (odata_version == ODataVersion::V2 ? "V2" : "V4"));
+    }
+    return std::make_shared<ODataEntitySetResponse>(std::move(content), http_response->ContentType(), odata_version,
+                                                    reader.BytesRead());
+}
+
+std::shared_ptr<ODataEntitySetResponse> ODataEntitySetClient::Fetch(bool get_next, bool stream_page)
 {
     if (! get_next && current_response != nullptr) {
         ERPL_TRACE_DEBUG("ODATA_CLIENT", "Returning cached response");
@@ -194,30 +273,35 @@ std::shared_ptr<ODataEntitySetResponse> ODataEntitySetClient::Get(bool get_next)
         ERPL_TRACE_DEBUG("ODATA_CLIENT", "Modified URL with input parameters: " + request_url.ToString());
     }
 
-    ERPL_TRACE_DEBUG("ODATA_CLIENT", "Executing HTTP GET request");
-    auto http_response = DoHttpGet(request_url);
-    
-    if (!http_response) {
-        ERPL_TRACE_ERROR("ODATA_CLIENT", "Failed to get HTTP response");
-        return nullptr;
-    }
-    
-    // Detect OData version from raw HTTP response content if not already known
-    if (odata_version == ODataVersion::UNKNOWN) {
-        auto content_str = http_response->Content();
-        if (ODataJsonContentMixin::IsJsonContentType(http_response->ContentType())) {
-            auto detected_version = ODataJsonContentMixin::DetectODataVersion(content_str);
-            odata_version = detected_version;
-            std::string version_str = (odata_version == ODataVersion::V2 ? "V2" : "V4");
-            ERPL_TRACE_INFO("ODATA_CLIENT", "Detected OData version from response: " + version_str);
-        } else {
-            ERPL_TRACE_WARN("ODATA_CLIENT", "Non-JSON content type, cannot detect OData version from response");
+    if (stream_page) {
+        ERPL_TRACE_DEBUG("ODATA_CLIENT", "Executing streamed HTTP GET request");
+        current_response = DoHttpGetPage(request_url);
+    } else {
+        ERPL_TRACE_DEBUG("ODATA_CLIENT", "Executing HTTP GET request");
+        auto http_response = DoHttpGet(request_url);
+
+        if (!http_response) {
+            ERPL_TRACE_ERROR("ODATA_CLIENT", "Failed to get HTTP response");
+            return nullptr;
         }
+
+        // Detect OData version from raw HTTP response content if not already known
+        if (odata_version == ODataVersion::UNKNOWN) {
+            auto content_str = http_response->Content();
+            if (ODataJsonContentMixin::IsJsonContentType(http_response->ContentType())) {
+                auto detected_version = ODataJsonContentMixin::DetectODataVersion(content_str);
+                odata_version = detected_version;
+                std::string version_str = (odata_version == ODataVersion::V2 ? "V2" : "V4");
+                ERPL_TRACE_INFO("ODATA_CLIENT", "Detected OData version from response: " + version_str);
+            } else {
+                ERPL_TRACE_WARN("ODATA_CLIENT", "Non-JSON content type, cannot detect OData version from response");
+            }
+        }
+
+        ERPL_TRACE_DEBUG("ODATA_CLIENT", "Creating OData response object");
+        current_response = std::make_shared<ODataEntitySetResponse>(std::move(http_response), odata_version, arena_pool);
     }
-    
-    ERPL_TRACE_DEBUG("ODATA_CLIENT", "Creating OData response object");
-    current_response = std::make_shared<ODataEntitySetResponse>(std::move(http_response), odata_version);
-    
+
     ERPL_TRACE_DEBUG("ODATA_CLIENT", "Successfully created OData response");
     
     // After getting a response, try to extract and store the metadata context URL
@@ -511,6 +595,114 @@ std::vector<duckdb::LogicalType> ODataEntitySetClient::GetResultTypes()
     return ret_types;
 }
 
+std::vector<std::string> ODataEntitySetClient::GetKeyPropertyNames()
+{
+    std::vector<std::string> key_names;
+    try {
+        auto entity_type = GetCurrentEntityType();
+        for (const auto &property_ref : entity_type.key.property_refs) {
+            key_names.push_back(property_ref.name);
+        }
+    } catch (const std::exception &e) {
+        ERPL_TRACE_WARN("ODATA_CLIENT", "Could not resolve key properties: " + std::string(e.what()));
+    }
+    return key_names;
+}
+
+std::optional<uint64_t> ODataEntitySetClient::GetCount(HttpCacheClass cache_class)
+{
+    // $count is addressed as a path segment of the entity set. Only restricting options
+    // ($filter, $search, custom parameters) apply, paging and shaping options must go.
+    HttpUrl count_url = AddInputParametersToUrl(url);
+    auto path = count_url.Path();
+    if (!path.empty() && path.back() == '/') {
+        path.pop_back();
+    }
+    count_url.Path(path + "/$count");
+    for (const auto &option : {"$top", "$skip", "$select", "$expand", "$orderby", "$format",
+                               "$count", "$inlinecount", "$skiptoken"}) {
+        ODataUrlCodec::removeQueryParam(count_url, option);
+    }
+
+    ERPL_TRACE_DEBUG("ODATA_CLIENT", "Fetching entity count from: " + count_url.ToString());
+
+    auto http_request = HttpRequest(HttpMethod::GET, count_url);
+    http_request.headers["Accept"] = "text/plain";
+    http_request.SetODataVersion(odata_version);
+    http_request.AddODataVersionHeaders();
+    if (auth_params != nullptr) {
+        http_request.AuthHeadersFromParams(*auth_params);
+    }
+
+    std::shared_ptr<const HttpResponse> http_response;
+    try {
+        http_response = http_client->SendRequest(http_request, cache_class);
+    } catch (const std::exception &e) {
+        ERPL_TRACE_WARN("ODATA_CLIENT", "$count request failed: " + std::string(e.what()));
+        return std::nullopt;
+    }
+
+    if (http_response == nullptr || http_response->Code() != 200) {
+        ERPL_TRACE_WARN("ODATA_CLIENT", "$count not supported by service (HTTP " +
+                        std::to_string(http_response ? http_response->Code() : 0) + ")");
+        return std::nullopt;
+    }
+
+    auto content = StringUtil::Replace(http_response->Content(), "\xEF\xBB\xBF", "");
+    StringUtil::Trim(content);
+    if (content.empty() || !std::all_of(content.begin(), content.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        ERPL_TRACE_WARN("ODATA_CLIENT", "Unexpected $count response: " + content.substr(0, 100));
+        return std::nullopt;
+    }
+
+    auto count = std::stoull(content);
+    ERPL_TRACE_INFO("ODATA_CLIENT", "Service reported entity count: " + std::to_string(count));
+    return count;
+}
+
+bool ODataEntitySetClient::StreamRows(const std::vector<std::string> &column_names,
+                                      const std::vector<duckdb::LogicalType> &column_types,
+                                      const ODataJsonRowReader::RowCallback &on_row,
+                                      bool get_next)
+{
+    if (odata_version == ODataVersion::UNKNOWN) {
+        DetectODataVersion();
+    }
+
+    if (get_next) {
+        if (!streamed_next_url) {
+            ERPL_TRACE_DEBUG("ODATA_CLIENT", "No next URL available for streaming pagination");
+            return false;
+        }
+        url = HttpUrl::MergeWithBaseUrlIfRelative(url, streamed_next_url.value());
+    }
+
+    auto http_request = HttpRequest(HttpMethod::GET, AddInputParametersToUrl(url));
+    http_request.SetODataVersion(odata_version);
+    http_request.AddODataVersionHeaders();
+    if (auth_params != nullptr) {
+        http_request.AuthHeadersFromParams(*auth_params);
+    }
+
+    ERPL_TRACE_INFO("ODATA_CLIENT", "Streaming OData rows from: " + http_request.url.ToString());
+
+    // Result pages are never cached, so the page can go straight from the socket to the reader
+    ODataJsonRowReader reader(column_names, column_types, on_row);
+    HttpCharsetConsumer utf8_reader(reader);
+    auto http_response = http_client->GetHttpClient()->SendStreamingRequest(http_request, utf8_reader);
+    if (http_response->Code() != 200) {
+        std::stringstream ss;
+        ss << "Failed to get OData response: " << http_response->Code() << std::endl;
+        ss << "Content: " << std::endl << http_response->Content() << std::endl;
+        throw std::runtime_error(ss.str());
+    }
+
+    streamed_next_url = reader.NextLink();
+    ERPL_TRACE_DEBUG("ODATA_CLIENT", "Streamed " + std::to_string(reader.RowsRead()) + " rows" +
+                     (streamed_next_url ? ", next page: " + streamed_next_url.value() : std::string()));
+    return true;
+}
+
 void ODataEntitySetClient::SetInputParameters(const std::map<std::string, std::string>& input_params)
 {
     input_parameters = input_params;
@@ -537,7 +729,7 @@ HttpUrl ODataEntitySetClient::AddInputParametersToUrl(const HttpUrl& url) const
 
 // ----------------------------------------------------------------------
 
-ODataServiceResponse::ODataServiceResponse(std::unique_ptr<HttpResponse> http_response, ODataVersion odata_version)
+ODataServiceResponse::ODataServiceResponse(std::shared_ptr<const HttpResponse> http_response, ODataVersion odata_version)
     : ODataResponse(std::move(http_response))
     , odata_version(odata_version)
 { 
@@ -546,11 +738,11 @@ ODataServiceResponse::ODataServiceResponse(std::unique_ptr<HttpResponse> http_re
     ERPL_TRACE_DEBUG("ODATA_RESPONSE", std::string("OData version: ") + (odata_version == ODataVersion::V2 ? "V2" : "V4"));
 }
 
-std::shared_ptr<ODataServiceContent> ODataServiceResponse::CreateODataContent(const std::string& content, ODataVersion odata_version)
+std::shared_ptr<ODataServiceContent> ODataServiceResponse::CreateODataContent(std::string content, ODataVersion odata_version)
 {
     if (ODataJsonContentMixin::IsJsonContentType(ContentType())) {
         ERPL_TRACE_DEBUG("ODATA_CONTENT", std::string("Creating JSON content with OData version: ") + (odata_version == ODataVersion::V2 ? "V2" : "V4"));
-        auto content_obj = std::make_shared<ODataServiceJsonContent>(content);
+        auto content_obj = std::make_shared<ODataServiceJsonContent>(std::move(content));
         content_obj->SetODataVersion(odata_version);
         return content_obj;
     }
@@ -584,7 +776,7 @@ std::shared_ptr<ODataServiceResponse> ODataServiceClient::Get(bool get_next)
         return current_response;
     }
 
-    auto http_response = DoHttpGet(url);
+    auto http_response = DoHttpGet(url, HttpCacheClass::SERVICE_DOCUMENT);
     current_response = std::make_shared<ODataServiceResponse>(std::move(http_response), odata_version);
 
     return current_response;
@@ -731,7 +923,8 @@ ODataClientFactory::ProbeResult ODataClientFactory::ProbeUrl(const std::string&
         http_request.AuthHeadersFromParams(*auth_params);
     }
     
-    auto http_response = http_client->SendRequest(http_request);
+    // The probe returns the first data page, it is read once and never cached
+    auto http_response = http_client->SendRequest(http_request, HttpCacheClass::NO_STORE);
     
     if (http_response == nullptr || http_response->Code() != 200) {
         std::stringstream ss;
@@ -1,16 +1,58 @@
 #include "odata_content.hpp"
 #include "tracing.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
 
 #include <cpptrace/cpptrace.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 
 namespace erpl_web {
 
 
 // ----------------------------------------------------------------------
 
-ODataJsonContentMixin::ODataJsonContentMixin(const std::string& content)
+ODataPageBuffer::ODataPageBuffer(std::string content)
+    : duckdb::VectorBuffer(duckdb::VectorBufferType::OPAQUE_BUFFER), bytes(std::move(content)), size(bytes.size())
 {
-    doc = std::shared_ptr<yyjson_doc>(yyjson_read(content.c_str(), content.size(), 0), yyjson_doc_free);
+    bytes.append(YYJSON_PADDING_SIZE, '\0');
+}
+
+ODataPageBuffer::ODataPageBuffer()
+    : duckdb::VectorBuffer(duckdb::VectorBufferType::OPAQUE_BUFFER), size(0)
+{ }
+
+char *ODataPageBuffer::Append(const char *data, size_t length)
+{
+    auto needed = length + YYJSON_PADDING_SIZE;
+    if (blocks.empty() || block_capacity - block_used < needed) {
+        block_capacity = std::max<size_t>(BLOCK_SIZE, needed);
+        blocks.push_back(std::unique_ptr<char[]>(new char[block_capacity]));
+        block_used = 0;
+    }
+    auto copy = blocks.back().get() + block_used;
+    std::memcpy(copy, data, length);
+    std::memset(copy + length, 0, YYJSON_PADDING_SIZE);
+    block_used += needed;
+    size += length;
+    return copy;
+}
+
+ODataJsonContentMixin::ODataJsonContentMixin(std::string content, std::shared_ptr<JsonArena> arena)
+{
+    // In situ, the DOM keeps no copy of the strings, they stay in the page buffer
+    page_buffer = duckdb::make_buffer<ODataPageBuffer>(std::move(content));
+    if (!arena) {
+        doc = std::shared_ptr<yyjson_doc>(
+            yyjson_read_opts(page_buffer->Data(), page_buffer->Size(), YYJSON_READ_INSITU, nullptr, nullptr),
+            yyjson_doc_free);
+        return;
+    }
+    // The document holds on to its arena, which goes back to its pool with the document
+    auto arena_doc = arena->Read(page_buffer->Data(), page_buffer->Size(), YYJSON_READ_INSITU);
+    if (arena_doc) {
+        doc = std::shared_ptr<yyjson_doc>(arena_doc, [arena](yyjson_doc *) { });
+    }
 }
 
 bool ODataJsonContentMixin::IsJsonContentType(const std::string& content_type)
@@ -35,7 +77,20 @@ ODataVersion ODataJsonContentMixin::DetectODataVersion(const std::string& conten
         return ODataVersion::V4;
     }
     
-    auto root = yyjson_doc_get_root(doc.get());
+    return DetectODataVersion(yyjson_doc_get_root(doc.get()));
+}
+
+ODataVersion ODataJsonContentMixin::DetectedODataVersion() const
+{
+    if (!doc) {
+        ERPL_TRACE_DEBUG("DETECT_VERSION", "No parsed document, defaulting to V4");
+        return ODataVersion::V4;
+    }
+    return DetectODataVersion(yyjson_doc_get_root(doc.get()));
+}
+
+ODataVersion ODataJsonContentMixin::DetectODataVersion(yyjson_val *root)
+{
     if (!root || !yyjson_is_obj(root)) {
         ERPL_TRACE_DEBUG("DETECT_VERSION", "Root is not an object, defaulting to V4");
         return ODataVersion::V4;
@@ -775,6 +830,26 @@ duckdb::Value ODataJsonContentMixin::DeserializeJsonArray(yyjson_val* json_value
     }
 }
 
+// Case-insensitive search for a key in a JSON object, for when the exact key is absent
+static yyjson_val* FindMemberCaseInsensitive(yyjson_val* json_object, const std::string& name)
+{
+    size_t it_idx, it_max;
+    yyjson_val *it_key, *it_val;
+    yyjson_obj_foreach(json_object, it_idx, it_max, it_key, it_val) {
+        if (yyjson_is_str(it_key) && yyjson_get_len(it_key) == name.size()) {
+            const char *current = yyjson_get_str(it_key);
+            bool equal = true;
+            for (size_t i = 0; i < name.size() && equal; i++) {
+                equal = std::tolower(static_cast<unsigned char>(current[i])) == std::tolower(static_cast<unsigned char>(name[i]));
+            }
+            if (equal) {
+                return it_val;
+            }
+        }
+    }
+    return nullptr;
+}
+
 duckdb::Value ODataJsonContentMixin::DeserializeJsonObject(yyjson_val* json_value, const duckdb::LogicalType& duck_type)
 {
     if (!json_value) {
@@ -794,30 +869,6 @@ duckdb::Value ODataJsonContentMixin::DeserializeJsonObject(yyjson_val* json_valu
     auto child_types = duckdb::StructType::GetChildTypes(duck_type);
     duckdb::child_list_t<duckdb::Value> struct_values;
 
-    // Helper: case-insensitive search for a key in the JSON object when exact match is missing
-    auto find_case_insensitive = [&](const std::string &target) -> yyjson_val* {
-        size_t it_idx, it_max;
-        yyjson_val *it_key, *it_val;
-        yyjson_obj_foreach(json_value, it_idx, it_max, it_key, it_val) {
-            if (yyjson_is_str(it_key)) {
-                std::string current = yyjson_get_str(it_key);
-                if (current.size() == target.size()) {
-                    bool equal = true;
-                    for (size_t i = 0; i < current.size(); i++) {
-                        if (std::tolower(current[i]) != std::tolower(target[i])) {
-                            equal = false;
-                            break;
-                        }
-                    }
-                    if (equal) {
-                        return it_val;
-                    }
-                }
-            }
-        }
-        return nullptr;
-    };
-
     // Only materialize schema-declared fields; ignore unknown properties like '__metadata' or nested nav objects
     for (const auto &child_type_pair : child_types) {
         const std::string &field_name = child_type_pair.first;
@@ -826,7 +877,7 @@ duckdb::Value ODataJsonContentMixin::DeserializeJsonObject(yyjson_val* json_valu
         yyjson_val *field_json = yyjson_obj_get(json_value, field_name.c_str());
         if (!field_json) {
             // Try case-insensitive match if exact key is absent
-            field_json = find_case_insensitive(field_name);
+            field_json = FindMemberCaseInsensitive(json_value, field_name);
         }
 
         try {
@@ -846,6 +897,420 @@ duckdb::Value ODataJsonContentMixin::DeserializeJsonObject(yyjson_val* json_valu
     return duckdb::Value::STRUCT(struct_values);
 }
 
+template <class T>
+static bool TryWriteJsonInteger(yyjson_val* json_value, duckdb::Vector& target, duckdb::idx_t row)
+{
+    T result;
+    if (yyjson_is_sint(json_value)) {
+        if (!duckdb::TryCast::Operation<int64_t, T>(yyjson_get_sint(json_value), result)) {
+            return false;
+        }
+    } else if (yyjson_is_uint(json_value)) {
+        if (!duckdb::TryCast::Operation<uint64_t, T>(yyjson_get_uint(json_value), result)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    duckdb::FlatVector::GetData<T>(target)[row] = result;
+    return true;
+}
+
+template <class T>
+static bool TryWriteJsonFloating(yyjson_val* json_value, duckdb::Vector& target, duckdb::idx_t row)
+{
+    if (!yyjson_is_num(json_value)) {
+        return false;
+    }
+    duckdb::FlatVector::GetData<T>(target)[row] = static_cast<T>(yyjson_get_num(json_value));
+    return true;
+}
+
+// ----------------------------------------------------------------------
+
+ODataColumnDecoder::ODataColumnDecoder(const duckdb::LogicalType &type) : type(type)
+{
+    using Mixin = ODataJsonContentMixin;
+    switch (type.id()) {
+        case duckdb::LogicalTypeId::BOOLEAN:
+            write = WriteBool;
+            break;
+        case duckdb::LogicalTypeId::TINYINT:
+            write = WriteInteger<int8_t, &Mixin::DeserializeJsonSignedInt8>;
+            break;
+        case duckdb::LogicalTypeId::UTINYINT:
+            write = WriteInteger<uint8_t, &Mixin::DeserializeJsonUnsignedInt8>;
+            break;
+        case duckdb::LogicalTypeId::SMALLINT:
+            write = WriteInteger<int16_t, &Mixin::DeserializeJsonSignedInt16>;
+            break;
+        case duckdb::LogicalTypeId::USMALLINT:
+            write = WriteInteger<uint16_t, &Mixin::DeserializeJsonUnsignedInt16>;
+            break;
+        case duckdb::LogicalTypeId::INTEGER:
+            write = WriteInteger<int32_t, &Mixin::DeserializeJsonSignedInt32>;
+            break;
+        case duckdb::LogicalTypeId::UINTEGER:
+            write = WriteInteger<uint32_t, &Mixin::DeserializeJsonUnsignedInt32>;
+            break;
+        case duckdb::LogicalTypeId::BIGINT:
+            write = WriteInteger<int64_t, &Mixin::DeserializeJsonSignedInt64>;
+            break;
+        case duckdb::LogicalTypeId::UBIGINT:
+            write = WriteInteger<uint64_t, &Mixin::DeserializeJsonUnsignedInt64>;
+            break;
+        case duckdb::LogicalTypeId::FLOAT:
+            write = WriteFloating<float, &Mixin::DeserializeJsonFloat>;
+            break;
+        case duckdb::LogicalTypeId::DOUBLE:
+            write = WriteFloating<double, &Mixin::DeserializeJsonDouble>;
+            break;
+        case duckdb::LogicalTypeId::VARCHAR:
+            write = WriteString;
+            break;
+        case duckdb::LogicalTypeId::DECIMAL:
+            write = WriteConvertedWithType<&Mixin::DeserializeJsonDecimal>;
+            break;
+        case duckdb::LogicalTypeId::ENUM:
+            write = WriteConvertedWithType<&Mixin::DeserializeJsonEnum>;
+            break;
+        case duckdb::LogicalTypeId::DATE:
+            write = WriteConverted<&Mixin::DeserializeJsonDate>;
+            break;
+        case duckdb::LogicalTypeId::TIME:
+            write = WriteConverted<&Mixin::DeserializeJsonTime>;
+            break;
+        case duckdb::LogicalTypeId::TIMESTAMP:
+            write = WriteConverted<&Mixin::DeserializeJsonTimestamp>;
+            break;
+        case duckdb::LogicalTypeId::STRUCT:
+            write = WriteStruct;
+            for (const auto &child : duckdb::StructType::GetChildTypes(type)) {
+                field_names.push_back(child.first);
+                children.emplace_back(child.second);
+            }
+            break;
+        case duckdb::LogicalTypeId::LIST:
+            write = WriteList;
+            children.emplace_back(duckdb::ListType::GetChildType(type));
+            break;
+        default:
+            write = WriteUnsupported;
+            break;
+    }
+}
+
+template <class T, duckdb::Value (*FALLBACK)(yyjson_val *)>
+void ODataColumnDecoder::WriteInteger(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                      duckdb::Vector &target, duckdb::idx_t row)
+{
+    // Numeric strings and out of range values take the checked conversion
+    if (!TryWriteJsonInteger<T>(json_value, target, row)) {
+        target.SetValue(row, FALLBACK(json_value));
+    }
+}
+
+template <class T, duckdb::Value (*FALLBACK)(yyjson_val *)>
+void ODataColumnDecoder::WriteFloating(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                       duckdb::Vector &target, duckdb::idx_t row)
+{
+    if (!TryWriteJsonFloating<T>(json_value, target, row)) {
+        target.SetValue(row, FALLBACK(json_value));
+    }
+}
+
+template <duckdb::Value (*CONVERT)(yyjson_val *)>
+void ODataColumnDecoder::WriteConverted(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                        duckdb::Vector &target, duckdb::idx_t row)
+{
+    target.SetValue(row, CONVERT(json_value));
+}
+
+template <duckdb::Value (*CONVERT)(yyjson_val *, const duckdb::LogicalType &)>
+void ODataColumnDecoder::WriteConvertedWithType(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                                duckdb::Vector &target, duckdb::idx_t row)
+{
+    target.SetValue(row, CONVERT(json_value, decoder.type));
+}
+
+void ODataColumnDecoder::WriteBool(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                   duckdb::Vector &target, duckdb::idx_t row)
+{
+    if (yyjson_is_bool(json_value)) {
+        duckdb::FlatVector::GetData<bool>(target)[row] = yyjson_get_bool(json_value);
+        return;
+    }
+    target.SetValue(row, ODataJsonContentMixin::DeserializeJsonBool(json_value));
+}
+
+bool ODataColumnDecoder::WriteStringReference(yyjson_val *json_value, duckdb::Vector &target, duckdb::idx_t row)
+{
+    if (!json_value || !yyjson_is_str(json_value)) {
+        return false;
+    }
+    const char* str_ptr = yyjson_get_str(json_value);
+    size_t str_len = yyjson_get_len(json_value);
+    if (str_len >= 8 && std::memcmp(str_ptr, "/Date(", 6) == 0) {
+        return false;
+    }
+    duckdb::FlatVector::GetData<duckdb::string_t>(target)[row] =
+        duckdb::string_t(str_ptr, static_cast<uint32_t>(str_len));
+    return true;
+}
+
+void ODataColumnDecoder::WriteString(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                     duckdb::Vector &target, duckdb::idx_t row)
+{
+    if (yyjson_is_str(json_value)) {
+        const char* str_ptr = yyjson_get_str(json_value);
+        size_t str_len = yyjson_get_len(json_value);
+        // Legacy OData V2 /Date(...)/ strings are normalized by DeserializeJsonString
+        if (str_len < 8 || std::memcmp(str_ptr, "/Date(", 6) != 0) {
+            duckdb::FlatVector::GetData<duckdb::string_t>(target)[row] =
+                duckdb::StringVector::AddString(target, str_ptr, str_len);
+            return;
+        }
+    }
+    target.SetValue(row, ODataJsonContentMixin::DeserializeJsonString(json_value));
+}
+
+void ODataColumnDecoder::WriteStruct(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                     duckdb::Vector &target, duckdb::idx_t row)
+{
+    if (!yyjson_is_obj(json_value)) {
+        ODataJsonContentMixin::ThrowTypeError(json_value, "object");
+    }
+
+    // Only schema-declared fields are decoded; a field that fails becomes NULL on its own
+    auto &entries = duckdb::StructVector::GetEntries(target);
+    for (size_t i = 0; i < decoder.children.size(); i++) {
+        const auto &field_name = decoder.field_names[i];
+        auto field_json = yyjson_obj_getn(json_value, field_name.c_str(), field_name.size());
+        if (!field_json) {
+            field_json = FindMemberCaseInsensitive(json_value, field_name);
+        }
+        try {
+            decoder.children[i].Write(field_json, *entries[i], row);
+        } catch (const std::exception &e) {
+            ERPL_TRACE_ERROR("ODATA_CONTENT", "Failed to deserialize object field '" + field_name + "': " + std::string(e.what()));
+            duckdb::FlatVector::SetNull(*entries[i], row, true);
+        }
+    }
+}
+
+void ODataColumnDecoder::WriteList(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                   duckdb::Vector &target, duckdb::idx_t row)
+{
+    // OData V2 expanded collections are wrapped as { "results": [ ... ] }
+    if (yyjson_is_obj(json_value)) {
+        auto results_field = yyjson_obj_get(json_value, "results");
+        if (results_field && yyjson_is_arr(results_field)) {
+            json_value = results_field;
+        }
+    }
+    if (!yyjson_is_arr(json_value)) {
+        ODataJsonContentMixin::ThrowTypeError(json_value, "array");
+    }
+
+    auto offset = duckdb::ListVector::GetListSize(target);
+    duckdb::ListVector::Reserve(target, offset + yyjson_arr_size(json_value));
+    auto &child_vector = duckdb::ListVector::GetEntry(target);
+    const auto &element = decoder.children[0];
+
+    // Elements that fail are left out, as DeserializeJsonArray does
+    duckdb::idx_t length = 0;
+    size_t idx, max;
+    yyjson_val* json_child_val;
+    yyjson_arr_foreach(json_value, idx, max, json_child_val) {
+        try {
+            element.Write(json_child_val, child_vector, offset + length);
+            length++;
+        } catch (const std::exception& e) {
+            ERPL_TRACE_ERROR("ODATA_CONTENT", "Failed to deserialize array element " + std::to_string(idx) + ": " + std::string(e.what()));
+        }
+    }
+
+    duckdb::ListVector::SetListSize(target, offset + length);
+    duckdb::FlatVector::GetData<duckdb::list_entry_t>(target)[row] = duckdb::list_entry_t(offset, length);
+}
+
+void ODataColumnDecoder::WriteUnsupported(const ODataColumnDecoder &decoder, yyjson_val *json_value,
+                                          duckdb::Vector &target, duckdb::idx_t row)
+{
+    throw duckdb::ParserException("Unsupported DuckDB type: " + decoder.type.ToString());
+}
+
+// ----------------------------------------------------------------------
+
+ODataStringDictionary::ODataStringDictionary()
+{
+    Reset();
+}
+
+void ODataStringDictionary::Reset()
+{
+    // One entry more than rows in a chunk, all rows may be distinct besides NULL
+    values = duckdb::make_uniq<duckdb::Vector>(duckdb::LogicalType::VARCHAR, STANDARD_VECTOR_SIZE + 1);
+    selection.Initialize(STANDARD_VECTOR_SIZE);
+    positions.clear();
+    duckdb::FlatVector::SetNull(*values, NULL_ENTRY, true);
+    value_count = 1;
+}
+
+duckdb::sel_t ODataStringDictionary::Insert(const char *data, duckdb::idx_t length)
+{
+    auto position = positions.find(duckdb::string_t(data, static_cast<uint32_t>(length)));
+    if (position != positions.end()) {
+        return position->second;
+    }
+    // The key points into the heap of `values`, which lives as long as the map
+    auto stored = duckdb::StringVector::AddString(*values, data, length);
+    auto entry = static_cast<duckdb::sel_t>(value_count++);
+    duckdb::FlatVector::GetData<duckdb::string_t>(*values)[entry] = stored;
+    positions.emplace(stored, entry);
+    return entry;
+}
+
+void ODataStringDictionary::Write(yyjson_val *json_value, duckdb::idx_t row)
+{
+    if (!json_value || yyjson_is_null(json_value)) {
+        SetNull(row);
+        return;
+    }
+    if (yyjson_is_str(json_value)) {
+        const char *str_ptr = yyjson_get_str(json_value);
+        size_t str_len = yyjson_get_len(json_value);
+        // Legacy OData V2 /Date(...)/ strings are normalized by DeserializeJsonString
+        if (str_len < 8 || std::memcmp(str_ptr, "/Date(", 6) != 0) {
+            selection.set_index(row, Insert(str_ptr, str_len));
+            return;
+        }
+    }
+    auto value = ODataJsonContentMixin::DeserializeJsonString(json_value);
+    if (value.IsNull()) {
+        SetNull(row);
+        return;
+    }
+    auto str = value.ToString();
+    selection.set_index(row, Insert(str.c_str(), str.size()));
+}
+
+void ODataStringDictionary::SetNull(duckdb::idx_t row)
+{
+    selection.set_index(row, NULL_ENTRY);
+}
+
+void ODataStringDictionary::Flush(duckdb::Vector &target, duckdb::idx_t count)
+{
+    if (count == 0) {
+        positions.clear();
+        value_count = 1;
+        return;
+    }
+
+    auto distinct = value_count - 1;
+    if (distinct * 2 <= count) {
+        target.Dictionary(*values, value_count, selection, count);
+        dictionary_chunks++;
+    } else {
+        // Mostly distinct: the hash lookups do not pay off, decode flat from now on
+        target.Slice(*values, selection, count);
+        target.Flatten(count);
+        enabled = false;
+        ERPL_TRACE_DEBUG("ODATA_DECODE", duckdb::StringUtil::Format(
+            "%llu distinct values in %llu rows, decoding the column without a dictionary",
+            (unsigned long long)distinct, (unsigned long long)count));
+    }
+    Reset();
+}
+
+// ----------------------------------------------------------------------
+
+ODataPropertyLayout::ODataPropertyLayout(const std::vector<std::string> &property_names)
+    : property_names(property_names)
+{
+    first_property.reserve(property_names.size());
+    for (size_t i = 0; i < property_names.size(); i++) {
+        first_property.push_back(property_by_name.emplace(property_names[i], i).first->second);
+    }
+}
+
+void ODataPropertyLayout::Resolve(yyjson_val *object, yyjson_val **values)
+{
+    std::fill(values, values + property_names.size(), nullptr);
+    if (!object || !yyjson_is_obj(object)) {
+        return;
+    }
+
+    bool lined_up = learned && yyjson_obj_size(object) == object_size;
+    if (lined_up) {
+        yyjson_obj_iter iter = yyjson_obj_iter_with(object);
+        size_t position = 0;
+        for (const auto &slot : slots) {
+            // Skipping a key jumps over its value, nested values are not walked
+            for (; position < slot.position; position++) {
+                yyjson_obj_iter_next(&iter);
+            }
+            auto key = yyjson_obj_iter_next(&iter);
+            position++;
+            const auto &name = property_names[slot.property];
+            if (!key || yyjson_get_len(key) != name.size() ||
+                std::memcmp(yyjson_get_str(key), name.data(), name.size()) != 0) {
+                lined_up = false;
+                break;
+            }
+            values[slot.property] = yyjson_obj_iter_get_val(key);
+        }
+    }
+
+    if (lined_up) {
+        positional_objects++;
+        for (auto property : absent) {
+            const auto &name = property_names[property];
+            values[property] = yyjson_obj_getn(object, name.c_str(), name.size());
+        }
+    } else {
+        std::fill(values, values + property_names.size(), nullptr);
+        Learn(object, values);
+    }
+
+    for (size_t i = 0; i < property_names.size(); i++) {
+        if (first_property[i] != i) {
+            values[i] = values[first_property[i]];
+        }
+    }
+}
+
+void ODataPropertyLayout::Learn(yyjson_val *object, yyjson_val **values)
+{
+    slots.clear();
+    absent.clear();
+    std::vector<bool> found(property_names.size(), false);
+
+    yyjson_obj_iter iter = yyjson_obj_iter_with(object);
+    yyjson_val *key;
+    for (size_t position = 0; (key = yyjson_obj_iter_next(&iter)); position++) {
+        auto it = property_by_name.find(std::string(yyjson_get_str(key), yyjson_get_len(key)));
+        if (it == property_by_name.end() || found[it->second]) {
+            continue;
+        }
+        found[it->second] = true;
+        slots.push_back({position, it->second});
+        values[it->second] = yyjson_obj_iter_get_val(key);
+    }
+    for (size_t i = 0; i < property_names.size(); i++) {
+        if (first_property[i] == i && !found[i]) {
+            absent.push_back(i);
+        }
+    }
+
+    object_size = yyjson_obj_size(object);
+    learned = true;
+    learned_objects++;
+}
+
+// ----------------------------------------------------------------------
+
 std::string ODataJsonContentMixin::MetadataContextUrl()
 {
     if (!doc) {
@@ -1101,12 +1566,22 @@ std::optional<std::string> ODataJsonContentMixin::GetNextUrl(yyjson_val* root) {
 
 // ----------------------------------------------------------------------
 
-ODataEntitySetJsonContent::ODataEntitySetJsonContent(const std::string& content)
-    : ODataJsonContentMixin(content)
+ODataEntitySetJsonContent::ODataEntitySetJsonContent(std::string content, std::shared_ptr<JsonArena> arena)
+    : ODataJsonContentMixin(std::move(content), std::move(arena))
 { 
     // Auto-detect and set OData version
-    auto detected_version = DetectODataVersion(content);
-    SetODataVersion(detected_version);
+    SetODataVersion(DetectedODataVersion());
+}
+
+ODataEntitySetJsonContent::ODataEntitySetJsonContent(duckdb::buffer_ptr<ODataPageBuffer> page_buffer,
+                                                     std::shared_ptr<yyjson_doc> envelope,
+                                                     std::vector<yyjson_val *> entities)
+    : entities(std::move(entities)), entities_indexed(true)
+{
+    this->page_buffer = std::move(page_buffer);
+    // The envelope keeps the emptied entity array, the version is detected as for a whole page
+    doc = std::move(envelope);
+    SetODataVersion(DetectedODataVersion());
 }
 
 std::string ODataEntitySetJsonContent::MetadataContextUrl()
@@ -1124,29 +1599,27 @@ std::vector<std::vector<duckdb::Value>> ODataEntitySetJsonContent::ToRows(std::v
 {
     ERPL_TRACE_DEBUG("ODATA_TO_ROWS", duckdb::StringUtil::Format("Starting ToRows with %d columns", column_names.size()));
 
-    auto root = yyjson_doc_get_root(doc.get());
-    auto json_values = GetValueArray(root);
-    if (!json_values) {
-        throw std::runtime_error("No value array found in OData response, cannot get rows.");
-    }
+    IndexEntities();
 
-    ERPL_TRACE_DEBUG("ODATA_TO_ROWS", duckdb::StringUtil::Format("Found %d rows in JSON response", yyjson_arr_size(json_values)));
+    ERPL_TRACE_DEBUG("ODATA_TO_ROWS", duckdb::StringUtil::Format("Found %d rows in JSON response", entities.size()));
 
     auto duck_rows = std::vector<std::vector<duckdb::Value>>();
-    duck_rows.reserve(yyjson_arr_size(json_values));
+    duck_rows.reserve(entities.size());
 
-    size_t i_row, max_row;
-    yyjson_val *json_row;
-    yyjson_arr_foreach(json_values, i_row, max_row, json_row) 
+    auto &row_layout = LayoutFor(column_names);
+    std::vector<yyjson_val *> row_values(column_names.size());
+
+    for (auto json_row : entities)
     {
         auto duck_row = std::vector<duckdb::Value>();
         duck_row.reserve(column_names.size());
+        row_layout.Resolve(json_row, row_values.data());
 
         for (size_t i_col = 0; i_col < column_names.size(); i_col++) {
             const auto &column_name = column_names[i_col];
             const auto &column_type = column_types[i_col];
 
-            auto json_value = yyjson_obj_get(json_row, column_name.c_str());
+            auto json_value = row_values[i_col];
             if (!json_value) {
                 duck_row.emplace_back();  // null
                 continue;
@@ -1163,10 +1636,130 @@ std::vector<std::vector<duckdb::Value>> ODataEntitySetJsonContent::ToRows(std::v
         duck_rows.push_back(std::move(duck_row));
     }
 
-    ERPL_TRACE_DEBUG("ODATA_TO_ROWS", duckdb::StringUtil::Format("Total rows processed: %d", duck_rows.size()));
+    ERPL_TRACE_DEBUG("ODATA_TO_ROWS", duckdb::StringUtil::Format("Total rows processed: %d (%llu by position, %llu key layouts learned)",
+                                                                 duck_rows.size(),
+                                                                 (unsigned long long)row_layout.PositionalObjects(),
+                                                                 (unsigned long long)row_layout.LearnedObjects()));
     return duck_rows;
 }
 
+ODataPropertyLayout &ODataEntitySetJsonContent::LayoutFor(const std::vector<std::string> &property_names)
+{
+    if (!layout || layout->PropertyNames() != property_names) {
+        layout = std::make_unique<ODataPropertyLayout>(property_names);
+    }
+    return *layout;
+}
+
+void ODataEntitySetJsonContent::IndexEntities()
+{
+    if (entities_indexed) {
+        return;
+    }
+
+    auto root = yyjson_doc_get_root(doc.get());
+    auto json_values = GetValueArray(root);
+    if (!json_values) {
+        throw std::runtime_error("No value array found in OData response, cannot get rows.");
+    }
+
+    entities.reserve(yyjson_arr_size(json_values));
+    size_t i_row, max_row;
+    yyjson_val *json_row;
+    yyjson_arr_foreach(json_values, i_row, max_row, json_row) {
+        entities.push_back(json_row);
+    }
+    entities_indexed = true;
+}
+
+yyjson_val *ODataEntitySetJsonContent::Entity(duckdb::idx_t row)
+{
+    IndexEntities();
+    return row < entities.size() ? entities[row] : nullptr;
+}
+
+duckdb::idx_t ODataEntitySetJsonContent::RowCount()
+{
+    IndexEntities();
+    return entities.size();
+}
+
+void ODataEntitySetJsonContent::DecodeRows(duckdb::idx_t row_offset, duckdb::idx_t row_count,
+                                           const std::vector<ODataColumnBinding> &columns,
+                                           duckdb::DataChunk &output, duckdb::idx_t output_offset)
+{
+    IndexEntities();
+    auto row_end = std::min<duckdb::idx_t>(entities.size(), row_offset + row_count);
+    if (row_end <= row_offset) {
+        return;
+    }
+
+    // Locate the properties row by row first, one walk over each entity's keys
+    std::vector<std::string> property_names;
+    property_names.reserve(columns.size());
+    for (const auto &column : columns) {
+        property_names.push_back(column.property_name);
+    }
+    auto &row_layout = LayoutFor(property_names);
+    const auto n_columns = columns.size();
+    std::vector<yyjson_val *> cells((row_end - row_offset) * n_columns);
+    for (duckdb::idx_t i_row = row_offset; i_row < row_end; i_row++) {
+        row_layout.Resolve(entities[i_row], cells.data() + (i_row - row_offset) * n_columns);
+    }
+
+    // Column at a time, so each target vector is written sequentially by the decoder compiled for it
+    for (duckdb::idx_t i_col = 0; i_col < n_columns; i_col++) {
+        const auto &column = columns[i_col];
+        auto &target = output.data[column.output_index];
+        auto decoder = column.decoder;
+        if (!decoder) {
+            decoder = std::make_shared<ODataColumnDecoder>(column.type);
+        }
+        // A target of another type gets the value cast by Vector::SetValue
+        const bool same_type = target.GetType() == decoder->Type();
+
+        auto dictionary = column.dictionary.get();
+        if (dictionary && dictionary->Enabled() && same_type) {
+            for (duckdb::idx_t i_row = row_offset; i_row < row_end; i_row++) {
+                auto out_row = output_offset + (i_row - row_offset);
+                try {
+                    dictionary->Write(cells[(i_row - row_offset) * n_columns + i_col], out_row);
+                } catch (const std::exception& e) {
+                    ERPL_TRACE_ERROR("ODATA_DECODE", duckdb::StringUtil::Format("Failed to deserialize %s: %s", column.property_name, e.what()));
+                    dictionary->SetNull(out_row);
+                }
+            }
+            continue;
+        }
+
+        // Strings of an in-situ page are referenced, the vector holds on to the page buffer
+        const bool reference_strings = same_type && page_buffer && decoder->Type().id() == duckdb::LogicalTypeId::VARCHAR;
+        if (reference_strings) {
+            duckdb::StringVector::AddBuffer(target, page_buffer);
+        }
+
+        for (duckdb::idx_t i_row = row_offset; i_row < row_end; i_row++) {
+            auto out_row = output_offset + (i_row - row_offset);
+            auto json_value = cells[(i_row - row_offset) * n_columns + i_col];
+            try {
+                if (reference_strings && ODataColumnDecoder::WriteStringReference(json_value, target, out_row)) {
+                    continue;
+                }
+                if (same_type) {
+                    decoder->Write(json_value, target, out_row);
+                } else if (!json_value || yyjson_is_null(json_value)) {
+                    duckdb::FlatVector::SetNull(target, out_row, true);
+                } else {
+                    target.SetValue(out_row, DeserializeJsonValue(json_value, column.type));
+                }
+            } catch (const std::exception& e) {
+                ERPL_TRACE_ERROR("ODATA_DECODE", duckdb::StringUtil::Format("Failed to deserialize %s: %s", column.property_name, e.what()));
+                duckdb::FlatVector::SetNull(target, out_row, true);
+            }
+        }
+    }
+}
+
 void ODataEntitySetJsonContent::PrettyPrint()
 {
     ODataJsonContentMixin::PrettyPrint();
@@ -1197,12 +1790,172 @@ std::optional<uint64_t> ODataEntitySetJsonContent::TotalCount()
 
 // ----------------------------------------------------------------------
 
-ODataServiceJsonContent::ODataServiceJsonContent(const std::string& content)
-    : ODataJsonContentMixin(content)
+ODataJsonRowReader::ODataJsonRowReader(const std::vector<std::string> &column_names,
+                                       const std::vector<duckdb::LogicalType> &column_types,
+                                       RowCallback on_row)
+    : column_types(column_types), on_row(std::move(on_row)),
+      items(JsonArrayItemStreamer::ODataItemPaths(), [this](std::string &entity) { return EmitRow(entity); }),
+      layout(column_names), row_values(column_names.size())
+{
+    // Unused properties never reach the entity document
+    items.KeepItemMembers(std::unordered_set<std::string>(column_names.begin(), column_names.end()));
+}
+
+bool ODataJsonRowReader::EmitRow(std::string &entity)
+{
+    // The captured entity is the only text parsed, in situ and into an arena reused for every row
+    auto length = entity.size();
+    entity.append(YYJSON_PADDING_SIZE, '\0');
+    arena.Reset();
+    auto entity_doc = arena.Read(&entity[0], length, YYJSON_READ_INSITU);
+    if (!entity_doc) {
+        throw std::runtime_error("Failed to parse entity " + std::to_string(rows_read) + " of OData response");
+    }
+    layout.Resolve(yyjson_doc_get_root(entity_doc), row_values.data());
+
+    std::vector<duckdb::Value> row;
+    row.reserve(row_values.size());
+    for (size_t i_col = 0; i_col < row_values.size(); i_col++) {
+        auto json_value = row_values[i_col];
+        if (!json_value) {
+            row.emplace_back();  // null
+            continue;
+        }
+        try {
+            row.push_back(DeserializeJsonValue(json_value, column_types[i_col]));
+        } catch (const std::exception& e) {
+            ERPL_TRACE_ERROR("ODATA_ROW_READER", duckdb::StringUtil::Format("Failed to deserialize column %d: %s", i_col, e.what()));
+            row.emplace_back();  // null on error
+        }
+    }
+
+    rows_read++;
+    return on_row(row);
+}
+
+bool ODataJsonRowReader::Consume(const char *data, size_t length)
+{
+    return items.Consume(data, length);
+}
+
+void ODataJsonRowReader::Finish()
+{
+    try {
+        items.Finish();
+    } catch (const std::exception &e) {
+        throw std::runtime_error("OData response ended after " + std::to_string(rows_read) +
+                                 " rows before the document was complete: " + e.what());
+    }
+    if (!items.FoundArray()) {
+        throw std::runtime_error("No value array found in OData response, cannot get rows.");
+    }
+    // The envelope is small, the entity array in it is empty
+    const auto &envelope = items.Envelope();
+    doc = std::shared_ptr<yyjson_doc>(yyjson_read(envelope.c_str(), envelope.size(), 0), yyjson_doc_free);
+    ERPL_TRACE_DEBUG("ODATA_ROW_READER", "Read " + std::to_string(rows_read) + " rows");
+}
+
+std::optional<std::string> ODataJsonRowReader::NextLink()
+{
+    return NextUrl();
+}
+
+std::optional<uint64_t> ODataJsonRowReader::TotalCount()
+{
+    auto root = doc ? yyjson_doc_get_root(doc.get()) : nullptr;
+    if (!root || !yyjson_is_obj(root)) {
+        return std::nullopt;
+    }
+    // A number for v4, a string inside d for v2
+    auto count = yyjson_obj_get(root, "@odata.count");
+    auto d_wrapper = yyjson_obj_get(root, "d");
+    if (!count && d_wrapper && yyjson_is_obj(d_wrapper)) {
+        count = yyjson_obj_get(d_wrapper, "__count");
+    }
+    if (count && yyjson_is_uint(count)) {
+        return yyjson_get_uint(count);
+    }
+    if (count && yyjson_is_str(count)) {
+        try {
+            return static_cast<uint64_t>(std::stoull(yyjson_get_str(count)));
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string ODataJsonRowReader::ContextUrl()
+{
+    return MetadataContextUrl();
+}
+
+// ----------------------------------------------------------------------
+
+ODataEntitySetPageReader::ODataEntitySetPageReader(std::shared_ptr<JsonArena> arena)
+    : arena(arena ? std::move(arena) : std::make_shared<JsonArena>()),
+      items(JsonArrayItemStreamer::ODataItemPaths(), [this](std::string &entity) { return AddEntity(entity); }),
+      page_buffer(duckdb::make_buffer<ODataPageBuffer>())
+{ }
+
+bool ODataEntitySetPageReader::AddEntity(std::string &entity)
+{
+    auto copy = page_buffer->Append(entity.data(), entity.size());
+    auto entity_doc = arena->Read(copy, entity.size(), YYJSON_READ_INSITU);
+    if (!entity_doc) {
+        throw std::runtime_error("Failed to parse entity " + std::to_string(entities.size()) + " of OData response");
+    }
+    entities.push_back(yyjson_doc_get_root(entity_doc));
+    return true;
+}
+
+void ODataEntitySetPageReader::KeepProperties(std::unordered_set<std::string> properties)
+{
+    items.KeepItemMembers(std::move(properties));
+}
+
+bool ODataEntitySetPageReader::Consume(const char *data, size_t length)
+{
+    bytes_read += length;
+    return items.Consume(data, length);
+}
+
+void ODataEntitySetPageReader::Finish()
+{
+    items.Finish();
+    finished = true;
+    ERPL_TRACE_DEBUG("ODATA_PAGE_READER", duckdb::StringUtil::Format("Read %llu entities from %llu bytes",
+                                                                     (unsigned long long)entities.size(),
+                                                                     (unsigned long long)bytes_read));
+}
+
+std::shared_ptr<ODataEntitySetJsonContent> ODataEntitySetPageReader::Content()
+{
+    if (!finished) {
+        throw std::runtime_error("OData page was not received completely");
+    }
+    if (!items.FoundArray()) {
+        // The envelope is the whole document, the content reports it like any page without entities
+        return std::make_shared<ODataEntitySetJsonContent>(items.Envelope(), arena);
+    }
+    // The documents live in the arena, which the envelope holds on to
+    auto page_arena = arena;
+    const auto &envelope = items.Envelope();
+    auto envelope_doc = std::shared_ptr<yyjson_doc>(arena->Read(envelope.c_str(), envelope.size()),
+                                                    [page_arena](yyjson_doc *) { });
+    if (!envelope_doc) {
+        throw std::runtime_error("Failed to parse OData response");
+    }
+    return std::make_shared<ODataEntitySetJsonContent>(page_buffer, std::move(envelope_doc), entities);
+}
+
+// ----------------------------------------------------------------------
+
+ODataServiceJsonContent::ODataServiceJsonContent(std::string content)
+    : ODataJsonContentMixin(std::move(content))
 { 
     // Auto-detect and set OData version
-    auto detected_version = DetectODataVersion(content);
-    SetODataVersion(detected_version);
+    SetODataVersion(DetectedODataVersion());
 }
 
 std::string ODataServiceJsonContent::MetadataContextUrl()
@@ -111,7 +111,6 @@ void ODataDataExtractor::SetExpandedDataSchema(
     expanded_data_schema.clear();
     expanded_data_types.clear();
     this->expand_paths.clear();
-    expanded_data_cache.clear();
     
     // Determine proper types for expanded columns using EDM metadata
     expanded_data_types.reserve(expand_paths.size());
@@ -226,138 +225,86 @@ bool ODataDataExtractor::HasExpandedData() const {
     return !expanded_data_schema.empty();
 }
 
-void ODataDataExtractor::ExtractExpandedDataFromResponse(
-    const std::string &response_content) {
-    if (!HasExpandedData() || expand_paths.empty()) {
-        return;
-    }
-    
-  ERPL_TRACE_DEBUG("DATA_EXTRACTOR",
-                   "Extracting expanded data from response of " +
-                       std::to_string(response_content.size()) + " bytes");
-    
-  JsonDocHandle doc(duckdb_yyjson::yyjson_read(response_content.c_str(),
-                                               response_content.size(), 0));
-    if (!doc) {
-    ERPL_TRACE_WARN(
-        "DATA_EXTRACTOR",
-        "Failed to parse JSON response for expanded data extraction");
-        return;
-    }
-    
-    auto root = doc.Root();
-    
-    try {
-        // Handle OData V4 format
-        auto value_arr = duckdb_yyjson::yyjson_obj_get(root, "value");
-        if (value_arr && duckdb_yyjson::yyjson_is_arr(value_arr)) {
-      ERPL_TRACE_DEBUG("DATA_EXTRACTOR",
-                       "Processing OData V4 response format for expanded data");
-            ProcessODataV4ExpandedData(value_arr);
-        } else {
-            // Handle OData V2 format
-            auto data_obj = duckdb_yyjson::yyjson_obj_get(root, "d");
-            if (data_obj && duckdb_yyjson::yyjson_is_obj(data_obj)) {
-                auto results_arr = duckdb_yyjson::yyjson_obj_get(data_obj, "results");
-                if (results_arr && duckdb_yyjson::yyjson_is_arr(results_arr)) {
-          ERPL_TRACE_DEBUG(
-              "DATA_EXTRACTOR",
-              "Processing OData V2 response format for expanded data");
-                    ProcessODataV2ExpandedData(results_arr);
-                }
-            }
-        }
-  } catch (const std::exception &e) {
-    ERPL_TRACE_WARN("DATA_EXTRACTOR",
-                    "Error processing expanded data: " + std::string(e.what()));
+void ODataDataExtractor::InferExpandedTypesFromPage(ODataEntitySetContent &page) {
+  // Collections typed LIST(VARCHAR) for lack of metadata get the struct type of
+  // the first expanded entity on the page, before the scan types are reported
+  for (size_t i = 0;
+       i < expanded_data_schema.size() && i < expanded_data_types.size(); ++i) {
+    auto &expanded_type = expanded_data_types[i];
+    if (expanded_type.id() != duckdb::LogicalTypeId::LIST ||
+        duckdb::ListType::GetChildType(expanded_type).id() !=
+            duckdb::LogicalTypeId::VARCHAR) {
+      continue;
     }
-}
-
-duckdb::Value
-ODataDataExtractor::ExtractExpandedDataForRow(const std::string &row_id,
-                                              const std::string &expand_path) {
-    auto it = expanded_data_cache.find(expand_path);
-    if (it != expanded_data_cache.end()) {
-        // Return value for this row index if available
-        try {
-            size_t row_index = static_cast<size_t>(std::stoull(row_id));
-            if (row_index < it->second.size()) {
-                return it->second[row_index];
-            }
-        } catch (...) {
-            // ignore parse errors, fall through to NULL
-        }
+    const auto &expand_path = expanded_data_schema[i];
+    for (duckdb::idx_t row = 0; row < page.RowCount(); row++) {
+      auto payload = ExpandPayload(page.Entity(row), expand_path);
+      auto first_item = payload && duckdb_yyjson::yyjson_is_arr(payload)
+                            ? duckdb_yyjson::yyjson_arr_get_first(payload)
+                            : nullptr;
+      if (first_item && duckdb_yyjson::yyjson_is_obj(first_item)) {
+        expanded_type = duckdb::LogicalType::LIST(
+            InferStructTypeFromJsonObjectWithNestedExpands(first_item,
+                                                           expand_path));
+        ERPL_TRACE_DEBUG("DATA_EXTRACTOR",
+                         "Inferred type for '" + expand_path +
+                             "' from the first page: " +
+                             expanded_type.ToString());
+        break;
+      }
     }
-    return duckdb::Value();
-}
-
-void ODataDataExtractor::ProcessODataV4ExpandedData(
-    duckdb_yyjson::yyjson_val *value_arr) {
-  ProcessExpandedDataRows(value_arr, "OData V4");
+  }
 }
 
-void ODataDataExtractor::ProcessODataV2ExpandedData(
-    duckdb_yyjson::yyjson_val *results_arr) {
-  ProcessExpandedDataRows(results_arr, "OData V2");
-}
+void ODataDataExtractor::DecodeExpandedRows(
+    ODataEntitySetContent &page, duckdb::idx_t row_offset,
+    duckdb::idx_t row_count, const std::vector<ODataExpandBinding> &columns,
+    duckdb::DataChunk &output, duckdb::idx_t output_offset) {
+  for (const auto &column : columns) {
+    for (duckdb::idx_t i = 0; i < row_count; i++) {
+      auto entity = page.Entity(row_offset + i);
+      auto expand_data =
+          entity && duckdb_yyjson::yyjson_is_obj(entity)
+              ? duckdb_yyjson::yyjson_obj_get(entity, column.expand_path.c_str())
+              : nullptr;
+      if (!expand_data) {
+        output.SetValue(column.output_index, output_offset + i, duckdb::Value());
+        continue;
+      }
 
-duckdb::LogicalType ODataDataExtractor::GetExpandedTargetType(
-    const std::string &expand_path) const {
-  for (size_t i = 0; i < expanded_data_schema.size(); ++i) {
-    if (expanded_data_schema[i] == expand_path &&
-        i < expanded_data_types.size()) {
-      return expanded_data_types[i];
+      try {
+        // Copied per value, inference may still refine the stored type mid-scan
+        auto target_type = expanded_data_types[column.expand_index];
+        output.SetValue(column.output_index, output_offset + i,
+                        ParseExpandedDataRecursively(expand_data,
+                                                     column.expand_path,
+                                                     target_type));
+      } catch (const std::exception &e) {
+        ERPL_TRACE_WARN("DATA_EXTRACTOR",
+                        "Failed to parse expand data for path '" +
+                            column.expand_path + "': " + e.what());
+        output.SetValue(column.output_index, output_offset + i, duckdb::Value());
+      }
     }
   }
-  return duckdb::LogicalTypeId::VARCHAR;
 }
 
-void ODataDataExtractor::ProcessExpandedDataRows(
-    duckdb_yyjson::yyjson_val *rows_arr, const std::string &response_format) {
-  ERPL_TRACE_INFO("DATA_EXTRACTOR",
-                  "Processing " + response_format + " expanded data with " +
-                      std::to_string(expand_paths.size()) + " expand paths");
-
-  duckdb_yyjson::yyjson_arr_iter arr_it;
-  duckdb_yyjson::yyjson_arr_iter_init(rows_arr, &arr_it);
-
-  duckdb_yyjson::yyjson_val *row;
-  size_t row_index = 0;
-  while ((row = duckdb_yyjson::yyjson_arr_iter_next(&arr_it))) {
-    if (duckdb_yyjson::yyjson_is_obj(row)) {
-      for (const auto &expand_path : expand_paths) {
-        auto expand_data =
-            duckdb_yyjson::yyjson_obj_get(row, expand_path.c_str());
-        if (!expand_data) {
-          expanded_data_cache[expand_path].push_back(duckdb::Value());
-          continue;
-        }
-
-        try {
-          auto parsed_value = ParseExpandedDataRecursively(
-              expand_data, expand_path, GetExpandedTargetType(expand_path));
-          expanded_data_cache[expand_path].push_back(parsed_value);
-          ERPL_TRACE_DEBUG("DATA_EXTRACTOR",
-                           "Extracted expanded data for path '" + expand_path +
-                               "' at row " + std::to_string(row_index));
-        } catch (const std::exception &e) {
-          ERPL_TRACE_WARN("DATA_EXTRACTOR",
-                          "Failed to parse expand data for path '" +
-                              expand_path + "': " + e.what());
-          expanded_data_cache[expand_path].push_back(duckdb::Value());
-        }
-      }
+duckdb_yyjson::yyjson_val *
+ODataDataExtractor::ExpandPayload(duckdb_yyjson::yyjson_val *entity,
+                                  const std::string &expand_path) {
+  if (!entity || !duckdb_yyjson::yyjson_is_obj(entity)) {
+    return nullptr;
+  }
+  auto expand_data = duckdb_yyjson::yyjson_obj_get(entity, expand_path.c_str());
+  if (expand_data && duckdb_yyjson::yyjson_is_obj(expand_data)) {
+    auto results_field = duckdb_yyjson::yyjson_obj_get(expand_data, "results");
+    if (results_field && duckdb_yyjson::yyjson_is_arr(results_field)) {
+      return results_field;
     }
-    row_index++;
   }
-
-  ERPL_TRACE_INFO("DATA_EXTRACTOR",
-                  "Processed " + std::to_string(row_index) + " " +
-                      response_format + " rows with expanded data");
+  return expand_data;
 }
 
-// Parse expanded data recursively, handling nested expands like
-// Products/Suppliers
 duckdb::Value ODataDataExtractor::ParseExpandedDataRecursively(
     duckdb_yyjson::yyjson_val *expand_data, const std::string &expand_path,
     const duckdb::LogicalType &target_type) {
@@ -974,25 +921,6 @@ void ODataDataExtractor::EnableCompression(bool enable) {
                        std::string(enable ? "enabled" : "disabled"));
 }
 
-void ODataDataExtractor::ClearCache() {
-    expanded_data_cache.clear();
-    ERPL_TRACE_DEBUG("DATA_EXTRACTOR", "Cleared expanded data cache");
-}
-
-size_t ODataDataExtractor::GetCacheSize() const {
-    size_t total_size = 0;
-  for (const auto &[path, values] : expanded_data_cache) {
-        total_size += values.size();
-    }
-    return total_size;
-}
-
-bool ODataDataExtractor::ValidateExpandedData(
-    const std::string &expand_path) const {
-    auto it = expanded_data_cache.find(expand_path);
-    return it != expanded_data_cache.end() && !it->second.empty();
-}
-
 std::string ODataDataExtractor::GetLastError() const {
     std::lock_guard<std::mutex> lock(error_mutex_);
     return last_error_;
@@ -1004,30 +932,6 @@ void ODataDataExtractor::ResetErrorState() {
     error_counts_.clear();
 }
 
-void ODataDataExtractor::OptimizeCacheMemory() {
-    // Remove empty cache entries
-  for (auto it = expanded_data_cache.begin();
-       it != expanded_data_cache.end();) {
-        if (it->second.empty()) {
-            it = expanded_data_cache.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
-    ERPL_TRACE_DEBUG("DATA_EXTRACTOR", "Optimized cache memory usage");
-}
-
-void ODataDataExtractor::CompressCacheData() {
-    if (!compression_enabled_) {
-        return;
-    }
-    
-    // This is a placeholder for potential compression logic
-    // In a real implementation, we could serialize and compress the data
-    ERPL_TRACE_DEBUG("DATA_EXTRACTOR", "Cache compression completed");
-}
-
 // Infer struct type from JSON object, handling nested expands
 duckdb::LogicalType
 ODataDataExtractor::InferStructTypeFromJsonObjectWithNestedExpands(
@@ -0,0 +1,10 @@
+#include "odata_page_prefetcher.hpp"
+
+namespace erpl_web {
+
+ODataPrefetchSettings& ODataPrefetchSettings::GetInstance() {
+    static ODataPrefetchSettings instance;
+    return instance;
+}
+
+} // namespace erpl_web
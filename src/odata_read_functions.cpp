@@ -191,6 +191,29 @@ void ODataProgressTracker::Reset() {
     has_total_ = false;
 }
 
+// ============================================================================
+// ODataScanOptions Implementation
+// ============================================================================
+
+void ODataScanOptions::ResolveDefaults(ClientContext &context) {
+    duckdb::Value value;
+    if (!threads.has_value()) {
+        threads = context.TryGetCurrentSetting("erpl_odata_scan_threads", value)
+                      ? (duckdb::idx_t)value.GetValue<int64_t>()
+                      : DEFAULT_THREADS;
+    }
+    if (!partition_size.has_value()) {
+        partition_size = context.TryGetCurrentSetting("erpl_odata_scan_partition_size", value)
+                             ? (duckdb::idx_t)value.GetValue<int64_t>()
+                             : DEFAULT_PARTITION_SIZE;
+    }
+    if (!ordered.has_value()) {
+        ordered = context.TryGetCurrentSetting("erpl_odata_scan_ordered", value)
+                      ? value.GetValue<bool>()
+                      : DEFAULT_ORDERED;
+    }
+}
+
 // ============================================================================
 // ODataRowBuffer Implementation
 // ============================================================================
@@ -210,11 +233,53 @@ std::vector<duckdb::Value> ODataRowBuffer::GetNextRow() {
     return row;
 }
 
-bool ODataRowBuffer::HasMoreRows() const { return !row_buffer_.empty(); }
+bool ODataRowBuffer::HasMoreRows() const { return Size() > 0; }
 
-size_t ODataRowBuffer::Size() const { return row_buffer_.size(); }
+size_t ODataRowBuffer::Size() const { return row_buffer_.size() + page_rows_remaining_; }
+
+void ODataRowBuffer::Clear() {
+    row_buffer_.clear();
+    pages_.clear();
+    page_rows_remaining_ = 0;
+}
 
-void ODataRowBuffer::Clear() { row_buffer_.clear(); }
+bool ODataRowBuffer::HasPrebuiltRows() const { return !row_buffer_.empty(); }
+
+void ODataRowBuffer::AddPage(std::shared_ptr<ODataEntitySetContent> page) {
+    if (!page) {
+        return;
+    }
+    auto row_count = page->RowCount();
+    if (row_count == 0) {
+        return;
+    }
+    pages_.push_back(PageCursor{std::move(page), row_count, 0});
+    page_rows_remaining_ += row_count;
+}
+
+bool ODataRowBuffer::HasPageRows() const { return page_rows_remaining_ > 0; }
+
+idx_t ODataRowBuffer::DecodePageRows(const std::vector<ODataColumnBinding> &columns,
+                                     duckdb::DataChunk &output, idx_t output_offset,
+                                     idx_t max_rows, const PageRangeCallback &on_range) {
+    idx_t decoded = 0;
+    while (decoded < max_rows && !pages_.empty()) {
+        auto &page = pages_.front();
+        auto count = std::min<idx_t>(page.row_count - page.offset, max_rows - decoded);
+        page.content->DecodeRows(page.offset, count, columns, output, output_offset + decoded);
+        if (on_range) {
+            on_range(*page.content, page.offset, count, output_offset + decoded);
+        }
+        page.offset += count;
+        page_rows_remaining_ -= count;
+        decoded += count;
+        // Release the parsed document as soon as its last row is emitted
+        if (page.offset >= page.row_count) {
+            pages_.pop_front();
+        }
+    }
+    return decoded;
+}
 
 void ODataRowBuffer::SetHasNextPage(bool has_next) {
     has_next_page_ = has_next;
@@ -702,7 +767,7 @@ duckdb::unique_ptr<ODataReadBindData> ODataReadBindData::FromEntitySetClient(
     // Buffer the rows from initial_content so the next FetchNextResult does
     // not issue a redundant bare GET. Without this, callers that hand a
     // pre-fetched page in (e.g. the ODP streaming path) trigger
-    // PrefetchFirstPage → odata_client->Get() with no query string, which
+    // PrefetchFirstPage → odata_client->GetPage() with no query string, which
     // SAP ODP answers with the entire dataset, inflating results N×.
     try {
       auto synthetic = std::make_shared<ODataEntitySetResponse>(
@@ -1106,8 +1171,9 @@ ODataReadBindData::GetResultTypes(bool all_columns) {
 // ============================================================================
 
 void ODataReadBindData::EnsureInitialized() {
-    // Ensure input parameters are set on client before any request
-    if (!input_parameters.empty()) {
+    // Ensure input parameters are set on client before any request. Once the
+    // prefetcher runs, the client belongs to its worker thread.
+    if (!input_parameters.empty() && !page_prefetcher) {
         odata_client->SetInputParameters(input_parameters);
     }
 
@@ -1120,7 +1186,8 @@ void ODataReadBindData::EnsureInitialized() {
 SchemaInfo ODataReadBindData::PrepareSchemaInfo() {
     SchemaInfo info;
     
-    // Always use full schema for buffering; projection is applied at emission
+    // Pages are buffered against the full schema; only the activated columns
+    // are decoded from them on emission
     info.all_result_names = GetResultNames(true);
     info.all_result_types = GetResultTypes(true);
     info.has_expand = HasExpandedData();
@@ -1136,11 +1203,14 @@ SchemaInfo ODataReadBindData::PrepareSchemaInfo() {
 
 void ODataReadBindData::FetchAdditionalPagesIfNeeded(const SchemaInfo& schema_info) {
     const idx_t target = STANDARD_VECTOR_SIZE;
+
+    // Start fetching the following pages while the buffered ones are emitted
+    StartPagePrefetchIfNeeded();
     
     // Fetch additional pages until we have enough buffered rows to fill the
     // vector or no more pages
     while (row_buffer->Size() < target && row_buffer->HasNextPage()) {
-        auto next_response = odata_client->Get(true);
+        auto next_response = FetchNextPage();
         if (!next_response) {
             row_buffer->SetHasNextPage(false);
             break;
@@ -1150,6 +1220,41 @@ void ODataReadBindData::FetchAdditionalPagesIfNeeded(const SchemaInfo& schema_in
     }
 }
 
+void ODataReadBindData::StartPagePrefetchIfNeeded() {
+    // Without a fetched page (e.g. first page handed in as initial content) there is no next link to follow
+    if (page_prefetcher || !row_buffer->HasNextPage() || !odata_client->HasResponse()) {
+        return;
+    }
+    auto &settings = ODataPrefetchSettings::GetInstance();
+    auto depth = settings.GetDepth();
+    if (depth == 0) {
+        return;
+    }
+
+    ERPL_TRACE_DEBUG("ODATA_READ_BIND",
+                     duckdb::StringUtil::Format("Starting page prefetch (depth %llu, max %llu bytes)",
+                                                (unsigned long long)depth,
+                                                (unsigned long long)settings.GetMaxBytes()));
+
+    auto client = odata_client;
+    page_prefetcher = std::make_unique<ODataPagePrefetcher<ODataEntitySetResponse>>(
+        [client]() -> std::shared_ptr<ODataEntitySetResponse> {
+            // Parsed on the worker while it is received, only vector decoding is left to the scan thread
+            return client->GetPage(true);
+        },
+        [](const ODataEntitySetResponse &response) -> uint64_t {
+            return response.ContentLength();
+        },
+        depth, settings.GetMaxBytes());
+}
+
+std::shared_ptr<ODataEntitySetResponse> ODataReadBindData::FetchNextPage() {
+    if (page_prefetcher) {
+        return page_prefetcher->Next();
+    }
+    return odata_client->GetPage(true);
+}
+
 void ODataReadBindData::ProcessPageResponse(
     std::shared_ptr<ODataEntitySetResponse> response, 
     const SchemaInfo& schema_info) {
@@ -1163,42 +1268,90 @@ void ODataReadBindData::ProcessPageResponse(
         }
     }
     
-    // Extract expanded data from subsequent pages as well
-    if (schema_info.has_expand && !data_extractor->GetExpandedDataSchema().empty()) {
-        try {
-            ERPL_TRACE_DEBUG("ODATA_READ_BIND",
-                           "Extracting expanded data from subsequent page");
-            data_extractor->ExtractExpandedDataFromResponse(response->RawContent());
-        } catch (const std::exception &e) {
-            ERPL_TRACE_WARN(
-                "ODATA_READ_BIND",
-                "Failed to extract expanded data from subsequent page: " +
-                    std::string(e.what()));
-        }
-    }
-
-    // Buffer full rows using full schema to keep indices stable
-    auto column_names = schema_info.all_result_names;
-    auto column_types = schema_info.all_result_types;
-    auto page_rows = response->ToRows(column_names, column_types);
-    const auto row_count = page_rows.size();
-    row_buffer->AddRows(std::move(page_rows));
+    // Keep the parsed page; rows and their expanded data are decoded straight
+    // into the output vectors on emission
+    auto content = response->Content();
+    const auto row_count = content->RowCount();
+    row_buffer->AddPage(content);
     row_buffer->SetHasNextPage(response->NextUrl().has_value());
+    response->ReleaseRawContent();
     progress_tracker->IncrementRowsFetched(row_count);
 }
 
 idx_t ODataReadBindData::EmitRowsToOutput(duckdb::DataChunk &output, const SchemaInfo& schema_info) {
     const idx_t target = STANDARD_VECTOR_SIZE;
-    idx_t to_emit = std::min<idx_t>(row_buffer->Size(), target);
-    
-    for (idx_t i = 0; i < to_emit; i++) {
+    idx_t emitted = 0;
+
+    // Pre-built rows (service root listing) are small and stay boxed
+    while (emitted < target && row_buffer->HasPrebuiltRows()) {
         const auto &row = row_buffer->GetNextRow();
-        EmitSingleRowToOutput(output, row, i, schema_info);
-        emitted_row_index_++;
+        EmitSingleRowToOutput(output, row, emitted, schema_info);
+        emitted++;
+    }
+
+    if (emitted < target && row_buffer->HasPageRows()) {
+        emitted += EmitPageRowsToOutput(output, emitted, target - emitted, schema_info);
     }
     
-    output.SetCardinality(to_emit);
-    return to_emit;
+    output.SetCardinality(emitted);
+    return emitted;
+}
+
+idx_t ODataReadBindData::EmitPageRowsToOutput(
+    duckdb::DataChunk &output,
+    idx_t output_offset,
+    idx_t max_rows,
+    const SchemaInfo& schema_info) {
+
+    // Regular properties are decoded from the page JSON directly into the typed
+    // vectors, expanded ones from the same entities in the same pass. The
+    // projection is fixed once the scan runs, so the bindings are built once.
+    if (!page_bindings_compiled_) {
+        const auto expand_schema = data_extractor->GetExpandedDataSchema();
+        for (idx_t j = 0; j < output.ColumnCount(); j++) {
+            duckdb::idx_t original_column_index = GetOriginalColumnIndex(j);
+            if (original_column_index >= schema_info.all_result_names.size()) {
+                page_null_columns_.push_back(j);
+            } else if (IsExpandedColumn(original_column_index, schema_info)) {
+                auto expand_index = original_column_index -
+                                    (schema_info.all_result_names.size() - expand_schema.size());
+                page_expand_bindings_.push_back({expand_schema[expand_index], expand_index, j});
+            } else {
+                const auto &type = schema_info.all_result_types[original_column_index];
+                page_bindings_.push_back({schema_info.all_result_names[original_column_index], type, j,
+                                          std::make_shared<ODataColumnDecoder>(type)});
+                // Codes, currencies, units and the like repeat on most rows
+                if (type.id() == LogicalTypeId::VARCHAR && output.data[j].GetType() == type) {
+                    page_bindings_.back().dictionary = std::make_shared<ODataStringDictionary>();
+                }
+            }
+        }
+        page_bindings_compiled_ = true;
+    }
+
+    ODataRowBuffer::PageRangeCallback decode_expanded;
+    if (!page_expand_bindings_.empty()) {
+        decode_expanded = [&](ODataEntitySetContent &page, idx_t row_offset, idx_t row_count, idx_t range_offset) {
+            data_extractor->DecodeExpandedRows(page, row_offset, row_count, page_expand_bindings_, output,
+                                               range_offset);
+        };
+    }
+    auto decoded = row_buffer->DecodePageRows(page_bindings_, output, output_offset, max_rows, decode_expanded);
+
+    // Dictionary columns hold the whole chunk, pre-built rows are never mixed with page rows
+    for (auto &binding : page_bindings_) {
+        if (binding.dictionary && binding.dictionary->Enabled()) {
+            binding.dictionary->Flush(output.data[binding.output_index], output_offset + decoded);
+        }
+    }
+
+    for (auto j : page_null_columns_) {
+        for (idx_t i = 0; i < decoded; i++) {
+            output.SetValue(j, output_offset + i, duckdb::Value());
+        }
+    }
+
+    return decoded;
 }
 
 void ODataReadBindData::EmitSingleRowToOutput(
@@ -1235,9 +1388,9 @@ duckdb::Value ODataReadBindData::GetColumnValue(
     
     auto null_value = duckdb::Value();
     
-    // Check if this original index points to an expanded column
+    // Expanded columns are decoded from the pages, pre-built rows have none
     if (IsExpandedColumn(original_column_index, schema_info)) {
-        return GetExpandedColumnValue(original_column_index, schema_info);
+        return null_value;
     } else {
         return GetRegularColumnValue(original_column_index, row, schema_info);
     }
@@ -1250,35 +1403,6 @@ bool ODataReadBindData::IsExpandedColumn(duckdb::idx_t original_column_index, co
                                    data_extractor->GetExpandedDataSchema().size());
 }
 
-duckdb::Value ODataReadBindData::GetExpandedColumnValue(
-    duckdb::idx_t original_column_index, 
-    const SchemaInfo& schema_info) {
-    
-    auto null_value = duckdb::Value();
-    
-    size_t expand_index = original_column_index - 
-                         (schema_info.all_result_names.size() - 
-                          data_extractor->GetExpandedDataSchema().size());
-    
-    if (expand_index < data_extractor->GetExpandedDataSchema().size()) {
-        std::string expand_path = data_extractor->GetExpandedDataSchema()[expand_index];
-        
-        // Use global emitted_row_index_ to align with how cache was filled (per input row)
-        auto expand_data = data_extractor->ExtractExpandedDataForRow(
-            std::to_string(emitted_row_index_), expand_path);
-        
-        if (!expand_data.IsNull()) {
-            ERPL_TRACE_DEBUG("ODATA_SCAN", duckdb::StringUtil::Format("Setting expanded data for path '%s'", expand_path.c_str()));
-            return expand_data;
-        } else {
-            ERPL_TRACE_DEBUG("ODATA_SCAN", duckdb::StringUtil::Format("Setting expanded data to NULL for path '%s'", expand_path.c_str()));
-            return null_value;
-        }
-    }
-    
-    return null_value;
-}
-
 duckdb::Value ODataReadBindData::GetRegularColumnValue(
     duckdb::idx_t original_column_index,
     const std::vector<duckdb::Value> &row,
@@ -1318,7 +1442,10 @@ void ODataReadBindData::UpdateProgressTracking(idx_t rows_emitted) {
 unsigned int ODataReadBindData::FetchNextResult(duckdb::DataChunk &output) {
     EnsureInitialized();
     
-    auto schema_info = PrepareSchemaInfo();
+    if (!schema_info_) {
+        schema_info_ = std::make_unique<SchemaInfo>(PrepareSchemaInfo());
+    }
+    const auto &schema_info = *schema_info_;
     FetchAdditionalPagesIfNeeded(schema_info);
     
     idx_t rows_emitted = EmitRowsToOutput(output, schema_info);
@@ -1387,6 +1514,18 @@ void ODataReadBindData::ActivateColumns(
                      duckdb::StringUtil::Format(
                          "Select clause: %s",
                          PredicatePushdownHelper()->SelectClause().c_str()));
+
+    // Pages received from now on keep only the properties the scan reads,
+    // expanded columns are named after their navigation property. Whatever a
+    // server sends despite $select is skipped while the page is streamed.
+    auto names = GetResultNames(true);
+    std::unordered_set<std::string> projected_properties;
+    for (auto column_id : visible_ids) {
+      if (column_id < names.size()) {
+        projected_properties.insert(names[column_id]);
+      }
+    }
+    odata_client->SetProjectedProperties(std::move(projected_properties));
   } else {
     ERPL_TRACE_DEBUG(
         "ODATA_READ_BIND",
@@ -1482,6 +1621,7 @@ void ODataReadBindData::UpdateUrlFromPredicatePushdown() {
     ERPL_TRACE_INFO("ODATA_READ_BIND",
                     "Final URL changed after predicate pushdown; discarding "
                     "prefetched buffer and caches");
+        page_prefetcher.reset();
         if (row_buffer) {
             row_buffer->Clear();
             row_buffer->SetHasNextPage(false);
@@ -1489,10 +1629,6 @@ void ODataReadBindData::UpdateUrlFromPredicatePushdown() {
         if (progress_tracker) {
             progress_tracker->Reset();
         }
-        if (data_extractor) {
-            data_extractor->ClearCache();
-        }
-        emitted_row_index_ = 0;
         first_page_cached_ = false;
     }
 }
@@ -1583,6 +1719,147 @@ double ODataReadBindData::GetProgressFraction() const {
     return progress_tracker->GetProgressFraction();
 }
 
+ODataScanOptions &ODataReadBindData::ScanOptions() { return scan_options; }
+
+std::vector<ODataScanPartition> ODataReadBindData::PlanPartitions() {
+    std::vector<ODataScanPartition> partitions;
+
+    auto threads = scan_options.threads.value_or(ODataScanOptions::DEFAULT_THREADS);
+    if (threads <= 1 || service_root_mode_) {
+        return partitions;
+    }
+    // Expanded data is aligned to the emitted row index of a single reader
+    if (HasExpandedData()) {
+        ERPL_TRACE_INFO("ODATA_READ_BIND", "Partitioned scan disabled: $expand is not supported");
+        return partitions;
+    }
+
+    if (!input_parameters.empty()) {
+        odata_client->SetInputParameters(input_parameters);
+    }
+
+    HttpUrl current_url(odata_client->Url());
+    if (ODataUrlCodec::getQueryParam(current_url, "$skiptoken").has_value()) {
+        ERPL_TRACE_INFO("ODATA_READ_BIND", "Partitioned scan disabled: URL carries a $skiptoken");
+        return partitions;
+    }
+
+    // Planned on a current count, a cached one may be stale
+    auto count = odata_client->GetCount(HttpCacheClass::NO_STORE);
+    if (!count.has_value()) {
+        ERPL_TRACE_INFO("ODATA_READ_BIND", "Partitioned scan disabled: service does not support $count");
+        return partitions;
+    }
+
+    // $count ignores $skip/$top, so intersect the count with a user supplied range
+    auto parse_option = [&](const std::string &key) -> std::optional<duckdb::idx_t> {
+        auto raw = ODataUrlCodec::getQueryParam(current_url, key);
+        if (!raw.has_value() || raw->empty()) {
+            return std::nullopt;
+        }
+        try {
+            return (duckdb::idx_t)std::stoull(*raw);
+        } catch (...) {
+            return std::nullopt;
+        }
+    };
+    auto partition_size = scan_options.partition_size.value_or(ODataScanOptions::DEFAULT_PARTITION_SIZE);
+    partitions = ODataScanPartition::Plan(count.value(), parse_option("$skip"), parse_option("$top"), partition_size);
+    if (partitions.empty()) {
+        return partitions;
+    }
+
+    // Resolve the schema once so partition readers never touch metadata themselves
+    GetResultNames(true);
+    GetResultTypes(true);
+
+    partition_orderby.clear();
+    if (scan_options.ordered.value_or(ODataScanOptions::DEFAULT_ORDERED) &&
+        !ODataUrlCodec::getQueryParam(current_url, "$orderby").has_value()) {
+        auto keys = odata_client->GetKeyPropertyNames();
+        partition_orderby = duckdb::StringUtil::Join(keys, ",");
+    }
+
+    ERPL_TRACE_INFO("ODATA_READ_BIND",
+                    duckdb::StringUtil::Format("Planned %llu partitions of up to %llu rows for %llu counted rows (orderby: '%s')",
+                                               (unsigned long long)partitions.size(),
+                                               (unsigned long long)partition_size,
+                                               (unsigned long long)count.value(),
+                                               partition_orderby.c_str()));
+    return partitions;
+}
+
+std::vector<ODataScanPartition> ODataScanPartition::Plan(duckdb::idx_t count, std::optional<duckdb::idx_t> user_skip,
+                                                         std::optional<duckdb::idx_t> user_top,
+                                                         duckdb::idx_t partition_size) {
+    std::vector<ODataScanPartition> partitions;
+
+    // $count ignores $skip/$top, so intersect the count with a user supplied range
+    duckdb::idx_t begin = user_skip.value_or(0);
+    duckdb::idx_t end = count;
+    if (user_top.has_value()) {
+        end = std::min<duckdb::idx_t>(end, begin + user_top.value());
+    }
+    if (end <= begin) {
+        return partitions;
+    }
+
+    partition_size = std::max<duckdb::idx_t>(1, partition_size);
+    auto partition_count = (end - begin + partition_size - 1) / partition_size;
+    if (partition_count < 2) {
+        return partitions;
+    }
+
+    partitions.reserve(partition_count);
+    for (duckdb::idx_t i = 0; i < partition_count; i++) {
+        ODataScanPartition partition;
+        partition.index = i;
+        partition.skip = begin + i * partition_size;
+        partition.expected_rows = std::min<duckdb::idx_t>(partition_size, end - partition.skip);
+        if (i + 1 < partition_count) {
+            partition.top = partition_size;
+        } else if (user_top.has_value()) {
+            partition.top = end - partition.skip;
+        }
+        partitions.push_back(partition);
+    }
+    return partitions;
+}
+
+duckdb::unique_ptr<ODataReadBindData>
+ODataReadBindData::CreatePartitionReader(const ODataScanPartition &partition) const {
+    HttpUrl partition_url(odata_client->Url());
+    ODataUrlCodec::setQueryParam(partition_url, "$skip", std::to_string(partition.skip));
+    if (partition.top.has_value()) {
+        ODataUrlCodec::setQueryParam(partition_url, "$top", std::to_string(partition.top.value()));
+    } else {
+        ODataUrlCodec::removeQueryParam(partition_url, "$top");
+    }
+    if (!partition_orderby.empty()) {
+        ODataUrlCodec::setQueryParam(partition_url, "$orderby", partition_orderby);
+    }
+
+    ERPL_TRACE_DEBUG("ODATA_READ_BIND",
+                     duckdb::StringUtil::Format("Creating reader for partition %llu: %s",
+                                                (unsigned long long)partition.index,
+                                                partition_url.ToString().c_str()));
+
+    auto client = std::make_shared<ODataEntitySetClient>(odata_client->GetHttpClient(), partition_url,
+                                                         odata_client->AuthParams());
+    client->SetODataVersionDirectly(odata_client->GetODataVersion());
+    client->SetProjectedProperties(odata_client->ProjectedProperties());
+
+    auto reader = duckdb::make_uniq<ODataReadBindData>(client, true);
+    reader->InitializeComponents(false);
+    reader->all_result_names = all_result_names;
+    reader->all_result_types = all_result_types;
+    reader->extracted_column_names = extracted_column_names;
+    reader->active_column_ids = active_column_ids;
+    reader->activated_to_original_mapping = activated_to_original_mapping;
+    reader->input_parameters = input_parameters;
+    return reader;
+}
+
 void ODataReadBindData::PrefetchFirstPage() {
   ERPL_TRACE_DEBUG("ODATA_READ_BIND",
                    std::string("PrefetchFirstPage: service_root_mode_ = ") +
@@ -1607,7 +1884,7 @@ void ODataReadBindData::PrefetchFirstPage() {
         odata_client->SetInputParameters(input_parameters);
     }
 
-    auto response = odata_client->Get();
+    auto response = odata_client->GetPage();
     BufferFirstPageFromResponse(response);
 
   ERPL_TRACE_DEBUG("ODATA_READ_BIND",
@@ -1627,15 +1904,14 @@ void ODataReadBindData::BufferFirstPageFromResponse(
         return;
     }
 
-    // Extract expanded data if we have expand clauses
+    // Expanded values are decoded on emission, only their types are settled here
+    // so the result types below already carry the inferred structs
     if (HasExpandedData() && !data_extractor->GetExpandedDataSchema().empty()) {
         try {
-            ERPL_TRACE_DEBUG("ODATA_READ_BIND",
-                             "Extracting expanded data from buffered first page");
-            data_extractor->ExtractExpandedDataFromResponse(response->RawContent());
+            data_extractor->InferExpandedTypesFromPage(*response->Content());
         } catch (const std::exception &e) {
             ERPL_TRACE_WARN("ODATA_READ_BIND",
-                            std::string("Failed to extract expanded data from "
+                            std::string("Failed to infer expanded types from "
                                         "buffered first page: ") +
                                 e.what());
         }
@@ -1654,13 +1930,14 @@ void ODataReadBindData::BufferFirstPageFromResponse(
         }
     }
 
-    // Buffer full schema rows to keep indices stable across projections
-    auto all_result_names_local = GetResultNames(true);
-    auto all_result_types_local = GetResultTypes(true);
+    // Resolve the full schema before buffering so emission never has to fetch metadata
+    GetResultNames(true);
+    GetResultTypes(true);
 
-    auto page_rows = response->ToRows(all_result_names_local, all_result_types_local);
-    row_buffer->AddRows(std::move(page_rows));
+    row_buffer->AddPage(response->Content());
     row_buffer->SetHasNextPage(response->NextUrl().has_value());
+    // Rows, links, counts and $expand all read the parsed page from here on
+    response->ReleaseRawContent();
     first_page_cached_ = true;
 }
 
@@ -1933,6 +2210,24 @@ void ProcessNamedParameters(ODataReadBindData *bind_data,
     ProcessExpandClause(bind_data, expand_value);
   }
 
+  // Handle partitioned scan parameters
+  if (input.named_parameters.find("threads") != input.named_parameters.end()) {
+    bind_data->ScanOptions().threads =
+        input.named_parameters["threads"].GetValue<duckdb::idx_t>();
+  }
+  if (input.named_parameters.find("partition_size") != input.named_parameters.end()) {
+    auto partition_size =
+        input.named_parameters["partition_size"].GetValue<duckdb::idx_t>();
+    if (partition_size == 0) {
+      throw duckdb::BinderException("odata_read: partition_size must be greater than 0");
+    }
+    bind_data->ScanOptions().partition_size = partition_size;
+  }
+  if (input.named_parameters.find("ordered") != input.named_parameters.end()) {
+    bind_data->ScanOptions().ordered =
+        input.named_parameters["ordered"].GetValue<bool>();
+  }
+
   // Handle COUNT parameter
   if (input.named_parameters.find("count") != input.named_parameters.end()) {
       auto count_value =
@@ -2101,24 +2396,107 @@ ODataReadTableInitGlobalState(ClientContext &context,
     bind_data.AddFilters(input.filters);
     
     bind_data.UpdateUrlFromPredicatePushdown();
+
+    auto global_state = duckdb::make_uniq<ODataReadGlobalState>();
+
+  // With $count support and more than one thread configured, split the entity
+  // set into $skip/$top ranges that worker threads claim one after another
+    bind_data.ScanOptions().ResolveDefaults(context);
+    global_state->partitions = bind_data.PlanPartitions();
+    if (global_state->IsPartitioned()) {
+        for (const auto &partition : global_state->partitions) {
+            global_state->total_rows += partition.expected_rows;
+        }
+        global_state->max_threads = std::min<idx_t>(
+            bind_data.ScanOptions().threads.value_or(ODataScanOptions::DEFAULT_THREADS),
+            global_state->partitions.size());
+        ERPL_TRACE_INFO("ODATA_SCAN",
+                        duckdb::StringUtil::Format("Partitioned scan: %llu partitions, %llu threads",
+                                                   (unsigned long long)global_state->partitions.size(),
+                                                   (unsigned long long)global_state->max_threads));
+        return std::move(global_state);
+    }
+
   // Prefetch first page after URL is finalized so progress can show early and
   // tiny scans return immediately
     bind_data.PrefetchFirstPage();
 
-    return duckdb::make_uniq<GlobalTableFunctionState>();
+    return std::move(global_state);
+}
+
+unique_ptr<LocalTableFunctionState>
+ODataReadTableInitLocalState(ExecutionContext &context,
+                             TableFunctionInitInput &input,
+                             GlobalTableFunctionState *global_state) {
+    return duckdb::make_uniq<ODataReadLocalState>();
+}
+
+OperatorPartitionData ODataReadGetPartitionData(ClientContext &context,
+                                                TableFunctionGetPartitionInput &input) {
+    auto &local_state = input.local_state->Cast<ODataReadLocalState>();
+    return OperatorPartitionData(local_state.partition_index);
 }
 
 double ODataReadTableProgress(ClientContext &, const FunctionData *func_data,
-                              const GlobalTableFunctionState *) {
+                              const GlobalTableFunctionState *gstate) {
+    auto global_state = dynamic_cast<const ODataReadGlobalState *>(gstate);
+    if (global_state && global_state->IsPartitioned()) {
+        if (global_state->total_rows == 0) {
+            return -1.0;
+        }
+        double progress = 100.0 * (double)global_state->rows_emitted.load() /
+                          (double)global_state->total_rows;
+        return std::min(100.0, progress);
+    }
     auto &bind_data = func_data->CastNoConst<ODataReadBindData>();
     return bind_data.GetProgressFraction();
 }
 
+static void ODataReadPartitionedScan(ODataReadBindData &bind_data,
+                                     ODataReadGlobalState &global_state,
+                                     ODataReadLocalState &local_state,
+                                     DataChunk &output) {
+    while (true) {
+        if (local_state.partition_reader &&
+            local_state.partition_reader->HasMoreResults()) {
+            auto rows_fetched = local_state.partition_reader->FetchNextResult(output);
+            if (rows_fetched > 0) {
+                global_state.rows_emitted += rows_fetched;
+                return;
+            }
+            continue;
+        }
+
+        auto partition_index = global_state.next_partition.fetch_add(1);
+        if (partition_index >= global_state.partitions.size()) {
+            local_state.partition_reader.reset();
+            output.SetCardinality(0);
+            return;
+        }
+
+        ERPL_TRACE_DEBUG("ODATA_SCAN",
+                         duckdb::StringUtil::Format("Claimed partition %llu of %llu",
+                                                    (unsigned long long)partition_index,
+                                                    (unsigned long long)global_state.partitions.size()));
+        local_state.partition_index = partition_index;
+        local_state.partition_reader =
+            bind_data.CreatePartitionReader(global_state.partitions[partition_index]);
+    }
+}
+
 void ODataReadScan(ClientContext &context, TableFunctionInput &data,
                    DataChunk &output) {
     auto &bind_data = data.bind_data->CastNoConst<ODataReadBindData>();
     
     ERPL_TRACE_DEBUG("ODATA_SCAN", "Starting OData scan operation");
+
+    // Functions with their own init (e.g. datasphere_read) use a plain global state
+    auto global_state = dynamic_cast<ODataReadGlobalState *>(data.global_state.get());
+    if (global_state && global_state->IsPartitioned() && data.local_state) {
+        ODataReadPartitionedScan(bind_data, *global_state,
+                                 data.local_state->Cast<ODataReadLocalState>(), output);
+        return;
+    }
     
   if (!bind_data.HasMoreResults()) {
         ERPL_TRACE_DEBUG("ODATA_SCAN", "No more results available");
@@ -2137,6 +2515,8 @@ TableFunctionSet CreateODataReadFunction() {
     TableFunction read_entity_set({LogicalTypeId::VARCHAR}, ODataReadScan, ODataReadBind, ODataReadTableInitGlobalState);
     read_entity_set.filter_pushdown = true;
     read_entity_set.projection_pushdown = true;
+    read_entity_set.init_local = ODataReadTableInitLocalState;
+    read_entity_set.get_partition_data = ODataReadGetPartitionData;
     read_entity_set.table_scan_progress = ODataReadTableProgress;
     
     // Add named parameters for TOP, SKIP, EXPAND, and COUNT
@@ -2145,6 +2525,11 @@ TableFunctionSet CreateODataReadFunction() {
     read_entity_set.named_parameters["expand"] = LogicalTypeId::VARCHAR;
     read_entity_set.named_parameters["count"] = LogicalTypeId::BOOLEAN;
 
+    // Partitioned scan: number of threads, rows per $skip/$top range, stable ordering
+    read_entity_set.named_parameters["threads"] = LogicalTypeId::UBIGINT;
+    read_entity_set.named_parameters["partition_size"] = LogicalTypeId::UBIGINT;
+    read_entity_set.named_parameters["ordered"] = LogicalTypeId::BOOLEAN;
+
     function_set.AddFunction(read_entity_set);
     return function_set;
 }
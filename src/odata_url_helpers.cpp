@@ -1,5 +1,6 @@
 #include "odata_url_helpers.hpp"
 #include <sstream>
+#include <vector>
 
 namespace erpl_web {
 
@@ -180,6 +181,66 @@ void ODataUrlCodec::ensureJsonFormat(HttpUrl &url) {
     }
 }
 
+static inline bool query_key_matches(const std::string &raw_key, const std::string &key) {
+    if (raw_key == key) return true;
+    if (!key.empty() && key[0] == '$') {
+        return raw_key == "%24" + key.substr(1);
+    }
+    return false;
+}
+
+static inline std::vector<std::string> split_query(const std::string &query) {
+    std::vector<std::string> parts;
+    std::string q = query;
+    if (!q.empty() && q[0] == '?') q = q.substr(1);
+    std::istringstream iss(q);
+    std::string kv;
+    while (std::getline(iss, kv, '&')) {
+        if (!kv.empty()) parts.push_back(kv);
+    }
+    return parts;
+}
+
+static inline std::string join_query(const std::vector<std::string> &parts) {
+    if (parts.empty()) return "";
+    std::string out = "?";
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (i > 0) out += "&";
+        out += parts[i];
+    }
+    return out;
+}
+
+std::optional<std::string> ODataUrlCodec::getQueryParam(const HttpUrl &url, const std::string &key) {
+    for (const auto &kv : split_query(url.Query())) {
+        auto pos = kv.find('=');
+        std::string raw_key = pos == std::string::npos ? kv : kv.substr(0, pos);
+        if (query_key_matches(raw_key, key)) {
+            return pos == std::string::npos ? std::string() : kv.substr(pos + 1);
+        }
+    }
+    return std::nullopt;
+}
+
+void ODataUrlCodec::setQueryParam(HttpUrl &url, const std::string &key, const std::string &value) {
+    removeQueryParam(url, key);
+    auto parts = split_query(url.Query());
+    parts.push_back(key + "=" + value);
+    url.Query(join_query(parts));
+}
+
+void ODataUrlCodec::removeQueryParam(HttpUrl &url, const std::string &key) {
+    std::vector<std::string> kept;
+    for (const auto &kv : split_query(url.Query())) {
+        auto pos = kv.find('=');
+        std::string raw_key = pos == std::string::npos ? kv : kv.substr(0, pos);
+        if (!query_key_matches(raw_key, key)) {
+            kept.push_back(kv);
+        }
+    }
+    url.Query(join_query(kept));
+}
+
 std::string ODataUrlCodec::encodeFilterExpression(const std::string &filter_expr) {
     // Percent-encode all characters except RFC 3986 unreserved characters.
     // This ensures spaces (%20), single quotes (%27), semicolons (%3B), and other
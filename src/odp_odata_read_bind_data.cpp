@@ -95,6 +95,7 @@ unsigned int OdpODataReadBindData::FetchNextResult(duckdb::DataChunk &output) {
             }
             
             first_fetch_completed_ = true;
+            StartPagePrefetch();
         }
         
         // Drain current page; if exhausted and a next page URL is pending, load it.
@@ -171,6 +172,7 @@ void OdpODataReadBindData::ForceInitialLoad() {
 
     state_manager_->TransitionToInitialLoad();
     first_fetch_completed_         = false;
+    page_prefetcher_.reset();
     pending_next_url_              = "";
     initial_load_in_progress_      = false;
     delta_fetch_in_progress_       = false;
@@ -544,10 +546,23 @@ void OdpODataReadBindData::FetchAndLoadNextPage() {
     const std::string url_to_fetch = pending_next_url_;
     ERPL_TRACE_INFO("ODP_BIND_DATA", "Fetching next ODP page: " + url_to_fetch);
 
-    auto next_result = request_orchestrator_->ExecuteNextPage(url_to_fetch);
+    OdpRequestOrchestrator::OdpRequestResult next_result;
+    if (!page_prefetcher_) {
+        StartPagePrefetch();
+    }
+    if (page_prefetcher_) {
+        // The prefetcher follows the same __next chain, so its next page is url_to_fetch
+        auto prefetched = page_prefetcher_->Next();
+        if (prefetched) {
+            next_result = *prefetched;
+        }
+    } else {
+        next_result = request_orchestrator_->ExecuteNextPage(url_to_fetch);
+    }
     if (!next_result.response) {
         ERPL_TRACE_WARN("ODP_BIND_DATA", "Next page request returned no response — stopping pagination");
         pending_next_url_ = "";
+        page_prefetcher_.reset();
         return;
     }
 
@@ -555,6 +570,9 @@ void OdpODataReadBindData::FetchAndLoadNextPage() {
     auto further_next = next_result.response->NextUrl();
     pending_next_url_ = (further_next.has_value() && !further_next->empty())
         ? further_next.value() : "";
+    if (pending_next_url_.empty()) {
+        page_prefetcher_.reset();
+    }
 
     // When this is the last page, perform the state transition that was deferred
     // in HandleInitialLoad / HandleDeltaFetch.
@@ -605,4 +623,34 @@ void OdpODataReadBindData::FetchAndLoadNextPage() {
         : "Intermediate ODP page loaded — more pages pending");
 }
 
+void OdpODataReadBindData::StartPagePrefetch() {
+    auto &settings = ODataPrefetchSettings::GetInstance();
+    if (page_prefetcher_ || pending_next_url_.empty() || settings.GetDepth() == 0) {
+        return;
+    }
+
+    ERPL_TRACE_DEBUG("ODP_BIND_DATA", "Starting ODP page prefetch from: " + pending_next_url_);
+
+    auto orchestrator = request_orchestrator_.get();
+    auto next_url = pending_next_url_;
+    page_prefetcher_ = std::make_unique<ODataPagePrefetcher<OdpRequestOrchestrator::OdpRequestResult>>(
+        [orchestrator, next_url]() mutable -> std::shared_ptr<OdpRequestOrchestrator::OdpRequestResult> {
+            if (next_url.empty()) {
+                return nullptr;
+            }
+            auto result = std::make_shared<OdpRequestOrchestrator::OdpRequestResult>(
+                orchestrator->ExecuteNextPage(next_url));
+            std::optional<std::string> further_next;
+            if (result->response) {
+                further_next = result->response->NextUrl();
+            }
+            next_url = (further_next.has_value() && !further_next->empty()) ? further_next.value() : "";
+            return result;
+        },
+        [](const OdpRequestOrchestrator::OdpRequestResult &result) -> uint64_t {
+            return result.response_size_bytes;
+        },
+        settings.GetDepth(), settings.GetMaxBytes());
+}
+
 } // namespace erpl_web
@@ -84,6 +84,8 @@ duckdb::TableFunctionSet CreateSacReadPlanningDataFunction() {
     );
 
     // Progress tracking
+    function.init_local = ODataReadTableInitLocalState;
+    function.get_partition_data = ODataReadGetPartitionData;
     function.table_scan_progress = ODataReadTableProgress;
 
     set.AddFunction(function);
@@ -181,6 +183,8 @@ duckdb::TableFunctionSet CreateSacReadAnalyticalFunction() {
         duckdb::LogicalType(duckdb::LogicalTypeId::VARCHAR)
     );
 
+    function.init_local = ODataReadTableInitLocalState;
+    function.get_partition_data = ODataReadGetPartitionData;
     function.table_scan_progress = ODataReadTableProgress;
 
     set.AddFunction(function);
@@ -238,6 +242,8 @@ duckdb::TableFunctionSet CreateSacReadStoryDataFunction() {
     );
 
     function.named_parameters["secret"] = duckdb::LogicalType(duckdb::LogicalTypeId::VARCHAR);
+    function.init_local = ODataReadTableInitLocalState;
+    function.get_partition_data = ODataReadGetPartitionData;
     function.table_scan_progress = ODataReadTableProgress;
 
     set.AddFunction(function);
@@ -28,6 +28,11 @@ std::unique_ptr<HttpResponse> TimeoutHttpClient::SendRequest(const HttpRequest&
     return SendRequestWithTimeout(request_copy, default_timeout_);
 }
 
+std::unique_ptr<HttpResponse> TimeoutHttpClient::SendStreamingRequest(const HttpRequest& request, HttpBodyConsumer& consumer) {
+    HttpRequest request_copy = request;
+    return http_client_->SendStreamingRequest(request_copy, consumer);
+}
+
 void TimeoutHttpClient::SetDefaultTimeout(std::chrono::milliseconds timeout) {
     default_timeout_ = timeout;
 }
@@ -1,9 +1,15 @@
 #include "web_functions.hpp"
 #include "duckdb_argument_helper.hpp"
+#include "http_disk_cache.hpp"
+#include "http_single_flight.hpp"
 
 #include "telemetry.hpp"
 #include "tracing.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+
 namespace erpl_web {
 
 
@@ -191,13 +197,9 @@ static std::shared_ptr<HttpRequest> MutatingRequestFromInput(const HttpAuthParam
     return request;
 }
 
-static std::shared_ptr<HttpAuthParams> AuthParamsFromInput(duckdb::ClientContext &context, TableFunctionBindInput &input)
+// Credentials from the auth / auth_type parameters, nullptr if none (or an unsupported type) were given
+static std::shared_ptr<HttpAuthParams> AuthParamsFromAuthParam(duckdb::named_parameter_map_t &named_params)
 {
-    auto args = input.inputs;
-    auto url = args[0].ToString();
-    auto named_params = input.named_parameters;
-    
-    // Check if auth parameter is provided - this takes precedence over secrets
     if (HasParam(named_params, "auth")) {
         auto auth_value = named_params["auth"].GetValue<std::string>();
         ERPL_TRACE_DEBUG("HTTP_AUTH", "Using auth parameter: " + auth_value);
@@ -233,11 +235,24 @@ static std::shared_ptr<HttpAuthParams> AuthParamsFromInput(duckdb::ClientContext
             ERPL_TRACE_DEBUG("HTTP_AUTH", "Parsed bearer auth from parameter - token: ***");
         } else {
             ERPL_TRACE_ERROR("HTTP_AUTH", "Unsupported auth_type: " + auth_type + ", falling back to registered secrets");
-            return HttpAuthParams::FromDuckDbSecrets(context, url);
+            return nullptr;
         }
         
         return auth_params;
     }
+    return nullptr;
+}
+
+static std::shared_ptr<HttpAuthParams> AuthParamsFromInput(duckdb::ClientContext &context, TableFunctionBindInput &input)
+{
+    auto args = input.inputs;
+    auto url = args[0].ToString();
+    
+    // Check if auth parameter is provided - this takes precedence over secrets
+    auto auth_params = AuthParamsFromAuthParam(input.named_parameters);
+    if (auth_params) {
+        return auth_params;
+    }
     
     // Fall back to registered secrets
     ERPL_TRACE_DEBUG("HTTP_AUTH", "No auth parameter provided, using registered secrets");
@@ -374,6 +389,322 @@ static void HttpScan(ClientContext &context,
 
 // ----------------------------------------------------------------------
 
+// Fan-out variant: one request per input row, run concurrently, every result row
+// carries the columns of the input row it belongs to.
+
+static constexpr idx_t HTTP_FANOUT_DEFAULT_CONCURRENCY = 8;
+
+struct HttpFanoutBindData : public TableFunctionData {
+    HttpMethod method = HttpMethod::GET;
+    HttpParams http_params;
+    // Set when credentials were passed as parameters, otherwise secrets are looked up per URL
+    std::shared_ptr<HttpAuthParams> auth_params;
+    Value headers;
+    std::string accept = "application/json";
+    std::string content_type = "application/json";
+    idx_t max_concurrency = HTTP_FANOUT_DEFAULT_CONCURRENCY;
+
+    idx_t url_column = DConstants::INVALID_INDEX;
+    idx_t body_column = DConstants::INVALID_INDEX;
+    idx_t headers_column = DConstants::INVALID_INDEX;
+    idx_t content_type_column = DConstants::INVALID_INDEX;
+    idx_t method_column = DConstants::INVALID_INDEX;
+    idx_t input_column_count = 0;
+};
+
+// Bounds the requests in flight across all pipeline threads executing the function
+struct HttpFanoutGlobalState : public GlobalTableFunctionState {
+    explicit HttpFanoutGlobalState(idx_t max_concurrency) : max_concurrency(max_concurrency) { }
+
+    void AcquireSlot() {
+        std::unique_lock<std::mutex> lock(mutex);
+        slot_available.wait(lock, [this] { return in_flight < max_concurrency; });
+        in_flight++;
+    }
+
+    void ReleaseSlot() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            in_flight--;
+        }
+        slot_available.notify_one();
+    }
+
+    const idx_t max_concurrency;
+    std::mutex mutex;
+    std::condition_variable slot_available;
+    idx_t in_flight = 0;
+};
+
+static idx_t FindInputColumn(const vector<string> &names, const vector<std::string> &candidates)
+{
+    for (const auto &candidate : candidates) {
+        for (idx_t i = 0; i < names.size(); i++) {
+            if (StringUtil::CIEquals(names[i], candidate)) {
+                return i;
+            }
+        }
+    }
+    return DConstants::INVALID_INDEX;
+}
+
+static unique_ptr<FunctionData> HttpFanoutBind(ClientContext &context,
+                                               TableFunctionBindInput &input,
+                                               vector<LogicalType> &return_types,
+                                               vector<string> &names)
+{
+    PostHogTelemetry::Instance().CaptureFunctionExecution("http_fanout");
+    auto bind_data = make_uniq<HttpFanoutBindData>();
+    auto &named_params = input.named_parameters;
+
+    bind_data->url_column = FindInputColumn(input.input_table_names, {"url"});
+    if (bind_data->url_column == DConstants::INVALID_INDEX) {
+        throw BinderException("http_fanout requires an input column named 'url'");
+    }
+    bind_data->body_column = FindInputColumn(input.input_table_names, {"body", "content"});
+    bind_data->headers_column = FindInputColumn(input.input_table_names, {"headers"});
+    bind_data->content_type_column = FindInputColumn(input.input_table_names, {"content_type"});
+    bind_data->method_column = FindInputColumn(input.input_table_names, {"method"});
+    if (bind_data->headers_column != DConstants::INVALID_INDEX &&
+        input.input_table_types[bind_data->headers_column].id() != LogicalTypeId::MAP) {
+        throw BinderException("http_fanout input column 'headers' must be a MAP(VARCHAR, VARCHAR)");
+    }
+
+    if (HasParam(named_params, "method")) {
+        bind_data->method = HttpMethod::FromString(named_params["method"].GetValue<std::string>());
+        if (bind_data->method.IsUndefined()) {
+            throw BinderException("Unsupported HTTP method '%s'", named_params["method"].ToString());
+        }
+    }
+    if (HasParam(named_params, "max_concurrency")) {
+        auto max_concurrency = named_params["max_concurrency"].GetValue<int64_t>();
+        if (max_concurrency < 1) {
+            throw BinderException("http_fanout max_concurrency must be at least 1");
+        }
+        bind_data->max_concurrency = static_cast<idx_t>(max_concurrency);
+    }
+    if (HasParam(named_params, "timeout")) {
+        bind_data->http_params.timeout = named_params["timeout"].GetValue<int64_t>();
+    }
+    if (HasParam(named_params, "url_encode")) {
+        bind_data->http_params.url_encode = named_params["url_encode"].GetValue<bool>();
+    }
+    if (HasParam(named_params, "headers")) {
+        bind_data->headers = named_params["headers"];
+    }
+    if (HasParam(named_params, "accept")) {
+        bind_data->accept = named_params["accept"].GetValue<std::string>();
+    }
+    if (HasParam(named_params, "content_type")) {
+        bind_data->content_type = named_params["content_type"].GetValue<std::string>();
+    }
+    bind_data->auth_params = AuthParamsFromAuthParam(named_params);
+
+    // Input columns pass through unchanged and tag every result with its row
+    bind_data->input_column_count = input.input_table_names.size();
+    names = input.input_table_names;
+    return_types = input.input_table_types;
+    names.push_back("response");
+    return_types.push_back(HttpResponse::DuckDbResponseType());
+    names.push_back("error");
+    return_types.push_back(LogicalType::VARCHAR);
+
+    return std::move(bind_data);
+}
+
+static unique_ptr<GlobalTableFunctionState> HttpFanoutInitGlobal(ClientContext &context, TableFunctionInitInput &input)
+{
+    auto &bind_data = input.bind_data->Cast<HttpFanoutBindData>();
+    return make_uniq<HttpFanoutGlobalState>(bind_data.max_concurrency);
+}
+
+static std::unique_ptr<HttpRequest> HttpFanoutRequestForRow(ClientContext &context,
+                                                            const HttpFanoutBindData &bind_data,
+                                                            DataChunk &input,
+                                                            idx_t row,
+                                                            std::unordered_map<std::string, std::shared_ptr<HttpAuthParams>> &auth_by_url,
+                                                            std::string &error)
+{
+    auto url_value = input.GetValue(bind_data.url_column, row);
+    if (url_value.IsNull()) {
+        error = "url is NULL";
+        return nullptr;
+    }
+    auto url = url_value.ToString();
+
+    auto method = bind_data.method;
+    if (bind_data.method_column != DConstants::INVALID_INDEX) {
+        auto row_method = input.GetValue(bind_data.method_column, row);
+        if (!row_method.IsNull()) {
+            method = HttpMethod::FromString(row_method.ToString());
+            if (method.IsUndefined()) {
+                // Reported on the row like any other failed request, the other rows are still sent
+                error = "Unsupported HTTP method '" + row_method.ToString() + "'";
+                return nullptr;
+            }
+        }
+    }
+    std::string content;
+    if (bind_data.body_column != DConstants::INVALID_INDEX) {
+        auto body = input.GetValue(bind_data.body_column, row);
+        content = body.IsNull() ? std::string() : body.ToString();
+    }
+    auto content_type = bind_data.content_type;
+    if (bind_data.content_type_column != DConstants::INVALID_INDEX) {
+        auto row_content_type = input.GetValue(bind_data.content_type_column, row);
+        if (!row_content_type.IsNull()) {
+            content_type = row_content_type.ToString();
+        }
+    }
+
+    auto request = std::make_unique<HttpRequest>(method, url, content_type, content);
+    // Headers are added first-wins, so the row's own headers override the function's
+    if (bind_data.headers_column != DConstants::INVALID_INDEX) {
+        request->HeadersFromMapArg(input.GetValue(bind_data.headers_column, row));
+    }
+    request->HeadersFromMapArg(bind_data.headers);
+    request->headers.emplace("Accept", bind_data.accept);
+
+    auto auth_params = bind_data.auth_params;
+    if (!auth_params) {
+        auto it = auth_by_url.find(url);
+        if (it == auth_by_url.end()) {
+            it = auth_by_url.emplace(url, HttpAuthParams::FromDuckDbSecrets(context, url)).first;
+        }
+        auth_params = it->second;
+    }
+    request->AuthHeadersFromParams(*auth_params);
+    return request;
+}
+
+static OperatorResultType HttpFanoutInOut(ExecutionContext &context,
+                                          TableFunctionInput &data,
+                                          DataChunk &input,
+                                          DataChunk &output)
+{
+    auto &bind_data = data.bind_data->Cast<HttpFanoutBindData>();
+    auto &global_state = data.global_state->Cast<HttpFanoutGlobalState>();
+    auto count = input.size();
+
+    // Secrets are resolved on the pipeline thread, the workers only talk HTTP
+    std::unordered_map<std::string, std::shared_ptr<HttpAuthParams>> auth_by_url;
+    std::vector<std::unique_ptr<HttpRequest>> requests(count);
+    std::vector<std::string> errors(count);
+    for (idx_t row = 0; row < count; row++) {
+        requests[row] = HttpFanoutRequestForRow(context.client, bind_data, input, row, auth_by_url, errors[row]);
+    }
+
+    std::vector<std::unique_ptr<HttpResponse>> responses(count);
+    std::atomic<idx_t> next_row{0};
+    auto run_requests = [&]() {
+        // Connections come from the shared pool, a client per worker only keeps the retry state apart
+        HttpClient client(bind_data.http_params);
+        for (idx_t row = next_row++; row < count; row = next_row++) {
+            if (!requests[row]) {
+                // The row's error was set while building the requests
+                continue;
+            }
+            global_state.AcquireSlot();
+            try {
+                responses[row] = client.SendRequest(*requests[row]);
+            } catch (const std::exception &e) {
+                // A failing row must not abort the remaining requests of the batch
+                errors[row] = e.what();
+            }
+            global_state.ReleaseSlot();
+        }
+    };
+
+    auto n_workers = std::min<idx_t>(bind_data.max_concurrency, count);
+    std::vector<std::thread> workers;
+    for (idx_t i = 1; i < n_workers; i++) {
+        workers.emplace_back(run_requests);
+    }
+    run_requests();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    for (idx_t col = 0; col < bind_data.input_column_count; col++) {
+        output.data[col].Reference(input.data[col]);
+    }
+    auto response_column = bind_data.input_column_count;
+    auto error_column = response_column + 1;
+    auto response_names = HttpResponse::DuckDbResponseNames();
+    for (idx_t row = 0; row < count; row++) {
+        if (responses[row]) {
+            auto values = responses[row]->ToRow();
+            child_list_t<Value> children;
+            for (idx_t i = 0; i < values.size(); i++) {
+                children.emplace_back(response_names[i], std::move(values[i]));
+            }
+            output.SetValue(response_column, row, Value::STRUCT(std::move(children)));
+        } else {
+            output.SetValue(response_column, row, Value(HttpResponse::DuckDbResponseType()));
+        }
+        output.SetValue(error_column, row, errors[row].empty() ? Value(LogicalType::VARCHAR) : Value(errors[row]));
+    }
+    output.SetCardinality(count);
+
+    ERPL_TRACE_DEBUG("HTTP_FANOUT", "Completed " + std::to_string(count) + " requests with " +
+                     std::to_string(n_workers) + " workers");
+    return OperatorResultType::NEED_MORE_INPUT;
+}
+
+// ----------------------------------------------------------------------
+
+struct HttpCacheStatsState : public GlobalTableFunctionState {
+    bool done = false;
+};
+
+static unique_ptr<FunctionData> HttpCacheStatsBind(ClientContext &context, 
+                                                   TableFunctionBindInput &input, 
+                                                   vector<LogicalType> &return_types, 
+                                                   vector<string> &names) 
+{
+    names = {"entries", "bytes", "max_bytes", "hits", "misses", "insertions", "evictions", "expirations",
+             "disk_hits", "disk_revalidations", "disk_writes", "coalesced_requests"};
+    return_types = vector<LogicalType>(names.size(), LogicalType::UBIGINT);
+    return make_uniq<TableFunctionData>();
+}
+
+static unique_ptr<GlobalTableFunctionState> HttpCacheStatsInit(ClientContext &context, TableFunctionInitInput &input)
+{
+    return make_uniq<HttpCacheStatsState>();
+}
+
+static void HttpCacheStatsScan(ClientContext &context, 
+                               TableFunctionInput &data, 
+                               DataChunk &output) 
+{
+    auto &state = data.global_state->Cast<HttpCacheStatsState>();
+    if (state.done) {
+        output.SetCardinality(0);
+        return;
+    }
+
+    auto stats = HttpCache::GetInstance().GetStats();
+    auto max_bytes = HttpCachePolicy::GetInstance().GetMaxBytes();
+    auto disk_stats = HttpDiskCache::GetInstance().GetStats();
+    auto flight_stats = HttpSingleFlight::GetInstance().GetStats();
+    output.SetValue(0, 0, Value::UBIGINT(stats.entries));
+    output.SetValue(1, 0, Value::UBIGINT(stats.bytes));
+    output.SetValue(2, 0, Value::UBIGINT(max_bytes));
+    output.SetValue(3, 0, Value::UBIGINT(stats.hits));
+    output.SetValue(4, 0, Value::UBIGINT(stats.misses));
+    output.SetValue(5, 0, Value::UBIGINT(stats.insertions));
+    output.SetValue(6, 0, Value::UBIGINT(stats.evictions));
+    output.SetValue(7, 0, Value::UBIGINT(stats.expirations));
+    output.SetValue(8, 0, Value::UBIGINT(disk_stats.hits));
+    output.SetValue(9, 0, Value::UBIGINT(disk_stats.revalidations));
+    output.SetValue(10, 0, Value::UBIGINT(disk_stats.writes));
+    output.SetValue(11, 0, Value::UBIGINT(flight_stats.coalesced));
+    output.SetCardinality(1);
+    state.done = true;
+}
+
+// ----------------------------------------------------------------------
+
 LogicalType CreateHttpHeaderType() 
 {
     // Use MAP type to accept key-value pairs like MAP{'key': 'value', 'key2': 'value2'}
@@ -466,4 +797,19 @@ TableFunctionSet CreateHttpDeleteFunction()
     return CreateMutatingHttpFunction("delete", HttpDeleteBind);
 }
 
+TableFunction CreateHttpFanoutFunction()
+{
+    TableFunction function("http_fanout", {LogicalType::TABLE}, nullptr, HttpFanoutBind, HttpFanoutInitGlobal);
+    function.in_out_function = HttpFanoutInOut;
+    AddDefaultHttpNamedParams(function);
+    function.named_parameters["method"] = LogicalType::VARCHAR;
+    function.named_parameters["max_concurrency"] = LogicalType::BIGINT;
+    return function;
+}
+
+TableFunction CreateHttpCacheStatsFunction()
+{
+    return TableFunction("http_cache_stats", {}, HttpCacheStatsScan, HttpCacheStatsBind, HttpCacheStatsInit);
+}
+
 } // namespace erpl_web
\ No newline at end of file
@@ -0,0 +1,447 @@
+#include "catch.hpp"
+#include "delta_share_scan.hpp"
+#include "delta_share_cache.hpp"
+#include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/filter/null_filter.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+using namespace erpl_web;
+using namespace std;
+
+static DeltaShareColumn DeltaColumn(const string &name, const LogicalType &type, bool is_partition = false,
+                                    const string &physical_name = "")
+{
+    DeltaShareColumn column;
+    column.name = name;
+    column.physical_name = physical_name.empty() ? name : physical_name;
+    column.type = type;
+    column.is_partition = is_partition;
+    return column;
+}
+
+TEST_CASE("DeltaShareFileQuery - projected columns of one file", "[delta_share_scan]")
+{
+    DeltaShareScanBindData bind_data;
+    bind_data.columns.push_back(DeltaColumn("id", LogicalType::BIGINT));
+    bind_data.columns.push_back(DeltaColumn("Name \"quoted\"", LogicalType::VARCHAR, false, "col-5f1c"));
+    bind_data.columns.push_back(DeltaColumn("country", LogicalType::VARCHAR, true));
+    bind_data.columns.push_back(DeltaColumn("day", LogicalType::DATE, true));
+
+    DeltaFileReference file;
+    file.url = "https://bucket.example.com/part-0.parquet?X-Amz-Signature=a'b";
+    file.size = 1024;
+    file.id = "file-0";
+    file.partition_values["country"] = "DE";
+
+    SECTION("Data columns by physical name, partition columns as constants") {
+        auto query = DeltaShareFileQuery(bind_data, {3, 1, 2, 0},
+                                         {LogicalType::DATE, LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::BIGINT},
+                                         file);
+        REQUIRE(query == "SELECT CAST(NULL AS DATE), CAST(\"col-5f1c\" AS VARCHAR), CAST('DE' AS VARCHAR), "
+                         "CAST(\"id\" AS BIGINT) FROM read_parquet('https://bucket.example.com/part-0.parquet?"
+                         "X-Amz-Signature=a''b') AS delta_file");
+    }
+
+    SECTION("Virtual columns are typed NULLs") {
+        auto query = DeltaShareFileQuery(bind_data, {COLUMN_IDENTIFIER_ROW_ID}, {LogicalType::BIGINT}, file);
+        REQUIRE(query.find("SELECT CAST(NULL AS BIGINT) FROM read_parquet(") == 0);
+    }
+
+    SECTION("Without a schema the row is returned as text") {
+        DeltaShareScanBindData fallback;
+        fallback.fallback_schema = true;
+        auto query = DeltaShareFileQuery(fallback, {0}, {LogicalType::VARCHAR}, file);
+        REQUIRE(query.find("SELECT CAST(delta_file AS VARCHAR) FROM read_parquet(") == 0);
+    }
+}
+
+TEST_CASE("DeltaShareFileQuery - change data feed columns", "[delta_share_scan]")
+{
+    DeltaShareScanBindData bind_data;
+    bind_data.columns.push_back(DeltaColumn("id", LogicalType::BIGINT));
+    bind_data.change_feed = true;
+    bind_data.change_columns_start = 1;
+    vector<column_t> column_ids {0, 1, 2, 3};
+    vector<LogicalType> output_types {LogicalType::BIGINT, LogicalType::VARCHAR, LogicalType::BIGINT,
+                                      LogicalType::TIMESTAMP};
+
+    DeltaFileReference file;
+    file.url = "https://bucket.example.com/cdf-0.parquet";
+    file.size = 0;
+    file.version = 7;
+    file.timestamp = 1652140800000;
+
+    SECTION("cdf files carry the change type of each row") {
+        file.action = "cdf";
+        auto query = DeltaShareFileQuery(bind_data, column_ids, output_types, file);
+        REQUIRE(query == "SELECT CAST(\"id\" AS BIGINT), CAST(\"_change_type\" AS VARCHAR), CAST(7 AS BIGINT), "
+                         "CAST('2022-05-10 00:00:00'::TIMESTAMP AS TIMESTAMP) FROM read_parquet("
+                         "'https://bucket.example.com/cdf-0.parquet') AS delta_file");
+    }
+
+    SECTION("Rows of added and removed files were inserted and deleted") {
+        file.action = "add";
+        REQUIRE(DeltaShareFileQuery(bind_data, {1}, {LogicalType::VARCHAR}, file).find("SELECT 'insert' FROM") == 0);
+        file.action = "remove";
+        REQUIRE(DeltaShareFileQuery(bind_data, {1}, {LogicalType::VARCHAR}, file).find("SELECT 'delete' FROM") == 0);
+    }
+}
+
+TEST_CASE("ConvertDeltaTypeToLogicalType - primitive Delta types", "[delta_share_scan]")
+{
+    REQUIRE(ConvertDeltaTypeToLogicalType("long") == LogicalType::BIGINT);
+    REQUIRE(ConvertDeltaTypeToLogicalType("timestamp_ntz") == LogicalType::TIMESTAMP);
+    REQUIRE(ConvertDeltaTypeToLogicalType("binary") == LogicalType::BLOB);
+    REQUIRE(ConvertDeltaTypeToLogicalType("decimal(10,2)") == LogicalType::DECIMAL(10, 2));
+    REQUIRE(ConvertDeltaTypeToLogicalType("decimal(x,2)") == LogicalType::VARCHAR);
+    REQUIRE(ConvertDeltaTypeToLogicalType("unknown") == LogicalType::VARCHAR);
+}
+
+TEST_CASE("DeltaSharePushdown - filters of a partitioned table", "[delta_share_scan]")
+{
+    vector<DeltaShareColumn> columns;
+    columns.push_back(DeltaColumn("id", LogicalType::BIGINT));
+    columns.push_back(DeltaColumn("name", LogicalType::VARCHAR, false, "col-5f1c"));
+    columns.push_back(DeltaColumn("country", LogicalType::VARCHAR, true));
+
+    // Output columns: country, id, name
+    TableFilterSet table_filters;
+    table_filters.filters[0] = make_uniq<ConstantFilter>(ExpressionType::COMPARE_EQUAL, Value("DE"));
+    auto id_range = make_uniq<ConjunctionAndFilter>();
+    id_range->child_filters.push_back(make_uniq<ConstantFilter>(ExpressionType::COMPARE_GREATERTHANOREQUALTO, Value::BIGINT(100)));
+    id_range->child_filters.push_back(make_uniq<ConstantFilter>(ExpressionType::COMPARE_LESSTHAN, Value::BIGINT(200)));
+    table_filters.filters[1] = std::move(id_range);
+    table_filters.filters[2] = make_uniq<IsNotNullFilter>();
+
+    DeltaSharePushdown pushdown(columns, {2, 0, 1}, &table_filters);
+    REQUIRE(pushdown.HasFilters());
+
+    SECTION("Filters become one JSON predicate") {
+        REQUIRE(pushdown.JsonPredicateHints() ==
+                "{\"op\":\"and\",\"children\":["
+                "{\"op\":\"equal\",\"children\":[{\"op\":\"column\",\"name\":\"country\",\"valueType\":\"string\"},"
+                "{\"op\":\"literal\",\"value\":\"DE\",\"valueType\":\"string\"}]},"
+                "{\"op\":\"and\",\"children\":["
+                "{\"op\":\"greaterThanOrEqual\",\"children\":[{\"op\":\"column\",\"name\":\"id\",\"valueType\":\"long\"},"
+                "{\"op\":\"literal\",\"value\":\"100\",\"valueType\":\"long\"}]},"
+                "{\"op\":\"lessThan\",\"children\":[{\"op\":\"column\",\"name\":\"id\",\"valueType\":\"long\"},"
+                "{\"op\":\"literal\",\"value\":\"200\",\"valueType\":\"long\"}]}]},"
+                "{\"op\":\"not\",\"children\":[{\"op\":\"isNull\",\"children\":["
+                "{\"op\":\"column\",\"name\":\"name\",\"valueType\":\"string\"}]}]}]}");
+    }
+
+    SECTION("Data column filters become the file condition") {
+        REQUIRE(pushdown.FileCondition() == "(\"id\" >= 100 AND \"id\" < 200) AND \"col-5f1c\" IS NOT NULL");
+    }
+
+    SECTION("Files are pruned on partition values") {
+        DeltaFileReference file;
+        file.partition_values["country"] = "DE";
+        REQUIRE(pushdown.MayMatch(file));
+        file.partition_values["country"] = "FR";
+        REQUIRE_FALSE(pushdown.MayMatch(file));
+        file.partition_values.clear();
+        REQUIRE_FALSE(pushdown.MayMatch(file));
+    }
+
+    SECTION("Files are pruned on stats") {
+        DeltaFileReference file;
+        file.partition_values["country"] = "DE";
+        file.stats = "{\"numRecords\":10,\"minValues\":{\"id\":150},\"maxValues\":{\"id\":180},\"nullCount\":{\"col-5f1c\":0}}";
+        REQUIRE(pushdown.MayMatch(file));
+        file.stats = "{\"numRecords\":10,\"minValues\":{\"id\":200},\"maxValues\":{\"id\":300}}";
+        REQUIRE_FALSE(pushdown.MayMatch(file));
+        file.stats = "{\"numRecords\":10,\"minValues\":{\"id\":0},\"maxValues\":{\"id\":99}}";
+        REQUIRE_FALSE(pushdown.MayMatch(file));
+        file.stats = "{\"numRecords\":10,\"nullCount\":{\"col-5f1c\":10}}";
+        REQUIRE_FALSE(pushdown.MayMatch(file));
+        // Without stats nothing is known about the file
+        file.stats.reset();
+        REQUIRE(pushdown.MayMatch(file));
+        file.stats = "not json";
+        REQUIRE(pushdown.MayMatch(file));
+    }
+}
+
+TEST_CASE("DeltaSharePushdown - untranslatable filters keep rows", "[delta_share_scan]")
+{
+    vector<DeltaShareColumn> columns;
+    columns.push_back(DeltaColumn("ts", LogicalType::TIMESTAMP));
+    columns.push_back(DeltaColumn("id", LogicalType::BIGINT));
+
+    TableFilterSet table_filters;
+    table_filters.filters[0] = make_uniq<ConstantFilter>(ExpressionType::COMPARE_GREATERTHAN,
+                                                         Value::TIMESTAMP(Timestamp::FromEpochSeconds(0)));
+    auto or_filter = make_uniq<ConjunctionOrFilter>();
+    or_filter->child_filters.push_back(make_uniq<ConstantFilter>(ExpressionType::COMPARE_EQUAL, Value::BIGINT(1)));
+    or_filter->child_filters.push_back(make_uniq<IsNullFilter>());
+    table_filters.filters[1] = std::move(or_filter);
+
+    DeltaSharePushdown pushdown(columns, {0, 1}, &table_filters);
+    REQUIRE(pushdown.JsonPredicateHints() ==
+            "{\"op\":\"or\",\"children\":["
+            "{\"op\":\"equal\",\"children\":[{\"op\":\"column\",\"name\":\"id\",\"valueType\":\"long\"},"
+            "{\"op\":\"literal\",\"value\":\"1\",\"valueType\":\"long\"}]},"
+            "{\"op\":\"isNull\",\"children\":[{\"op\":\"column\",\"name\":\"id\",\"valueType\":\"long\"}]}]}");
+    REQUIRE(pushdown.FileCondition() == "(\"id\" = 1 OR \"id\" IS NULL)");
+
+    DeltaFileReference file;
+    // Either side of the OR may match
+    file.stats = "{\"numRecords\":10,\"minValues\":{\"id\":5},\"maxValues\":{\"id\":9},\"nullCount\":{\"id\":2}}";
+    REQUIRE(pushdown.MayMatch(file));
+    file.stats = "{\"numRecords\":10,\"minValues\":{\"id\":5},\"maxValues\":{\"id\":9},\"nullCount\":{\"id\":0}}";
+    REQUIRE_FALSE(pushdown.MayMatch(file));
+}
+
+TEST_CASE("DeltaShareQueryRequest - protocol request body", "[delta_share_scan]")
+{
+    DeltaShareQueryRequest request;
+    REQUIRE(request.ToJson() == "{}");
+
+    request.predicate_hints.push_back("name = 'a\"b'");
+    request.json_predicate_hints = "{\"op\":\"isNull\"}";
+    request.limit_hint = 1000;
+    request.version = 3;
+    REQUIRE(request.ToJson() == "{\"predicateHints\": [\"name = 'a\\\"b'\"], "
+                                "\"jsonPredicateHints\": \"{\\\"op\\\":\\\"isNull\\\"}\", "
+                                "\"limitHint\": 1000, \"version\": 3}");
+}
+
+static DeltaFileReference DeltaFile(const string &id)
+{
+    DeltaFileReference file;
+    file.url = "https://bucket.example.com/" + id + ".parquet";
+    file.size = 0;
+    file.id = id;
+    return file;
+}
+
+TEST_CASE("DeltaFileQueue - files are claimed while the listing goes on", "[delta_share_scan]")
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release_rest = false;
+
+    DeltaFileQueue queue([&](const DeltaFileQueue::FileCallback &on_file) {
+        on_file(DeltaFile("file-0"));
+        on_file(DeltaFile("file-1"));
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return release_rest; });
+        lock.unlock();
+        for (int i = 2; i < 5; i++) {
+            on_file(DeltaFile("file-" + std::to_string(i)));
+        }
+    });
+
+    // The first files are there before the listing has finished
+    DeltaFileReference file;
+    uint64_t index;
+    REQUIRE(queue.Next(file, index));
+    REQUIRE(file.id == "file-0");
+    REQUIRE(index == 0);
+    REQUIRE(queue.Next(file, index));
+    REQUIRE(file.id == "file-1");
+    REQUIRE_FALSE(queue.Finished());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release_rest = true;
+    }
+    cv.notify_all();
+
+    for (uint64_t i = 2; i < 5; i++) {
+        REQUIRE(queue.Next(file, index));
+        REQUIRE(index == i);
+    }
+    REQUIRE_FALSE(queue.Next(file, index));
+    REQUIRE(queue.Finished());
+    REQUIRE(queue.ListedFiles() == 5);
+}
+
+TEST_CASE("DeltaFileQueue - listing errors reach every thread", "[delta_share_scan]")
+{
+    DeltaFileQueue queue([](const DeltaFileQueue::FileCallback &on_file) {
+        on_file(DeltaFile("file-0"));
+        throw std::runtime_error("Delta Sharing API error (HTTP 500)");
+    });
+
+    DeltaFileReference file;
+    uint64_t index;
+    REQUIRE(queue.Next(file, index));
+    REQUIRE_THROWS_WITH(queue.Next(file, index), "Delta Sharing API error (HTTP 500)");
+    REQUIRE_THROWS_WITH(queue.Next(file, index), "Delta Sharing API error (HTTP 500)");
+}
+
+TEST_CASE("DeltaFileQueue - dropping the queue stops the listing", "[delta_share_scan]")
+{
+    std::atomic<bool> stopped {false};
+    {
+        DeltaFileQueue queue([&](const DeltaFileQueue::FileCallback &on_file) {
+            // An endless response, only the callback ends it
+            for (int i = 0;; i++) {
+                if (!on_file(DeltaFile("file-" + std::to_string(i)))) {
+                    stopped = true;
+                    return;
+                }
+            }
+        });
+        DeltaFileReference file;
+        uint64_t index;
+        REQUIRE(queue.Next(file, index));
+    }
+    REQUIRE(stopped);
+}
+
+TEST_CASE("DeltaShareFileListCache - lists are reused per table version and hints", "[delta_share_scan]")
+{
+    auto &cache = DeltaShareFileListCache::GetInstance();
+    cache.Clear();
+
+    DeltaShareProfile profile;
+    profile.endpoint = "https://sharing.example.com/delta-sharing";
+    profile.bearer_token = "token";
+    DeltaShareQueryRequest request;
+    request.version = 7;
+
+    auto key = DeltaShareFileListCache::Key(profile, "share", "schema", "table", request);
+    REQUIRE(key.find("token") == string::npos);
+
+    // Another version, other hints or another recipient list other files
+    auto other_version = request;
+    other_version.version = 8;
+    auto other_hints = request;
+    other_hints.json_predicate_hints = "{\"op\":\"isNull\"}";
+    auto other_profile = profile;
+    other_profile.bearer_token = "other-token";
+    REQUIRE(DeltaShareFileListCache::Key(profile, "share", "schema", "table", other_version) != key);
+    REQUIRE(DeltaShareFileListCache::Key(profile, "share", "schema", "table", other_hints) != key);
+    REQUIRE(DeltaShareFileListCache::Key(other_profile, "share", "schema", "table", request) != key);
+
+    REQUIRE(cache.Get(key) == nullptr);
+    cache.Put(key, {DeltaFile("file-0"), DeltaFile("file-1")});
+    auto files = cache.Get(key);
+    REQUIRE(files != nullptr);
+    REQUIRE(files->size() == 2);
+    REQUIRE((*files)[1].id == "file-1");
+
+    SECTION("Least recently used lists are dropped")
+    {
+        auto previous_max_entries = cache.GetMaxEntries();
+        cache.SetMaxEntries(2);
+        auto key_8 = DeltaShareFileListCache::Key(profile, "share", "schema", "table", other_version);
+        auto key_hints = DeltaShareFileListCache::Key(profile, "share", "schema", "table", other_hints);
+        cache.Put(key_8, {DeltaFile("file-2")});
+        REQUIRE(cache.Get(key) != nullptr);
+        cache.Put(key_hints, {DeltaFile("file-3")});
+        REQUIRE(cache.Get(key) != nullptr);
+        REQUIRE(cache.Get(key_8) == nullptr);
+        REQUIRE(cache.Get(key_hints) != nullptr);
+        cache.SetMaxEntries(previous_max_entries);
+    }
+
+    SECTION("Lists whose URLs are about to expire are not kept")
+    {
+        auto file = DeltaFile("file-4");
+        auto now = std::chrono::system_clock::now();
+        file.expiration_timestamp =
+            std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() + 60 * 1000;
+        cache.Put(key, {file});
+        REQUIRE(cache.Get(key) == nullptr);
+
+        // Otherwise the earlier of TTL and URL expiry less the margin applies
+        file.expiration_timestamp =
+            std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() + 3600 * 1000;
+        auto expiry = DeltaShareFileListCache::ExpiryOf({file}, now, std::chrono::hours(2));
+        REQUIRE(expiry < now + std::chrono::hours(1));
+        REQUIRE(expiry > now + std::chrono::minutes(50));
+        REQUIRE(DeltaShareFileListCache::ExpiryOf({file}, now, std::chrono::minutes(10)) ==
+                now + std::chrono::minutes(10));
+    }
+
+    cache.Clear();
+}
+
+TEST_CASE("DeltaShareDiskCache - files are downloaded once by id", "[delta_share_scan]")
+{
+    auto &disk_cache = DeltaShareDiskCache::GetInstance();
+    auto directory = (std::filesystem::temp_directory_path() / "erpl_web_delta_share_cache_test").string();
+    std::filesystem::remove_all(directory);
+    disk_cache.SetDirectory(directory);
+
+    DeltaShareProfile profile;
+    profile.endpoint = "https://sharing.example.com/delta-sharing";
+    auto file = DeltaFile("file-0");
+    file.size = 4;
+    int downloads = 0;
+    auto download = [&](const string &path) {
+        downloads++;
+        std::ofstream out(path, std::ios::binary);
+        out << "PAR1";
+    };
+
+    // Pre-signed URLs change with every listing, the name only depends on table and id
+    auto file_name = DeltaShareDiskCache::FileName(profile, "share", "schema", "table", file);
+    auto relisted = file;
+    relisted.url = "https://bucket.example.com/file-0.parquet?X-Amz-Signature=other";
+    REQUIRE(DeltaShareDiskCache::FileName(profile, "share", "schema", "table", relisted) == file_name);
+    REQUIRE(DeltaShareDiskCache::FileName(profile, "share", "schema", "other_table", file) != file_name);
+    REQUIRE(DeltaShareDiskCache::FileName(profile, "share", "schema", "table", DeltaFile("")).empty());
+
+    SECTION("A local copy is read by later scans")
+    {
+        auto copy = disk_cache.Resolve(file_name, file.size, download);
+        REQUIRE(copy);
+        REQUIRE(std::filesystem::file_size(copy->Path()) == 4);
+        REQUIRE(disk_cache.Resolve(file_name, file.size, download)->Path() == copy->Path());
+        REQUIRE(downloads == 1);
+    }
+
+    SECTION("Failed or truncated downloads fall back to the URL")
+    {
+        REQUIRE_FALSE(disk_cache.Resolve(file_name, file.size, [](const string &) {
+            throw std::runtime_error("Failed to download Delta Sharing file file-0 (HTTP 403)");
+        }));
+        REQUIRE_FALSE(disk_cache.Resolve(file_name, 8, download));
+        REQUIRE(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()) == 0);
+    }
+
+    SECTION("Least recently read copies are evicted over the budget")
+    {
+        auto previous_max_bytes = disk_cache.GetMaxBytes();
+        disk_cache.SetMaxBytes(4);
+        auto first = disk_cache.Resolve(file_name, file.size, download);
+        auto first_path = first->Path();
+        auto second_name = DeltaShareDiskCache::FileName(profile, "share", "schema", "table", DeltaFile("file-1"));
+        auto third_name = DeltaShareDiskCache::FileName(profile, "share", "schema", "table", DeltaFile("file-2"));
+
+        // A copy still being read stays, even over the budget
+        auto second = disk_cache.Resolve(second_name, file.size, download);
+        REQUIRE(std::filesystem::exists(second->Path()));
+        REQUIRE(std::filesystem::exists(first_path));
+
+        first.reset();
+        second.reset();
+        auto third = disk_cache.Resolve(third_name, file.size, download);
+        REQUIRE(std::filesystem::exists(third->Path()));
+        REQUIRE_FALSE(std::filesystem::exists(first_path));
+        disk_cache.SetMaxBytes(previous_max_bytes);
+    }
+
+    SECTION("A directory that cannot be created is reported as invalid input")
+    {
+        auto file_path = (std::filesystem::path(directory) / "not_a_directory").string();
+        std::ofstream(file_path) << "x";
+        REQUIRE_THROWS_AS(disk_cache.SetDirectory(file_path + "/cache"), duckdb::InvalidInputException);
+        REQUIRE(disk_cache.GetDirectory() == directory);
+    }
+
+    disk_cache.SetDirectory("");
+    std::filesystem::remove_all(directory);
+}
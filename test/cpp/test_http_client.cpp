@@ -1,5 +1,6 @@
 #include <thread>
 #include <chrono>
+#include <fstream>
 
 #include "catch.hpp"
 #include "test_helpers.hpp"
@@ -7,6 +8,11 @@
 
 #include "charset_converter.hpp"
 #include "http_client.hpp"
+#include "http_connection_pool.hpp"
+#include "http_disk_cache.hpp"
+#include "http_rate_limiter.hpp"
+#include "http_single_flight.hpp"
+#include "http_stream.hpp"
 #include "duckdb_argument_helper.hpp"
 
 using namespace erpl_web;
@@ -281,6 +287,553 @@ TEST_CASE("Test CachingHttpClient", "[http_client]") {
     }
 }
 
+TEST_CASE("Test HttpCachePolicy", "[http_client]") {
+    auto &policy = HttpCachePolicy::GetInstance();
+    auto &cache = HttpCache::GetInstance();
+    cache.Clear();
+
+    SECTION("Requests are classified by URL") {
+        HttpRequest metadata(HttpMethod::GET, "https://example.com/sap/opu/odata/sap/SVC/$metadata");
+        HttpRequest page(HttpMethod::GET, "https://example.com/sap/opu/odata/sap/SVC/Items?$top=10");
+        HttpRequest lookup(HttpMethod::GET, "https://example.com/sap/opu/odata/sap/SVC/Items/$count");
+        REQUIRE(HttpCachePolicy::Classify(metadata) == HttpCacheClass::METADATA);
+        // Lookups are only cached when their caller says so
+        REQUIRE(HttpCachePolicy::Classify(page) == HttpCacheClass::NO_STORE);
+        REQUIRE(HttpCachePolicy::Classify(lookup) == HttpCacheClass::NO_STORE);
+    }
+
+    SECTION("Pages, errors and large lookups are not stored") {
+        HttpResponse small(HttpMethod::GET, HttpUrl("https://example.com/a"), 200, "text/plain", "42");
+        HttpResponse error(HttpMethod::GET, HttpUrl("https://example.com/a"), 500, "text/plain", "boom");
+        HttpResponse large(HttpMethod::GET, HttpUrl("https://example.com/a"), 200, "application/json",
+                           std::string(policy.GetLookupMaxBytes() + 1, 'x'));
+
+        REQUIRE_FALSE(policy.ShouldStore(HttpCacheClass::NO_STORE, small));
+        REQUIRE(policy.ShouldStore(HttpCacheClass::LOOKUP, small));
+        REQUIRE_FALSE(policy.ShouldStore(HttpCacheClass::LOOKUP, error));
+        REQUIRE_FALSE(policy.ShouldStore(HttpCacheClass::LOOKUP, large));
+        REQUIRE(policy.ShouldStore(HttpCacheClass::METADATA, large));
+        REQUIRE(policy.GetTtl(HttpCacheClass::NO_STORE).count() == 0);
+    }
+
+    SECTION("The cache stays within its byte budget") {
+        auto previous_max_bytes = policy.GetMaxBytes();
+        HttpRequest first(HttpMethod::GET, "https://example.com/first");
+        HttpRequest second(HttpMethod::GET, "https://example.com/second");
+        auto body = std::string(1000, 'x');
+        auto response = HttpResponse(HttpMethod::GET, HttpUrl("https://example.com/first"), 200, "text/plain", body);
+        auto entry_size = HttpCache::ResponseSize(response);
+        policy.SetMaxBytes(entry_size + entry_size / 2);
+
+        cache.EmplaceCacheResponse(first, std::make_unique<HttpResponse>(response), std::chrono::seconds(10));
+        cache.EmplaceCacheResponse(second, std::make_unique<HttpResponse>(response), std::chrono::seconds(20));
+        REQUIRE_FALSE(cache.IsInCache(first));
+        REQUIRE(cache.IsInCache(second));
+        REQUIRE(cache.CachedBytes() == entry_size);
+
+        // Replacing an entry does not count it twice
+        cache.EmplaceCacheResponse(second, std::make_unique<HttpResponse>(response), std::chrono::seconds(20));
+        REQUIRE(cache.CachedBytes() == entry_size);
+        REQUIRE(cache.GetStats().entries == 1);
+
+        policy.SetMaxBytes(previous_max_bytes);
+        cache.Clear();
+    }
+}
+
+TEST_CASE("Test HttpCache LRU", "[http_client]") {
+    auto &policy = HttpCachePolicy::GetInstance();
+    auto &cache = HttpCache::GetInstance();
+    auto previous_max_bytes = policy.GetMaxBytes();
+    cache.Clear();
+
+    HttpRequest request(HttpMethod::GET, "https://example.com/lru/0");
+    auto response = std::make_shared<const HttpResponse>(HttpMethod::GET, HttpUrl("https://example.com/lru/0"),
+                                                         200, "text/plain", std::string(1000, 'x'));
+    auto entry_size = HttpCache::ResponseSize(*response);
+
+    SECTION("Hits share the cached response") {
+        auto before = cache.GetStats();
+        cache.EmplaceCacheResponse(request, response, std::chrono::seconds(10));
+        auto hit = cache.GetCachedResponse(request);
+        REQUIRE(hit.get() == response.get());
+
+        HttpRequest other(HttpMethod::GET, "https://example.com/lru/other");
+        REQUIRE(cache.GetCachedResponse(other) == nullptr);
+
+        auto after = cache.GetStats();
+        REQUIRE(after.hits == before.hits + 1);
+        REQUIRE(after.misses == before.misses + 1);
+        REQUIRE(after.insertions == before.insertions + 1);
+    }
+
+    SECTION("Credentials and Accept headers select different entries") {
+        auto first_user = request;
+        first_user.headers["Authorization"] = "Basic dXNlcjpwYXNz";
+        auto other_user = request;
+        other_user.headers["Authorization"] = "Basic b3RoZXI6dXNlcg==";
+        auto other_accept = first_user;
+        other_accept.headers["Accept"] = "application/json";
+
+        cache.EmplaceCacheResponse(first_user, response, std::chrono::seconds(10));
+        REQUIRE(cache.GetCachedResponse(first_user).get() == response.get());
+        REQUIRE(cache.GetCachedResponse(other_user) == nullptr);
+        REQUIRE(cache.GetCachedResponse(other_accept) == nullptr);
+
+        auto other_response = std::make_shared<const HttpResponse>(
+            HttpMethod::GET, HttpUrl("https://example.com/lru/0"), 200, "text/plain", std::string(10, 'y'));
+        cache.EmplaceCacheResponse(other_user, other_response, std::chrono::seconds(10));
+        REQUIRE(cache.GetStats().entries == 2);
+        REQUIRE(cache.GetCachedResponse(first_user).get() == response.get());
+        REQUIRE(cache.GetCachedResponse(other_user).get() == other_response.get());
+    }
+
+    SECTION("Expired entries are dropped on access") {
+        auto before = cache.GetStats();
+        cache.EmplaceCacheResponse(request, response, std::chrono::milliseconds(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        REQUIRE(cache.GetCachedResponse(request) == nullptr);
+        REQUIRE(cache.GetStats().expirations == before.expirations + 1);
+        REQUIRE(cache.CachedBytes() == 0);
+    }
+
+    SECTION("Inserts evict entries until the cache fits its budget") {
+        const idx_t capacity = 4;
+        policy.SetMaxBytes(entry_size * capacity);
+        auto before = cache.GetStats();
+
+        std::vector<HttpRequest> requests;
+        for (idx_t i = 0; i < capacity * 2; i++) {
+            requests.emplace_back(HttpMethod::GET, "https://example.com/lru/" + std::to_string(i));
+            cache.EmplaceCacheResponse(requests.back(), response, std::chrono::seconds(10));
+        }
+
+        auto after = cache.GetStats();
+        REQUIRE(after.bytes <= entry_size * capacity);
+        REQUIRE(after.entries <= capacity);
+        REQUIRE(after.evictions > before.evictions);
+        // The oldest entries go first, whichever shard they live in
+        for (idx_t i = 0; i < capacity; i++) {
+            REQUIRE_FALSE(cache.IsInCache(requests[i]));
+            REQUIRE(cache.IsInCache(requests[capacity + i]));
+        }
+
+        // A hit makes an entry the most recently used one
+        REQUIRE(cache.GetCachedResponse(requests[capacity]) != nullptr);
+        HttpRequest next(HttpMethod::GET, "https://example.com/lru/next");
+        cache.EmplaceCacheResponse(next, response, std::chrono::seconds(10));
+        REQUIRE(cache.IsInCache(next));
+        REQUIRE(cache.IsInCache(requests[capacity]));
+        REQUIRE_FALSE(cache.IsInCache(requests[capacity + 1]));
+    }
+
+    policy.SetMaxBytes(previous_max_bytes);
+    cache.Clear();
+}
+
+TEST_CASE("Test HttpDiskCache", "[http_client]") {
+    auto &disk_cache = HttpDiskCache::GetInstance();
+    auto directory = (std::filesystem::temp_directory_path() / "erpl_web_http_disk_cache_test").string();
+    std::filesystem::remove_all(directory);
+    disk_cache.SetDirectory(directory);
+
+    HttpRequest request(HttpMethod::GET, "https://example.com/sap/opu/odata/sap/SVC/$metadata");
+    request.headers["Accept"] = "application/xml";
+    HttpResponse response(HttpMethod::GET, HttpUrl("https://example.com/sap/opu/odata/sap/SVC/$metadata"), 200,
+                          "application/xml", "<edmx:Edmx Version=\"1.0\"/>\n\n");
+    response.headers["ETag"] = "W/\"42\"";
+    response.headers["Last-Modified"] = "Wed, 21 Oct 2015 07:28:00 GMT";
+
+    SECTION("Only GETs of metadata and service documents are persisted") {
+        REQUIRE(HttpDiskCache::IsPersistent(request, HttpCacheClass::METADATA));
+        REQUIRE(HttpDiskCache::IsPersistent(request, HttpCacheClass::SERVICE_DOCUMENT));
+        REQUIRE_FALSE(HttpDiskCache::IsPersistent(request, HttpCacheClass::LOOKUP));
+        REQUIRE_FALSE(HttpDiskCache::IsPersistent(HttpRequest(HttpMethod::HEAD, "https://example.com/$metadata"),
+                                                  HttpCacheClass::METADATA));
+    }
+
+    SECTION("Entries round-trip with their validators") {
+        REQUIRE_FALSE(disk_cache.Load(request).has_value());
+        disk_cache.Store(request, response, std::chrono::minutes(5));
+
+        auto entry = disk_cache.Load(request);
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->IsFresh(std::chrono::system_clock::now()));
+        REQUIRE(entry->response->Code() == 200);
+        REQUIRE(entry->response->Content() == response.content);
+        REQUIRE(entry->response->ContentType() == "application/xml");
+        REQUIRE(entry->etag == "W/\"42\"");
+        REQUIRE(entry->last_modified == "Wed, 21 Oct 2015 07:28:00 GMT");
+
+        // Different credentials never see each other's entries
+        auto other_user = request;
+        other_user.headers["Authorization"] = "Basic b3RoZXI6dXNlcg==";
+        REQUIRE_FALSE(disk_cache.Load(other_user).has_value());
+    }
+
+    SECTION("Expired entries are revalidated with conditional headers") {
+        disk_cache.Store(request, response, std::chrono::milliseconds(0));
+        auto entry = disk_cache.Load(request);
+        REQUIRE(entry.has_value());
+        REQUIRE_FALSE(entry->IsFresh(std::chrono::system_clock::now()));
+
+        auto conditional = request;
+        HttpDiskCache::AddConditionalHeaders(conditional, *entry);
+        REQUIRE(conditional.headers["If-None-Match"] == "W/\"42\"");
+        REQUIRE(conditional.headers["If-Modified-Since"] == "Wed, 21 Oct 2015 07:28:00 GMT");
+
+        HttpResponse not_modified(HttpMethod::GET, request.url, 304);
+        not_modified.headers["ETag"] = "W/\"43\"";
+        auto refreshed = disk_cache.Revalidate(request, *entry, not_modified, std::chrono::minutes(5));
+        REQUIRE(refreshed->Content() == response.content);
+
+        auto reloaded = disk_cache.Load(request);
+        REQUIRE(reloaded.has_value());
+        REQUIRE(reloaded->IsFresh(std::chrono::system_clock::now()));
+        REQUIRE(reloaded->etag == "W/\"43\"");
+    }
+
+    SECTION("A directory that cannot be created is reported as invalid input") {
+        auto file = (std::filesystem::path(directory) / "not_a_directory").string();
+        std::ofstream(file) << "x";
+        REQUIRE_THROWS_AS(disk_cache.SetDirectory(file + "/cache"), duckdb::InvalidInputException);
+        REQUIRE(disk_cache.GetDirectory() == directory);
+    }
+
+    disk_cache.SetDirectory("");
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Test HttpSingleFlight", "[http_client]") {
+    auto &single_flight = HttpSingleFlight::GetInstance();
+
+    SECTION("Flight keys separate credentials but not header order") {
+        HttpRequest first(HttpMethod::GET, "https://example.com/$metadata");
+        first.headers["Accept"] = "application/xml";
+        first.headers["Authorization"] = "Basic dXNlcjpwYXNz";
+        HttpRequest second(HttpMethod::GET, "https://example.com/$metadata");
+        second.headers["Authorization"] = "Basic dXNlcjpwYXNz";
+        second.headers["Accept"] = "application/xml";
+        HttpRequest other_user(HttpMethod::GET, "https://example.com/$metadata");
+        other_user.headers["Accept"] = "application/xml";
+        other_user.headers["Authorization"] = "Basic b3RoZXI6dXNlcg==";
+
+        REQUIRE(HttpSingleFlight::FlightKey(first) == HttpSingleFlight::FlightKey(second));
+        REQUIRE(HttpSingleFlight::FlightKey(first) != HttpSingleFlight::FlightKey(other_user));
+    }
+
+    SECTION("Concurrent callers share one request") {
+        const int n_callers = 8;
+        std::atomic<int> fetches{0};
+        std::atomic<int> waiting{0};
+        auto before = single_flight.GetStats();
+
+        auto fetch = [&]() -> std::shared_ptr<const HttpResponse> {
+            fetches++;
+            // Hold the flight open until every other caller joined it
+            while (waiting < n_callers - 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return std::make_shared<const HttpResponse>(HttpMethod::GET, HttpUrl("https://example.com/shared"),
+                                                        200, "text/plain", "shared");
+        };
+
+        std::vector<std::shared_ptr<const HttpResponse>> results(n_callers);
+        std::vector<std::thread> callers;
+        for (int i = 0; i < n_callers; i++) {
+            callers.emplace_back([&, i]() {
+                if (i > 0) {
+                    // Give the first caller a head start so it leads the flight
+                    while (single_flight.InFlight() == 0) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    waiting++;
+                }
+                results[i] = single_flight.Do("single-flight-test", fetch);
+            });
+        }
+        for (auto &caller : callers) {
+            caller.join();
+        }
+
+        REQUIRE(fetches == 1);
+        for (const auto &result : results) {
+            REQUIRE(result.get() == results[0].get());
+        }
+        REQUIRE(single_flight.GetStats().coalesced >= before.coalesced + n_callers - 1);
+        REQUIRE(single_flight.InFlight() == 0);
+    }
+
+    SECTION("Errors reach every waiting caller and are not remembered") {
+        REQUIRE_THROWS(single_flight.Do("single-flight-error", []() -> std::shared_ptr<const HttpResponse> {
+            throw std::runtime_error("boom");
+        }));
+        auto response = single_flight.Do("single-flight-error", []() {
+            return std::make_shared<const HttpResponse>(HttpMethod::GET, HttpUrl("https://example.com/ok"), 200);
+        });
+        REQUIRE(response->Code() == 200);
+    }
+}
+
+TEST_CASE("Test HttpRateLimiter", "[http_client]") {
+    auto &limiter = HttpRateLimiter::GetInstance();
+    auto previous_rps = limiter.GetRequestsPerSecond();
+    auto previous_max_retry_after = limiter.GetMaxRetryAfter();
+    limiter.Clear();
+    const std::string host = HttpRateLimiter::HostKey("https://Throttled.example.com:443");
+
+    SECTION("Retry-After accepts seconds and HTTP dates") {
+        auto now = std::chrono::system_clock::time_point(std::chrono::seconds(1445412480)); // Wed, 21 Oct 2015 07:28:00 GMT
+        REQUIRE(HttpRateLimiter::ParseRetryAfter("120", now) == std::chrono::milliseconds(120000));
+        REQUIRE(HttpRateLimiter::ParseRetryAfter("Wed, 21 Oct 2015 07:28:30 GMT", now) == std::chrono::milliseconds(30000));
+        REQUIRE(HttpRateLimiter::ParseRetryAfter("Wed, 21 Oct 2015 07:27:00 GMT", now) == std::chrono::milliseconds(0));
+        REQUIRE_FALSE(HttpRateLimiter::ParseRetryAfter("soon", now).has_value());
+    }
+
+    SECTION("Throttled responses pause the host") {
+        duckdb_httplib_openssl::Headers headers;
+        headers.emplace("Retry-After", "2");
+        auto pause = limiter.OnResponse(host, 429, headers, std::chrono::milliseconds(100));
+        REQUIRE(pause == std::chrono::milliseconds(2000));
+        REQUIRE(limiter.PauseRemaining(host) > std::chrono::milliseconds(1000));
+        REQUIRE(limiter.PauseRemaining(HttpRateLimiter::HostKey("https://other.example.com:443")).count() == 0);
+
+        // Without a header the client's backoff is used, announced pauses are capped
+        duckdb_httplib_openssl::Headers none;
+        REQUIRE(limiter.OnResponse(host, 503, none, std::chrono::milliseconds(100)) == std::chrono::milliseconds(100));
+        limiter.SetMaxRetryAfter(std::chrono::milliseconds(500));
+        headers.clear();
+        headers.emplace("Retry-After", "3600");
+        REQUIRE(limiter.OnResponse(host, 429, headers, std::chrono::milliseconds(100)) == std::chrono::milliseconds(500));
+    }
+
+    SECTION("Exhausted x-ms-ratelimit budgets pause before the server rejects") {
+        duckdb_httplib_openssl::Headers headers;
+        headers.emplace("x-ms-ratelimit-burst-remaining-xrm-requests", "0");
+        REQUIRE(limiter.OnResponse(host, 200, headers, std::chrono::milliseconds(100)) ==
+                std::chrono::milliseconds(HttpRateLimiter::EXHAUSTED_BUDGET_PAUSE_MS));
+
+        headers.clear();
+        headers.emplace("x-ms-ratelimit-burst-remaining-xrm-requests", "42");
+        limiter.Clear();
+        REQUIRE(limiter.OnResponse(host, 200, headers, std::chrono::milliseconds(100)).count() == 0);
+    }
+
+    SECTION("The token bucket enforces the request ceiling") {
+        limiter.SetRequestsPerSecond(20);
+        limiter.SetBurst(1);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 5; i++) {
+            limiter.Acquire(host);
+        }
+        // One request from the burst, four more at 20 per second
+        REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(180));
+        limiter.SetBurst(HttpRateLimiter::DEFAULT_BURST);
+    }
+
+    limiter.SetRequestsPerSecond(previous_rps);
+    limiter.SetMaxRetryAfter(previous_max_retry_after);
+    limiter.Clear();
+}
+
+// Feeds the body in chunks of the given size, as the socket would
+static void FeedInChunks(HttpBodyConsumer &consumer, const std::string &body, size_t chunk_size) {
+    for (size_t pos = 0; pos < body.size(); pos += chunk_size) {
+        if (!consumer.Consume(body.data() + pos, std::min(chunk_size, body.size() - pos))) {
+            return;
+        }
+    }
+    consumer.Finish();
+}
+
+TEST_CASE("Test HttpBodyConsumers", "[http_client]") {
+    SECTION("NDJSON lines are split across chunk boundaries") {
+        std::string body = "{\"protocol\":{}}\r\n{\"file\":{\"id\":\"a\"}}\n\n{\"file\":{\"id\":\"b\"}}";
+        for (size_t chunk_size : {1, 3, 7, 1024}) {
+            std::vector<std::string> lines;
+            NdjsonLineSplitter splitter([&](const std::string &line) {
+                lines.push_back(line);
+                return true;
+            });
+            FeedInChunks(splitter, body, chunk_size);
+
+            REQUIRE(lines.size() == 3);
+            REQUIRE(lines[0] == "{\"protocol\":{}}");
+            REQUIRE(lines[1] == "{\"file\":{\"id\":\"a\"}}");
+            REQUIRE(lines[2] == "{\"file\":{\"id\":\"b\"}}");
+            REQUIRE(splitter.MaxBufferedBytes() <= 20);
+        }
+    }
+
+    SECTION("NDJSON consumer can stop the transfer") {
+        int seen = 0;
+        NdjsonLineSplitter splitter([&](const std::string &) { return ++seen < 2; });
+        REQUIRE_FALSE(splitter.Consume("1\n2\n3\n", 6));
+        REQUIRE(seen == 2);
+    }
+
+    SECTION("OData v4 entities are streamed and the envelope keeps the next link") {
+        std::string body = "{\"@odata.context\":\"$metadata#People\",\"value\":[ "
+                           "{\"Name\":\"a]\\\"[\",\"Tags\":[1,2]} , {\"Name\":\"b\",\"Emails\":[]},\"x\" ],"
+                           "\"@odata.nextLink\":\"People?$skiptoken=2\"}";
+        for (size_t chunk_size : {1, 5, 4096}) {
+            std::vector<std::string> items;
+            JsonArrayItemStreamer streamer(JsonArrayItemStreamer::ODataItemPaths(), [&](const std::string &item) {
+                items.push_back(item);
+                return true;
+            });
+            FeedInChunks(streamer, body, chunk_size);
+
+            REQUIRE(streamer.FoundArray());
+            REQUIRE(items.size() == 3);
+            REQUIRE(items[0] == "{\"Name\":\"a]\\\"[\",\"Tags\":[1,2]}");
+            REQUIRE(items[1] == "{\"Name\":\"b\",\"Emails\":[]}");
+            REQUIRE(items[2] == "\"x\"");
+            REQUIRE(streamer.Envelope() == "{\"@odata.context\":\"$metadata#People\",\"value\":[],"
+                                           "\"@odata.nextLink\":\"People?$skiptoken=2\"}");
+        }
+    }
+
+    SECTION("OData v2 results are found below d") {
+        std::string body = "{\"d\":{\"__count\":\"2\",\"results\":[{\"ID\":1,\"Items\":{\"results\":[{\"ID\":9}]}},"
+                           "{\"ID\":2}],\"__next\":\"Orders?$skiptoken=2\"}}";
+        std::vector<std::string> items;
+        JsonArrayItemStreamer streamer(JsonArrayItemStreamer::ODataItemPaths(), [&](const std::string &item) {
+            items.push_back(item);
+            return true;
+        });
+        FeedInChunks(streamer, body, 2);
+
+        REQUIRE(items.size() == 2);
+        REQUIRE(items[0] == "{\"ID\":1,\"Items\":{\"results\":[{\"ID\":9}]}}");
+        REQUIRE(items[1] == "{\"ID\":2}");
+        REQUIRE(streamer.Envelope() == "{\"d\":{\"__count\":\"2\",\"results\":[],\"__next\":\"Orders?$skiptoken=2\"}}");
+    }
+
+    SECTION("Members of object items can be left out") {
+        std::string body = "{\"value\":[{\"ID\":1,\"Skip\":{\"a\":[1,{\"ID\":2}],\"b\":\"},\\\"\"},\"Name\":\"n\"},"
+                           "{ \"Skip\" : 5 , \"ID\" : 2 },{\"Skip\":1},\"x\"]}";
+        for (size_t chunk_size : {1, 2, 4096}) {
+            std::vector<std::string> items;
+            JsonArrayItemStreamer streamer(JsonArrayItemStreamer::ODataItemPaths(), [&](const std::string &item) {
+                items.push_back(item);
+                return true;
+            });
+            streamer.KeepItemMembers({"ID", "Name"});
+            FeedInChunks(streamer, body, chunk_size);
+
+            REQUIRE(items.size() == 4);
+            REQUIRE(items[0] == "{\"ID\":1,\"Name\":\"n\"}");
+            REQUIRE(items[1] == "{  \"ID\" : 2 }");
+            REQUIRE(items[2] == "{}");
+            REQUIRE(items[3] == "\"x\"");
+            REQUIRE(streamer.Envelope() == "{\"value\":[]}");
+        }
+    }
+
+    SECTION("A truncated document is reported") {
+        JsonArrayItemStreamer streamer(JsonArrayItemStreamer::ODataItemPaths(), [](const std::string &) { return true; });
+        std::string body = "{\"value\":[{\"ID\":1},{\"ID\"";
+        streamer.Consume(body.data(), body.size());
+        REQUIRE_THROWS(streamer.Finish());
+        REQUIRE(streamer.ItemCount() == 1);
+    }
+
+    SECTION("Single-byte charsets are converted to UTF-8 before the consumer") {
+        std::string body = "{\"value\":[{\"Name\":\"M\xFCller\"}]}";
+        for (auto content_type : {"application/json;charset=ISO-8859-1", "application/json"}) {
+            std::vector<std::string> items;
+            JsonArrayItemStreamer streamer(JsonArrayItemStreamer::ODataItemPaths(), [&](const std::string &item) {
+                items.push_back(item);
+                return true;
+            });
+            HttpCharsetConsumer utf8_streamer(streamer);
+            utf8_streamer.Start(content_type);
+            FeedInChunks(utf8_streamer, body, 3);
+
+            REQUIRE(items.size() == 1);
+            if (std::string(content_type) == "application/json") {
+                REQUIRE(items[0] == "{\"Name\":\"M\xFCller\"}");
+            } else {
+                REQUIRE(items[0] == "{\"Name\":\"M\xC3\xBCller\"}");
+            }
+        }
+    }
+
+    SECTION("File sink writes the body") {
+        auto path = (std::filesystem::temp_directory_path() / "erpl_web_http_file_sink_test.bin").string();
+        std::string body(100000, 'x');
+        body[4711] = '\n';
+        {
+            HttpFileSink sink(path);
+            FeedInChunks(sink, body, 8192);
+            REQUIRE(sink.BytesWritten() == body.size());
+        }
+        std::ifstream in(path, std::ios::binary);
+        std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        REQUIRE(written == body);
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("Test HttpConnectionPool", "[http_client]") {
+    auto &pool = HttpConnectionPool::GetInstance();
+    pool.Clear();
+
+    SECTION("Pool key separates origins and client settings") {
+        HttpParams params;
+        auto key1 = HttpConnectionPool::MakeKey("https://httpbun.com", params);
+        auto key2 = HttpConnectionPool::MakeKey("HTTPS://HTTPBUN.COM", params);
+        auto key3 = HttpConnectionPool::MakeKey("http://httpbun.com", params);
+        REQUIRE(key1 == key2);
+        REQUIRE(key1 != key3);
+
+        params.url_encode = false;
+        REQUIRE(HttpConnectionPool::MakeKey("https://httpbun.com", params) != key1);
+        params.url_encode = true;
+        params.timeout = 1000;
+        REQUIRE(HttpConnectionPool::MakeKey("https://httpbun.com", params) != key1);
+    }
+
+    SECTION("Clients without an open connection are not kept") {
+        auto key = HttpConnectionPool::MakeKey("http://localhost:1", HttpParams());
+        auto factory = [] { return std::make_unique<HttpConnectionPool::Client>("http://localhost:1"); };
+
+        auto before = pool.GetStats();
+        auto client = pool.Acquire(key, factory);
+        REQUIRE(client);
+        pool.Release(key, std::move(client), true);
+
+        auto after = pool.GetStats();
+        REQUIRE(after.created == before.created + 1);
+        REQUIRE(after.discarded == before.discarded + 1);
+        REQUIRE(after.idle == 0);
+    }
+
+    SECTION("Consecutive requests to the same origin reuse the connection") {
+        HttpClient client;
+        auto before = pool.GetStats();
+
+        auto response1 = client.Get("https://httpbun.com/get");
+        REQUIRE(response1->code == 200);
+        auto response2 = client.Get("https://httpbun.com/get?param=1");
+        REQUIRE(response2->code == 200);
+
+        auto after = pool.GetStats();
+        REQUIRE(after.reused >= before.reused + 1);
+    }
+
+    SECTION("Disabled pool does not keep connections") {
+        pool.SetEnabled(false);
+        HttpClient client;
+        auto response = client.Get("https://httpbun.com/get");
+        REQUIRE(response->code == 200);
+        REQUIRE(pool.GetStats().idle == 0);
+        pool.SetEnabled(true);
+    }
+}
+
 TEST_CASE("Test HttpAuthParams Authentication Precedence", "[http_auth]") {
     SECTION("Test basic authentication parameter parsing") {
         auto auth_params = std::make_shared<HttpAuthParams>();
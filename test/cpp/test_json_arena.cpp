@@ -0,0 +1,174 @@
+#include "catch.hpp"
+#include "json_arena.hpp"
+#include "odata_content.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+using namespace erpl_web;
+using namespace duckdb_yyjson;
+
+static std::string JsonArenaTestPage(size_t n_rows, size_t first_id = 0)
+{
+    std::string page = R"({"value": [)";
+    for (size_t i = 0; i < n_rows; i++) {
+        page += (i ? "," : "");
+        page += R"({"ID": )" + std::to_string(first_id + i) + R"(, "Name": "Customer )" + std::to_string(first_id + i) +
+                R"(", "Tags": ["a", "b"], "Address": {"City": "Berlin"}})";
+    }
+    return page + "]}";
+}
+
+TEST_CASE("JsonArena - documents read into the arena", "[json_arena]")
+{
+    JsonArena arena(1024);
+    auto page = JsonArenaTestPage(100);
+
+    auto doc = arena.Read(page.c_str(), page.size());
+    REQUIRE(doc != nullptr);
+    auto value = yyjson_obj_get(yyjson_doc_get_root(doc), "value");
+    REQUIRE(yyjson_arr_size(value) == 100);
+    REQUIRE(std::string(yyjson_get_str(yyjson_obj_get(yyjson_arr_get(value, 99), "Name"))) == "Customer 99");
+
+    REQUIRE(arena.DocumentCount() == 1);
+    REQUIRE(arena.RequestCount() > 0);
+    REQUIRE(arena.HeapAllocationCount() > 0);
+
+    REQUIRE(arena.Read("{not json", 9) == nullptr);
+}
+
+TEST_CASE("JsonArena - reset keeps the memory for the next document", "[json_arena]")
+{
+    JsonArena arena(1024);
+    auto first = JsonArenaTestPage(500);
+    REQUIRE(arena.Read(first.c_str(), first.size()) != nullptr);
+    auto heap_allocations = arena.HeapAllocationCount();
+    // The first page outgrew the initial block
+    REQUIRE(heap_allocations > 1);
+
+    // Pages of the same size are served without going to the heap again
+    for (size_t i = 1; i <= 10; i++) {
+        arena.Reset();
+        auto page = JsonArenaTestPage(500, i * 500);
+        auto doc = arena.Read(page.c_str(), page.size());
+        REQUIRE(doc != nullptr);
+        auto value = yyjson_obj_get(yyjson_doc_get_root(doc), "value");
+        REQUIRE(yyjson_get_uint(yyjson_obj_get(yyjson_arr_get_first(value), "ID")) == i * 500);
+    }
+    REQUIRE(arena.HeapAllocationCount() == heap_allocations + 1);
+    REQUIRE(arena.DocumentCount() == 11);
+}
+
+TEST_CASE("JsonArena - in-situ reads keep strings in the input", "[json_arena]")
+{
+    JsonArena arena;
+    std::string page = R"({"value": [{"Name": "in place"}]})";
+    auto size = page.size();
+    page.append(YYJSON_PADDING_SIZE, '\0');
+
+    auto doc = arena.Read(&page[0], size, YYJSON_READ_INSITU);
+    REQUIRE(doc != nullptr);
+    auto name = yyjson_obj_get(yyjson_arr_get_first(yyjson_obj_get(yyjson_doc_get_root(doc), "value")), "Name");
+    auto str = yyjson_get_str(name);
+    REQUIRE(str >= page.data());
+    REQUIRE(str < page.data() + page.size());
+}
+
+TEST_CASE("JsonArenaPool - arenas return to the pool with their last holder", "[json_arena]")
+{
+    auto pool = std::make_shared<JsonArenaPool>();
+    auto first = pool->Acquire();
+    auto second = pool->Acquire();
+    REQUIRE(first != second);
+    REQUIRE(pool->GetStats().arenas == 0);
+
+    auto first_arena = first.get();
+    auto page = JsonArenaTestPage(10);
+    REQUIRE(first->Read(page.c_str(), page.size()) != nullptr);
+    auto holder = first;
+    first.reset();
+    REQUIRE(pool->GetStats().arenas == 0);
+    holder.reset();
+
+    auto stats = pool->GetStats();
+    REQUIRE(stats.arenas == 1);
+    REQUIRE(stats.documents == 1);
+
+    // The idle arena is handed out again
+    REQUIRE(pool->Acquire().get() == first_arena);
+
+    // An arena outliving its pool is simply deleted
+    pool.reset();
+    second.reset();
+}
+
+TEST_CASE("JsonArenaPool - OData pages parsed into pooled arenas", "[json_arena]")
+{
+    auto pool = std::make_shared<JsonArenaPool>();
+    {
+        auto content = std::make_shared<ODataEntitySetJsonContent>(JsonArenaTestPage(3), pool->Acquire());
+        REQUIRE(content->RowCount() == 3);
+        REQUIRE(pool->GetStats().arenas == 0);
+    }
+    // The arena came back once the page was dropped
+    REQUIRE(pool->GetStats().arenas == 1);
+
+    auto content = std::make_shared<ODataEntitySetJsonContent>(JsonArenaTestPage(5), pool->Acquire());
+    REQUIRE(content->RowCount() == 5);
+    REQUIRE(pool->GetStats().arenas == 0);
+}
+
+// yyjson_alc that forwards to the heap and counts, i.e. what the default allocator does
+struct CountingJsonAllocator {
+    uint64_t allocations = 0;
+
+    static void *Malloc(void *ctx, size_t size) {
+        static_cast<CountingJsonAllocator *>(ctx)->allocations++;
+        return std::malloc(size);
+    }
+    static void *Realloc(void *ctx, void *ptr, size_t old_size, size_t size) {
+        static_cast<CountingJsonAllocator *>(ctx)->allocations++;
+        return std::realloc(ptr, size);
+    }
+    static void Free(void *ctx, void *ptr) {
+        std::free(ptr);
+    }
+};
+
+// Micro-benchmark, run explicitly with: erpl_web_tests "[json_arena_benchmark]"
+TEST_CASE("Benchmark JsonArena against the default yyjson allocator", "[.][json_arena_benchmark]")
+{
+    const size_t n_pages = 200;
+    const size_t n_rows = 1000;
+    std::vector<std::string> pages;
+    for (size_t i = 0; i < n_pages; i++) {
+        pages.push_back(JsonArenaTestPage(n_rows, i * n_rows));
+    }
+
+    CountingJsonAllocator counting;
+    yyjson_alc counting_alc = {CountingJsonAllocator::Malloc, CountingJsonAllocator::Realloc,
+                               CountingJsonAllocator::Free, &counting};
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &page : pages) {
+        auto doc = yyjson_read_opts(const_cast<char *>(page.c_str()), page.size(), 0, &counting_alc, nullptr);
+        REQUIRE(doc != nullptr);
+        yyjson_doc_free(doc);
+    }
+    auto default_time = std::chrono::steady_clock::now() - start;
+
+    JsonArena arena;
+    start = std::chrono::steady_clock::now();
+    for (const auto &page : pages) {
+        arena.Reset();
+        REQUIRE(arena.Read(page.c_str(), page.size()) != nullptr);
+    }
+    auto arena_time = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(arena.HeapAllocationCount() < counting.allocations);
+    auto default_ms = std::chrono::duration_cast<std::chrono::milliseconds>(default_time).count();
+    auto arena_ms = std::chrono::duration_cast<std::chrono::milliseconds>(arena_time).count();
+    WARN("Parsed " << n_pages << " pages of " << n_rows << " rows: default allocator " << counting.allocations
+         << " heap allocations in " << default_ms << " ms, arena " << arena.HeapAllocationCount()
+         << " heap allocations (" << arena.RequestCount() << " requests) in " << arena_ms << " ms");
+}
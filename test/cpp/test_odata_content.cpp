@@ -3,6 +3,8 @@
 #include "duckdb.hpp"
 #include "odata_content.hpp"
 
+#include <chrono>
+
 using namespace erpl_web;
 using namespace std;
 
@@ -95,6 +97,682 @@ TEST_CASE("Test ODataEntitySetJsonContent ToRows", "[odata_content]")
     REQUIRE(rows[1][10].ToString() == "(5) 555-3745");
 }
 
+TEST_CASE("Test ODataEntitySetJsonContent DecodeRows", "[odata_content]")
+{
+    std::string json_content = R"({
+        "value": [
+            {"ID": 1, "Name": "Alpha", "Price": 1.5, "Active": true, "Qty": "7", "Created": "2024-01-02T03:04:05Z"},
+            {"ID": 2, "Name": null, "Price": 2, "Active": false, "Created": "/Date(1704164645000)/"},
+            {"ID": 3, "Name": "Gamma", "Price": "oops", "Active": true, "Qty": 9}
+        ]
+    })";
+
+    ODataEntitySetJsonContent content(json_content);
+    REQUIRE(content.RowCount() == 3);
+
+    std::vector<duckdb::LogicalType> types = {
+        duckdb::LogicalType::BIGINT, duckdb::LogicalType::VARCHAR, duckdb::LogicalType::DOUBLE,
+        duckdb::LogicalType::BOOLEAN, duckdb::LogicalType::INTEGER, duckdb::LogicalType::TIMESTAMP
+    };
+    std::vector<ODataColumnBinding> columns = {
+        {"ID", types[0], 0}, {"Name", types[1], 1}, {"Price", types[2], 2},
+        {"Active", types[3], 3}, {"Qty", types[4], 4}, {"Created", types[5], 5}
+    };
+
+    duckdb::DataChunk chunk;
+    chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+
+    // Decode the last two rows first, then the first one behind them
+    content.DecodeRows(1, 2, columns, chunk, 0);
+    content.DecodeRows(0, 1, columns, chunk, 2);
+    chunk.SetCardinality(3);
+
+    REQUIRE(chunk.GetValue(0, 0).GetValue<int64_t>() == 2);
+    REQUIRE(chunk.GetValue(1, 0).IsNull());
+    REQUIRE(chunk.GetValue(2, 0).GetValue<double>() == 2.0);
+    REQUIRE(chunk.GetValue(3, 0).GetValue<bool>() == false);
+    REQUIRE(chunk.GetValue(4, 0).IsNull()); // missing property
+    REQUIRE(chunk.GetValue(5, 0).ToString() == "2024-01-02 03:04:05");
+
+    REQUIRE(chunk.GetValue(0, 1).GetValue<int64_t>() == 3);
+    REQUIRE(chunk.GetValue(1, 1).ToString() == "Gamma");
+    REQUIRE(chunk.GetValue(2, 1).IsNull()); // undecodable value
+    REQUIRE(chunk.GetValue(4, 1).GetValue<int32_t>() == 9);
+    REQUIRE(chunk.GetValue(5, 1).IsNull());
+
+    REQUIRE(chunk.GetValue(0, 2).GetValue<int64_t>() == 1);
+    REQUIRE(chunk.GetValue(1, 2).ToString() == "Alpha");
+    REQUIRE(chunk.GetValue(2, 2).GetValue<double>() == 1.5);
+    REQUIRE(chunk.GetValue(3, 2).GetValue<bool>() == true);
+    REQUIRE(chunk.GetValue(4, 2).GetValue<int32_t>() == 7); // numeric string
+    REQUIRE(chunk.GetValue(5, 2).ToString() == "2024-01-02 03:04:05");
+}
+
+TEST_CASE("Test ODataEntitySetJsonContent DecodeRows references page strings", "[odata_content]")
+{
+    auto content = std::make_shared<ODataEntitySetJsonContent>(R"({
+        "value": [
+            {"Name": "A string well beyond the inline length", "Escaped": "line\nbreak \u00e9", "Created": "/Date(1704164645000)/"},
+            {"Name": "short", "Escaped": null, "Created": "2024-01-02"}
+        ]
+    })");
+
+    std::vector<duckdb::LogicalType> types(3, duckdb::LogicalType::VARCHAR);
+    std::vector<ODataColumnBinding> columns = {
+        {"Name", types[0], 0}, {"Escaped", types[1], 1}, {"Created", types[2], 2}
+    };
+
+    duckdb::DataChunk chunk;
+    chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+    content->DecodeRows(0, 2, columns, chunk, 0);
+    chunk.SetCardinality(2);
+
+    // The vectors keep the page buffer alive once the content is gone
+    content.reset();
+
+    REQUIRE(chunk.GetValue(0, 0).ToString() == "A string well beyond the inline length");
+    REQUIRE(chunk.GetValue(1, 0).ToString() == "line\nbreak \xc3\xa9"); // unescaped in place
+    REQUIRE(chunk.GetValue(2, 0).ToString() != "/Date(1704164645000)/"); // still normalized
+    REQUIRE(chunk.GetValue(0, 1).ToString() == "short");
+    REQUIRE(chunk.GetValue(1, 1).IsNull());
+    REQUIRE(chunk.GetValue(2, 1).ToString() == "2024-01-02");
+}
+
+TEST_CASE("Test ODataColumnDecoder nested columns match ToRows", "[odata_content]")
+{
+    std::string json_content = R"({
+        "value": [
+            {"ID": 1, "Address": {"City": "Berlin", "Zip": "12209"}, "Tags": ["a", "b"],
+             "Orders": {"results": [{"OrderID": 10, "Items": [1, 2]}, {"OrderID": 11, "Items": {"results": [3]}}]}},
+            {"ID": 2, "Address": {"city": "Paris", "Zip": {"nested": true}}, "Tags": [],
+             "Orders": [{"OrderID": "12", "Items": [4, "oops", 5]}]},
+            {"ID": 3, "Address": "not an object", "Tags": "not an array", "Orders": null},
+            {"ID": 4, "Address": null, "Orders": [{"Items": null}]}
+        ]
+    })";
+
+    auto order_type = duckdb::LogicalType::STRUCT({{"OrderID", duckdb::LogicalType::INTEGER},
+                                                   {"Items", duckdb::LogicalType::LIST(duckdb::LogicalType::INTEGER)}});
+    std::vector<std::string> names = {"ID", "Address", "Tags", "Orders"};
+    std::vector<duckdb::LogicalType> types = {
+        duckdb::LogicalType::BIGINT,
+        duckdb::LogicalType::STRUCT({{"City", duckdb::LogicalType::VARCHAR}, {"Zip", duckdb::LogicalType::VARCHAR}}),
+        duckdb::LogicalType::LIST(duckdb::LogicalType::VARCHAR),
+        duckdb::LogicalType::LIST(order_type)
+    };
+
+    ODataEntitySetJsonContent content(json_content);
+    auto expected = content.ToRows(names, types);
+    REQUIRE(expected.size() == 4);
+
+    std::vector<ODataColumnBinding> columns;
+    for (size_t i = 0; i < names.size(); i++) {
+        columns.push_back({names[i], types[i], i, std::make_shared<ODataColumnDecoder>(types[i])});
+    }
+
+    duckdb::DataChunk chunk;
+    chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+    content.DecodeRows(0, 4, columns, chunk, 0);
+    chunk.SetCardinality(4);
+
+    for (size_t i_row = 0; i_row < expected.size(); i_row++) {
+        for (size_t i_col = 0; i_col < names.size(); i_col++) {
+            auto actual = chunk.GetValue(i_col, i_row);
+            REQUIRE(actual.IsNull() == expected[i_row][i_col].IsNull());
+            REQUIRE(actual.ToString() == expected[i_row][i_col].ToString());
+        }
+    }
+
+    REQUIRE(duckdb::StructValue::GetChildren(chunk.GetValue(1, 1))[0].ToString() == "Paris");
+    REQUIRE(duckdb::StructValue::GetChildren(chunk.GetValue(1, 1))[1].IsNull());
+    REQUIRE(duckdb::ListValue::GetChildren(chunk.GetValue(2, 1)).empty());
+    REQUIRE(chunk.GetValue(1, 2).IsNull());
+    REQUIRE(chunk.GetValue(2, 2).IsNull());
+    REQUIRE(chunk.GetValue(2, 3).IsNull());
+    REQUIRE(chunk.GetValue(3, 2).IsNull());
+    // The element that does not fit the INTEGER element type is left out
+    auto orders = duckdb::ListValue::GetChildren(chunk.GetValue(3, 1));
+    REQUIRE(orders.size() == 1);
+    REQUIRE(duckdb::ListValue::GetChildren(duckdb::StructValue::GetChildren(orders[0])[1]).size() == 2);
+}
+
+TEST_CASE("Test ODataStringDictionary encodes repeated strings per chunk", "[odata_content]")
+{
+    // Currency repeats, the document number does not
+    std::string json_content = R"({"value": [
+        {"Doc": "4711", "Currency": "EUR"},
+        {"Doc": "4712", "Currency": "USD"},
+        {"Doc": "4713", "Currency": null},
+        {"Doc": "4714", "Currency": "EUR"},
+        {"Doc": "4715"},
+        {"Doc": "4716", "Currency": "EUR"}
+    ]})";
+    ODataEntitySetJsonContent content(json_content);
+
+    std::vector<duckdb::LogicalType> types = {duckdb::LogicalType::VARCHAR, duckdb::LogicalType::VARCHAR};
+    std::vector<ODataColumnBinding> columns;
+    columns.push_back({"Doc", types[0], 0, std::make_shared<ODataColumnDecoder>(types[0]),
+                       std::make_shared<ODataStringDictionary>()});
+    columns.push_back({"Currency", types[1], 1, std::make_shared<ODataColumnDecoder>(types[1]),
+                       std::make_shared<ODataStringDictionary>()});
+
+    // Two ranges of the page make up one chunk
+    duckdb::DataChunk chunk;
+    chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+    content.DecodeRows(0, 4, columns, chunk, 0);
+    content.DecodeRows(4, 2, columns, chunk, 4);
+    for (auto &column : columns) {
+        column.dictionary->Flush(chunk.data[column.output_index], 6);
+    }
+    chunk.SetCardinality(6);
+
+    REQUIRE(chunk.data[1].GetVectorType() == duckdb::VectorType::DICTIONARY_VECTOR);
+    REQUIRE(columns[1].dictionary->Enabled());
+    REQUIRE(columns[1].dictionary->DictionaryChunks() == 1);
+    std::vector<std::string> currencies = {"EUR", "USD", "", "EUR", "", "EUR"};
+    for (duckdb::idx_t row = 0; row < 6; row++) {
+        auto value = chunk.GetValue(1, row);
+        REQUIRE(value.IsNull() == currencies[row].empty());
+        if (!value.IsNull()) {
+            REQUIRE(value.ToString() == currencies[row]);
+        }
+    }
+
+    // Distinct values are flushed flat and the column stops using the dictionary
+    REQUIRE(chunk.data[0].GetVectorType() == duckdb::VectorType::FLAT_VECTOR);
+    REQUIRE_FALSE(columns[0].dictionary->Enabled());
+    REQUIRE(chunk.GetValue(0, 5).ToString() == "4716");
+
+    chunk.Reset();
+    content.DecodeRows(0, 6, columns, chunk, 0);
+    columns[1].dictionary->Flush(chunk.data[1], 6);
+    chunk.SetCardinality(6);
+    REQUIRE(chunk.GetValue(0, 2).ToString() == "4713");
+    REQUIRE(chunk.GetValue(1, 3).ToString() == "EUR");
+    REQUIRE(columns[1].dictionary->DictionaryChunks() == 2);
+}
+
+TEST_CASE("Test ODataPropertyLayout", "[odata_content]")
+{
+    std::string json_content = R"([
+        {"A": 1, "B": 2, "C": 3, "D": 4},
+        {"A": 5, "B": 6, "C": 7, "D": 8},
+        {"B": 9, "A": 10, "C": 11, "D": 12},
+        {"B": 13, "A": 14, "C": 15, "D": 16},
+        {"A": 17, "C": 18},
+        {"A": 19, "X": 20, "C": 21, "D": 22},
+        {"A": 23, "B": 24, "C": 25, "D": 26, "E": 27},
+        {"A": 28, "B": 29, "A": 30, "D": 31},
+        42
+    ])";
+    auto doc = yyjson_read(json_content.c_str(), json_content.size(), 0);
+    REQUIRE(doc);
+    auto root = yyjson_doc_get_root(doc);
+
+    // E and F are absent from the first object, A is projected twice
+    std::vector<std::string> names = {"C", "A", "E", "B", "A", "F"};
+    ODataPropertyLayout layout(names);
+    std::vector<yyjson_val *> values(names.size());
+
+    size_t idx, max;
+    yyjson_val *object;
+    yyjson_arr_foreach(root, idx, max, object) {
+        layout.Resolve(object, values.data());
+        for (size_t i = 0; i < names.size(); i++) {
+            auto expected = yyjson_is_obj(object) ? yyjson_obj_get(object, names[i].c_str()) : nullptr;
+            INFO("object " << idx << ", property " << names[i]);
+            REQUIRE(values[i] == expected);
+        }
+    }
+
+    // Rows 1 and 3 line up with the layout before them, every other object is learned
+    REQUIRE(layout.PositionalObjects() == 2);
+    REQUIRE(layout.LearnedObjects() == 6);
+    yyjson_doc_free(doc);
+}
+
+// The per-cell path DecodeRows took before decoders were compiled per column:
+// a switch on the vector type for every value, and everything beyond plain JSON
+// numbers, booleans and strings built as a Value by DeserializeJsonValue.
+class PerCellDecodedContent : public ODataEntitySetJsonContent {
+public:
+    using ODataEntitySetJsonContent::ODataEntitySetJsonContent;
+
+    void DecodePerCell(const std::vector<yyjson_val *> &entities, duckdb::idx_t row_offset, duckdb::idx_t row_count,
+                       const std::vector<ODataColumnBinding> &columns, duckdb::DataChunk &output)
+    {
+        for (const auto &column : columns) {
+            auto &target = output.data[column.output_index];
+            for (duckdb::idx_t i = 0; i < row_count; i++) {
+                auto json_value = yyjson_obj_getn(entities[row_offset + i], column.property_name.c_str(),
+                                                  column.property_name.size());
+                try {
+                    if (!json_value || yyjson_is_null(json_value)) {
+                        duckdb::FlatVector::SetNull(target, i, true);
+                    } else if (!TryWritePrimitive(json_value, target, i)) {
+                        target.SetValue(i, DeserializeJsonValue(json_value, column.type));
+                    }
+                } catch (const std::exception &) {
+                    duckdb::FlatVector::SetNull(target, i, true);
+                }
+            }
+        }
+    }
+
+    std::vector<yyjson_val *> Entities()
+    {
+        std::vector<yyjson_val *> entities;
+        auto json_values = GetValueArray(yyjson_doc_get_root(doc.get()));
+        size_t idx, max;
+        yyjson_val *json_row;
+        yyjson_arr_foreach(json_values, idx, max, json_row) {
+            entities.push_back(json_row);
+        }
+        return entities;
+    }
+
+private:
+    static bool TryWritePrimitive(yyjson_val *json_value, duckdb::Vector &target, duckdb::idx_t row)
+    {
+        switch (target.GetType().id()) {
+        case duckdb::LogicalTypeId::BOOLEAN:
+            if (!yyjson_is_bool(json_value)) {
+                return false;
+            }
+            duckdb::FlatVector::GetData<bool>(target)[row] = yyjson_get_bool(json_value);
+            return true;
+        case duckdb::LogicalTypeId::BIGINT:
+            if (!yyjson_is_sint(json_value) && !yyjson_is_uint(json_value)) {
+                return false;
+            }
+            duckdb::FlatVector::GetData<int64_t>(target)[row] = yyjson_get_sint(json_value);
+            return true;
+        case duckdb::LogicalTypeId::DOUBLE:
+            if (!yyjson_is_num(json_value)) {
+                return false;
+            }
+            duckdb::FlatVector::GetData<double>(target)[row] = yyjson_get_num(json_value);
+            return true;
+        case duckdb::LogicalTypeId::VARCHAR:
+            if (!yyjson_is_str(json_value)) {
+                return false;
+            }
+            duckdb::FlatVector::GetData<duckdb::string_t>(target)[row] =
+                duckdb::StringVector::AddString(target, yyjson_get_str(json_value), yyjson_get_len(json_value));
+            return true;
+        default:
+            return false;
+        }
+    }
+};
+
+// Micro-benchmark, run explicitly with: erpl_web_tests "[odata_decoder_benchmark]"
+TEST_CASE("Benchmark ODataColumnDecoder against per-cell decoding", "[.][odata_decoder_benchmark]")
+{
+    const duckdb::idx_t n_rows = 50000;
+    std::string json_content = R"({"value": [)";
+    for (duckdb::idx_t i = 0; i < n_rows; i++) {
+        json_content += (i ? "," : "");
+        json_content += R"({"ID": )" + std::to_string(i) + R"(, "Name": "Customer )" + std::to_string(i) +
+                        R"(", "Price": )" + std::to_string(i) + R"(.25, "Active": true, "Created": "2024-01-02T03:04:05Z",)" +
+                        R"( "Address": {"City": "Berlin", "Zip": ")" + std::to_string(10000 + i % 90000) + R"("},)" +
+                        R"( "Tags": {"results": ["a", "b", "c"]}})";
+    }
+    json_content += "]}";
+
+    std::vector<std::string> names = {"ID", "Name", "Price", "Active", "Created", "Address", "Tags"};
+    std::vector<duckdb::LogicalType> types = {
+        duckdb::LogicalType::BIGINT, duckdb::LogicalType::VARCHAR, duckdb::LogicalType::DOUBLE,
+        duckdb::LogicalType::BOOLEAN, duckdb::LogicalType::TIMESTAMP,
+        duckdb::LogicalType::STRUCT({{"City", duckdb::LogicalType::VARCHAR}, {"Zip", duckdb::LogicalType::VARCHAR}}),
+        duckdb::LogicalType::LIST(duckdb::LogicalType::VARCHAR)
+    };
+    std::vector<ODataColumnBinding> columns;
+    for (size_t i = 0; i < names.size(); i++) {
+        columns.push_back({names[i], types[i], i, std::make_shared<ODataColumnDecoder>(types[i])});
+    }
+
+    PerCellDecodedContent content(json_content);
+    auto entities = content.Entities();
+    REQUIRE(entities.size() == n_rows);
+    REQUIRE(content.RowCount() == n_rows);
+
+    duckdb::DataChunk per_cell_chunk;
+    per_cell_chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+    duckdb::DataChunk compiled_chunk;
+    compiled_chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+
+    const int repetitions = 5;
+    std::chrono::nanoseconds per_cell_time(0);
+    std::chrono::nanoseconds compiled_time(0);
+    for (int rep = 0; rep < repetitions; rep++) {
+        for (duckdb::idx_t offset = 0; offset < n_rows; offset += STANDARD_VECTOR_SIZE) {
+            auto count = std::min<duckdb::idx_t>(STANDARD_VECTOR_SIZE, n_rows - offset);
+
+            per_cell_chunk.Reset();
+            auto start = std::chrono::steady_clock::now();
+            content.DecodePerCell(entities, offset, count, columns, per_cell_chunk);
+            per_cell_time += std::chrono::steady_clock::now() - start;
+            per_cell_chunk.SetCardinality(count);
+
+            compiled_chunk.Reset();
+            start = std::chrono::steady_clock::now();
+            content.DecodeRows(offset, count, columns, compiled_chunk, 0);
+            compiled_time += std::chrono::steady_clock::now() - start;
+            compiled_chunk.SetCardinality(count);
+
+            if (rep == 0) {
+                for (duckdb::idx_t col = 0; col < columns.size(); col++) {
+                    REQUIRE(compiled_chunk.GetValue(col, count - 1) == per_cell_chunk.GetValue(col, count - 1));
+                }
+            }
+        }
+    }
+
+    auto per_cell_ms = std::chrono::duration_cast<std::chrono::milliseconds>(per_cell_time).count();
+    auto compiled_ms = std::chrono::duration_cast<std::chrono::milliseconds>(compiled_time).count();
+    WARN("Decoded " << n_rows * repetitions << " rows x " << columns.size() << " columns: per-cell "
+         << per_cell_ms << " ms, compiled decoders " << compiled_ms << " ms");
+}
+
+TEST_CASE("Benchmark ODataPropertyLayout on wide entities", "[.][odata_decoder_benchmark]")
+{
+    // An ODP extractor sized entity: 250 properties of which 200 are projected
+    const size_t n_rows = 5000;
+    const size_t n_properties = 250;
+    const size_t n_projected = 200;
+    std::string json_content = "[";
+    for (size_t i = 0; i < n_rows; i++) {
+        json_content += (i ? ",{" : "{");
+        for (size_t p = 0; p < n_properties; p++) {
+            json_content += (p ? "," : "");
+            json_content += "\"PROPERTY_" + std::to_string(p) + "\":" + std::to_string(i + p);
+        }
+        json_content += "}";
+    }
+    json_content += "]";
+
+    std::vector<std::string> names;
+    for (size_t p = 0; p < n_projected; p++) {
+        names.push_back("PROPERTY_" + std::to_string(p * n_properties / n_projected));
+    }
+
+    auto doc = yyjson_read(json_content.c_str(), json_content.size(), 0);
+    REQUIRE(doc);
+    auto root = yyjson_doc_get_root(doc);
+
+    std::vector<yyjson_val *> by_name(names.size());
+    std::vector<yyjson_val *> by_position(names.size());
+    ODataPropertyLayout layout(names);
+    std::chrono::nanoseconds by_name_time(0);
+    std::chrono::nanoseconds by_position_time(0);
+
+    size_t idx, max;
+    yyjson_val *object;
+    yyjson_arr_foreach(root, idx, max, object) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < names.size(); i++) {
+            by_name[i] = yyjson_obj_getn(object, names[i].c_str(), names[i].size());
+        }
+        by_name_time += std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        layout.Resolve(object, by_position.data());
+        by_position_time += std::chrono::steady_clock::now() - start;
+
+        REQUIRE(by_position == by_name);
+    }
+    REQUIRE(layout.LearnedObjects() == 1);
+
+    WARN("Located " << names.size() << " of " << n_properties << " properties in " << n_rows << " objects: by name "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(by_name_time).count() << " ms, by position "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(by_position_time).count() << " ms");
+    yyjson_doc_free(doc);
+}
+
+// Reads the page through the streaming reader, fed in chunks of the given size
+static std::vector<std::vector<duckdb::Value>> StreamRows(const std::string &json_content, size_t chunk_size,
+                                                          std::vector<std::string> &names,
+                                                          std::vector<duckdb::LogicalType> &types,
+                                                          std::optional<std::string> &next_link,
+                                                          std::optional<uint64_t> &total_count)
+{
+    std::vector<std::vector<duckdb::Value>> rows;
+    ODataJsonRowReader reader(names, types, [&](std::vector<duckdb::Value> &row) {
+        rows.push_back(row);
+        return true;
+    });
+    for (size_t pos = 0; pos < json_content.size(); pos += chunk_size) {
+        reader.Consume(json_content.data() + pos, std::min(chunk_size, json_content.size() - pos));
+    }
+    reader.Finish();
+    next_link = reader.NextLink();
+    total_count = reader.TotalCount();
+    return rows;
+}
+
+static void RequireSameRows(const std::vector<std::vector<duckdb::Value>> &expected,
+                            const std::vector<std::vector<duckdb::Value>> &actual)
+{
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i_row = 0; i_row < expected.size(); i_row++) {
+        REQUIRE(actual[i_row].size() == expected[i_row].size());
+        for (size_t i_col = 0; i_col < expected[i_row].size(); i_col++) {
+            REQUIRE(actual[i_row][i_col].IsNull() == expected[i_row][i_col].IsNull());
+            REQUIRE(actual[i_row][i_col].type() == expected[i_row][i_col].type());
+            REQUIRE(actual[i_row][i_col].ToString() == expected[i_row][i_col].ToString());
+        }
+    }
+}
+
+TEST_CASE("Test ODataJsonRowReader matches ToRows", "[odata_content]")
+{
+    SECTION("OData v4 with nested values, count and a trailing next link") {
+        std::string json_content = R"({
+            "@odata.context": "https://example.com/svc/$metadata#People",
+            "@odata.count": 42,
+            "value": [
+                {"ID": 1, "Name": "A, \"quoted\" } name", "Price": 1.5, "Tags": ["x", "y"],
+                 "Address": {"City": "Berlin", "Zip": "10115"}, "Ignored": {"deep": [1, {"a": "}"}]}},
+                {"Ignored": [], "ID": 2, "Name": null, "Price": "oops", "Tags": []},
+                {"ID": 3, "ID": 4, "Name": "Gamma", "Created": "/Date(1704164645000)/"}
+            ],
+            "@odata.nextLink": "https://example.com/svc/People?$skiptoken=3&x=1"
+        })";
+
+        std::vector<std::string> names = {"ID", "Name", "Price", "Tags", "Address", "Created", "Name"};
+        std::vector<duckdb::LogicalType> types = {
+            duckdb::LogicalType::BIGINT, duckdb::LogicalType::VARCHAR, duckdb::LogicalType::DOUBLE,
+            duckdb::LogicalType::LIST(duckdb::LogicalType::VARCHAR),
+            duckdb::LogicalType::STRUCT({{"City", duckdb::LogicalType::VARCHAR}, {"Zip", duckdb::LogicalType::VARCHAR}}),
+            duckdb::LogicalType::TIMESTAMP, duckdb::LogicalType::VARCHAR
+        };
+
+        ODataEntitySetJsonContent content(json_content);
+        auto expected = content.ToRows(names, types);
+
+        for (size_t chunk_size : {1, 3, 64, 1 << 16}) {
+            std::optional<std::string> next_link;
+            std::optional<uint64_t> total_count;
+            auto rows = StreamRows(json_content, chunk_size, names, types, next_link, total_count);
+            RequireSameRows(expected, rows);
+            REQUIRE(next_link == content.NextUrl());
+            REQUIRE(next_link.value() == "https://example.com/svc/People?$skiptoken=3&x=1");
+            REQUIRE(total_count.value() == 42);
+        }
+    }
+
+    SECTION("OData v2 with __count and __next inside d") {
+        std::string json_content = R"({"d": {"__count": "2", "results": [
+            {"__metadata": {"uri": "Orders(1)"}, "OrderID": 1, "Freight": "12.50", "ShipCity": "Reims"},
+            {"__metadata": {"uri": "Orders(2)"}, "OrderID": 2, "ShipCity": "Münster"}
+        ], "__next": "Orders?$skiptoken=2"}})";
+
+        std::vector<std::string> names = {"OrderID", "Freight", "ShipCity"};
+        std::vector<duckdb::LogicalType> types = {
+            duckdb::LogicalType::INTEGER, duckdb::LogicalType::DECIMAL(10, 2), duckdb::LogicalType::VARCHAR
+        };
+
+        ODataEntitySetJsonContent content(json_content);
+        auto expected = content.ToRows(names, types);
+
+        std::optional<std::string> next_link;
+        std::optional<uint64_t> total_count;
+        auto rows = StreamRows(json_content, 5, names, types, next_link, total_count);
+        RequireSameRows(expected, rows);
+        REQUIRE(rows[1][2].ToString() == "M\xC3\xBCnster");
+        REQUIRE(next_link.value() == "Orders?$skiptoken=2");
+        REQUIRE(total_count.value() == 2);
+    }
+
+    SECTION("Rows are handed out before the page is complete and reading can stop early") {
+        std::vector<std::string> names = {"ID"};
+        std::vector<duckdb::LogicalType> types = {duckdb::LogicalType::BIGINT};
+        size_t seen = 0;
+        ODataJsonRowReader reader(names, types, [&](std::vector<duckdb::Value> &) { return ++seen < 2; });
+
+        std::string first_part = R"({"value": [{"ID": 1}, {"ID": 2)";
+        REQUIRE(reader.Consume(first_part.data(), first_part.size()));
+        REQUIRE(seen == 1);
+        std::string second_part = R"(}, {"ID": 3}]})";
+        REQUIRE_FALSE(reader.Consume(second_part.data(), second_part.size()));
+        REQUIRE(seen == 2);
+    }
+
+    SECTION("A truncated page is reported") {
+        std::vector<std::string> names = {"ID"};
+        std::vector<duckdb::LogicalType> types = {duckdb::LogicalType::BIGINT};
+        ODataJsonRowReader reader(names, types, [](std::vector<duckdb::Value> &) { return true; });
+        std::string body = R"({"value": [{"ID": 1}, {"ID")";
+        reader.Consume(body.data(), body.size());
+        REQUIRE_THROWS_WITH(reader.Finish(), "OData response ended after 1 rows before the document was complete: "
+                                             "JSON body ended after 1 items before the document was complete");
+        REQUIRE(reader.RowsRead() == 1);
+    }
+}
+
+// Reads the page through the page reader, fed in chunks of the given size
+static std::shared_ptr<ODataEntitySetJsonContent> StreamPage(const std::string &json_content, size_t chunk_size)
+{
+    ODataEntitySetPageReader reader;
+    for (size_t pos = 0; pos < json_content.size(); pos += chunk_size) {
+        reader.Consume(json_content.data() + pos, std::min(chunk_size, json_content.size() - pos));
+    }
+    reader.Finish();
+    REQUIRE(reader.BytesRead() == json_content.size());
+    return reader.Content();
+}
+
+TEST_CASE("Test ODataEntitySetPageReader matches a page parsed as a whole", "[odata_content]")
+{
+    SECTION("OData v4 page with count, context and next link") {
+        std::string json_content = R"({
+            "@odata.context": "https://example.com/svc/$metadata#People",
+            "@odata.count": 42,
+            "value": [
+                {"ID": 1, "Name": "A, \"quoted\" ] name", "Tags": ["x", "y"], "Address": {"City": "Berlin"}},
+                {"ID": 2, "Name": null},
+                "not an entity"
+            ],
+            "@odata.nextLink": "People?$skiptoken=3"
+        })";
+        std::vector<std::string> names = {"ID", "Name", "Tags", "Address"};
+        std::vector<duckdb::LogicalType> types = {
+            duckdb::LogicalType::BIGINT, duckdb::LogicalType::VARCHAR,
+            duckdb::LogicalType::LIST(duckdb::LogicalType::VARCHAR),
+            duckdb::LogicalType::STRUCT({{"City", duckdb::LogicalType::VARCHAR}})
+        };
+
+        ODataEntitySetJsonContent whole(json_content);
+        auto expected = whole.ToRows(names, types);
+
+        for (size_t chunk_size : {1, 7, 1 << 16}) {
+            auto content = StreamPage(json_content, chunk_size);
+            REQUIRE(content->RowCount() == 3);
+            RequireSameRows(expected, content->ToRows(names, types));
+            REQUIRE(content->NextUrl() == whole.NextUrl());
+            REQUIRE(content->TotalCount().value() == 42);
+            REQUIRE(content->MetadataContextUrl() == "https://example.com/svc/$metadata#People");
+            REQUIRE(content->GetODataVersion() == ODataVersion::V4);
+        }
+    }
+
+    SECTION("Properties other than the projected ones are skipped") {
+        std::string json_content = R"({"value": [
+            {"ID": 1, "Blob": {"Data": [1, 2, {"Name": "nested"}]}, "Name": "A", "Notes": "}, "x""},
+            {"Notes": "only unprojected"}
+        ], "@odata.nextLink": "People?$skiptoken=2"})";
+        std::vector<std::string> names = {"ID", "Name", "Blob"};
+        std::vector<duckdb::LogicalType> types = {duckdb::LogicalType::BIGINT, duckdb::LogicalType::VARCHAR,
+                                                  duckdb::LogicalType::VARCHAR};
+
+        for (size_t chunk_size : {1, 3, 1 << 16}) {
+            ODataEntitySetPageReader reader;
+            reader.KeepProperties({"ID", "Name"});
+            for (size_t pos = 0; pos < json_content.size(); pos += chunk_size) {
+                reader.Consume(json_content.data() + pos, std::min(chunk_size, json_content.size() - pos));
+            }
+            reader.Finish();
+            auto content = reader.Content();
+            REQUIRE(content->RowCount() == 2);
+            REQUIRE(yyjson_obj_size(content->Entity(0)) == 2);
+            REQUIRE(yyjson_obj_size(content->Entity(1)) == 0);
+            REQUIRE(content->NextUrl().value() == "People?$skiptoken=2");
+
+            auto rows = content->ToRows(names, types);
+            REQUIRE(rows[0][0].ToString() == "1");
+            REQUIRE(rows[0][1].ToString() == "A");
+            REQUIRE(rows[0][2].IsNull());
+            REQUIRE(rows[1][0].IsNull());
+        }
+    }
+
+    SECTION("OData v2 results below d") {
+        std::string json_content = R"({"d": {"results": [{"OrderID": 1}, {"OrderID": 2}], "__next": "Orders?$skiptoken=2"}})";
+        auto content = StreamPage(json_content, 5);
+        REQUIRE(content->GetODataVersion() == ODataVersion::V2);
+        REQUIRE(content->RowCount() == 2);
+        REQUIRE(content->NextUrl().value() == "Orders?$skiptoken=2");
+    }
+
+    SECTION("Strings of a page larger than one buffer block are referenced") {
+        std::string json_content = R"({"value": [)";
+        const size_t n_rows = 3000;
+        for (size_t i = 0; i < n_rows; i++) {
+            json_content += (i > 0 ? "," : "") + std::string(R"({"Name": "entity name well beyond the inline length )") +
+                            std::to_string(i) + "\"}";
+        }
+        json_content += "]}";
+        auto content = StreamPage(json_content, 4096);
+        REQUIRE(content->RowCount() == n_rows);
+
+        std::vector<duckdb::LogicalType> types = {duckdb::LogicalType::VARCHAR};
+        std::vector<ODataColumnBinding> columns = {{"Name", types[0], 0}};
+        duckdb::DataChunk chunk;
+        chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+        content->DecodeRows(n_rows - STANDARD_VECTOR_SIZE, STANDARD_VECTOR_SIZE, columns, chunk, 0);
+        chunk.SetCardinality(STANDARD_VECTOR_SIZE);
+
+        // The vectors keep the page buffer alive once the content is gone
+        content.reset();
+        REQUIRE(chunk.GetValue(0, STANDARD_VECTOR_SIZE - 1).ToString() ==
+                "entity name well beyond the inline length " + std::to_string(n_rows - 1));
+    }
+
+    SECTION("A page without an entity array is reported like a whole page") {
+        auto content = StreamPage(R"({"error": {"message": "no entities"}})", 3);
+        REQUIRE_THROWS(content->RowCount());
+    }
+
+    SECTION("The content of a truncated page is not handed out") {
+        ODataEntitySetPageReader reader;
+        std::string body = R"({"value": [{"ID": 1}, {"ID")";
+        reader.Consume(body.data(), body.size());
+        REQUIRE_THROWS(reader.Finish());
+        REQUIRE_THROWS(reader.Content());
+    }
+}
+
 TEST_CASE("Test ODataServiceJsonContent get entity sets", "[odata_content]")
 {
     std::cout << std::endl;
@@ -3,6 +3,7 @@
 #include "odata_client.hpp"
 #include "odata_edm.hpp"
 #include "http_client.hpp"
+#include "odata_url_helpers.hpp"
 #include <algorithm>
 
 using namespace erpl_web;
@@ -115,7 +116,7 @@ TEST_CASE("FromEntitySetClient - HasMoreResults is true after initial_content bu
 // Observable proof: calling PrefetchFirstPage() on a bind_data whose
 // first_page_cached_ is already true is a documented no-op. If first_page_cached_
 // were false (the pre-fix behaviour), PrefetchFirstPage() would call
-// odata_client->Get() which connects to 127.0.0.1:65534. That port is closed
+// odata_client->GetPage() which connects to 127.0.0.1:65534. That port is closed
 // → ECONNREFUSED → std::runtime_error. REQUIRE_NOTHROW catches the regression.
 // ============================================================================
 
@@ -153,3 +154,149 @@ TEST_CASE("FromEntitySetClient - empty initial_content leaves data to be fetched
     auto bind_data = ODataReadBindData::FromEntitySetClient(MakeClient(ODataVersion::V4), "");
     REQUIRE(bind_data->HasMoreResults());
 }
+
+// ============================================================================
+// Projection: only the activated columns are decoded into the output chunk
+// ============================================================================
+
+TEST_CASE("FromEntitySetClient - projected scan emits only the activated column") {
+    SeedEdmCache();
+    auto bind_data = ODataReadBindData::FromEntitySetClient(MakeClient(ODataVersion::V4), TWO_ROW_V4_JSON);
+    auto names = bind_data->GetResultNames(true);
+    auto name_column = std::distance(names.begin(), std::find(names.begin(), names.end(), "name"));
+    REQUIRE(name_column < (std::ptrdiff_t)names.size());
+
+    bind_data->ActivateColumns({static_cast<duckdb::column_t>(name_column)});
+
+    duckdb::DataChunk output;
+    output.Initialize(duckdb::Allocator::DefaultAllocator(), {duckdb::LogicalType::VARCHAR});
+    REQUIRE(bind_data->FetchNextResult(output) == 2);
+    REQUIRE(output.GetValue(0, 0).ToString() == "Alice");
+    REQUIRE(output.GetValue(0, 1).ToString() == "Bob");
+    REQUIRE_FALSE(bind_data->HasMoreResults());
+}
+
+TEST_CASE("ODataEntitySetResponse - page stays readable after the raw content is released") {
+    const std::string page =
+        R"({"d":{"results":[{"id":"1","name":"Alice"},{"id":"2","name":"Bob"}],"__next":"Customers?$skiptoken=2"}})";
+    auto http_response = std::make_shared<const HttpResponse>(HttpMethod::GET, HttpUrl(TEST_URL), 200,
+                                                              "application/json", page);
+    auto response = std::make_shared<ODataEntitySetResponse>(http_response, ODataVersion::V4);
+    http_response.reset();
+    REQUIRE(response->RawContent() == page);
+
+    response->ReleaseRawContent();
+
+    REQUIRE_THROWS_AS(response->RawContent(), std::runtime_error);
+    REQUIRE(response->ContentLength() == page.size());
+    REQUIRE(response->ContentType() == "application/json");
+    // The version comes from the parsed document, not from the client's guess
+    auto content = response->Content();
+    REQUIRE(content->RowCount() == 2);
+    REQUIRE(response->NextUrl() == std::optional<std::string>("Customers?$skiptoken=2"));
+
+    auto entity = content->Entity(1);
+    REQUIRE(entity != nullptr);
+    REQUIRE(std::string(duckdb_yyjson::yyjson_get_str(duckdb_yyjson::yyjson_obj_get(entity, "name"))) == "Bob");
+    REQUIRE(content->Entity(2) == nullptr);
+
+    // Releasing twice is harmless
+    response->ReleaseRawContent();
+    REQUIRE(response->Content() == content);
+}
+
+TEST_CASE("ODataDataExtractor - expanded rows are decoded per page range") {
+    SeedEdmCache();
+    const std::string page =
+        R"({"value":[{"id":"1","Orders":[{"OrderID":"o1"},{"OrderID":"o2"}]},)"
+        R"({"id":"2","Orders":[]},{"id":"3"}]})";
+    auto response = std::make_shared<ODataEntitySetResponse>(
+        std::make_shared<const HttpResponse>(HttpMethod::GET, HttpUrl(TEST_URL), 200, "application/json", page));
+    auto content = response->Content();
+
+    ODataDataExtractor extractor(MakeClient(ODataVersion::V4));
+    extractor.SetExpandedDataSchema({"Orders"});
+    // Without a navigation property in the metadata the collection type comes from the first page
+    extractor.InferExpandedTypesFromPage(*content);
+    auto orders_type = extractor.GetExpandedDataTypes()[0];
+    REQUIRE(orders_type.id() == duckdb::LogicalTypeId::LIST);
+    REQUIRE(duckdb::ListType::GetChildType(orders_type).id() == duckdb::LogicalTypeId::STRUCT);
+
+    duckdb::DataChunk output;
+    output.Initialize(duckdb::Allocator::DefaultAllocator(), {orders_type});
+    std::vector<ODataExpandBinding> bindings = {{"Orders", 0, 0}};
+    // Rows 1..2 of the page land at the start of the chunk, row 0 after them
+    extractor.DecodeExpandedRows(*content, 1, 2, bindings, output, 0);
+    extractor.DecodeExpandedRows(*content, 0, 1, bindings, output, 2);
+    output.SetCardinality(3);
+
+    REQUIRE(duckdb::ListValue::GetChildren(output.GetValue(0, 0)).empty());
+    REQUIRE(output.GetValue(0, 1).IsNull());
+    auto first_orders = duckdb::ListValue::GetChildren(output.GetValue(0, 2));
+    REQUIRE(first_orders.size() == 2);
+    REQUIRE(duckdb::StructValue::GetChildren(first_orders[1])[0].ToString() == "o2");
+}
+
+// ============================================================================
+// Partitioned scans
+// ============================================================================
+
+TEST_CASE("ODataScanPartition - $skip/$top ranges of a partitioned scan") {
+    SECTION("The last partition stays open-ended and may not be full") {
+        auto partitions = ODataScanPartition::Plan(25, std::nullopt, std::nullopt, 10);
+        REQUIRE(partitions.size() == 3);
+        REQUIRE(partitions[0].skip == 0);
+        REQUIRE(partitions[0].top == std::optional<idx_t>(10));
+        REQUIRE(partitions[1].skip == 10);
+        REQUIRE(partitions[1].top == std::optional<idx_t>(10));
+        REQUIRE(partitions[2].skip == 20);
+        // Rows added after $count was taken are still read
+        REQUIRE_FALSE(partitions[2].top.has_value());
+        REQUIRE(partitions[2].expected_rows == 5);
+        REQUIRE(partitions[2].index == 2);
+    }
+
+    SECTION("A user $skip/$top narrows the range and bounds the last partition") {
+        auto partitions = ODataScanPartition::Plan(100, idx_t(5), idx_t(23), 10);
+        REQUIRE(partitions.size() == 3);
+        REQUIRE(partitions[0].skip == 5);
+        REQUIRE(partitions[0].top == std::optional<idx_t>(10));
+        REQUIRE(partitions[1].skip == 15);
+        REQUIRE(partitions[2].skip == 25);
+        REQUIRE(partitions[2].top == std::optional<idx_t>(3));
+    }
+
+    SECTION("A user $skip alone keeps the last partition open-ended") {
+        auto partitions = ODataScanPartition::Plan(30, idx_t(5), std::nullopt, 10);
+        REQUIRE(partitions.size() == 3);
+        REQUIRE(partitions[2].skip == 25);
+        REQUIRE_FALSE(partitions[2].top.has_value());
+        REQUIRE(partitions[2].expected_rows == 5);
+    }
+
+    SECTION("Ranges that fit into one partition are not split") {
+        REQUIRE(ODataScanPartition::Plan(10, std::nullopt, std::nullopt, 10).empty());
+        REQUIRE(ODataScanPartition::Plan(100, idx_t(0), idx_t(8), 10).empty());
+        REQUIRE(ODataScanPartition::Plan(10, idx_t(20), std::nullopt, 5).empty());
+    }
+}
+
+TEST_CASE("CreatePartitionReader - partition readers request their range") {
+    SeedEdmCache();
+    auto bind_data = ODataReadBindData::FromEntitySetClient(MakeClient(ODataVersion::V4), TWO_ROW_V4_JSON);
+
+    ODataScanPartition bounded;
+    bounded.index = 0;
+    bounded.skip = 10;
+    bounded.top = 10;
+    HttpUrl bounded_url(bind_data->CreatePartitionReader(bounded)->GetODataClient()->Url());
+    REQUIRE(ODataUrlCodec::getQueryParam(bounded_url, "$skip") == std::optional<std::string>("10"));
+    REQUIRE(ODataUrlCodec::getQueryParam(bounded_url, "$top") == std::optional<std::string>("10"));
+
+    ODataScanPartition open_ended;
+    open_ended.index = 1;
+    open_ended.skip = 20;
+    HttpUrl open_url(bind_data->CreatePartitionReader(open_ended)->GetODataClient()->Url());
+    REQUIRE(ODataUrlCodec::getQueryParam(open_url, "$skip") == std::optional<std::string>("20"));
+    REQUIRE_FALSE(ODataUrlCodec::getQueryParam(open_url, "$top").has_value());
+}
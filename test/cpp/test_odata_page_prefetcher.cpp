@@ -0,0 +1,86 @@
+#include "catch.hpp"
+#include "odata_page_prefetcher.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace erpl_web;
+
+using StringPrefetcher = ODataPagePrefetcher<std::string>;
+
+static StringPrefetcher::SizeFunction StringSize() {
+    return [](const std::string &page) -> uint64_t { return page.size(); };
+}
+
+TEST_CASE("ODataPagePrefetcher - returns pages in order and ends with nullptr", "[odata_page_prefetcher]") {
+    int next_page = 0;
+    StringPrefetcher prefetcher(
+        [&next_page]() -> std::shared_ptr<std::string> {
+            if (next_page == 5) {
+                return nullptr;
+            }
+            return std::make_shared<std::string>("page" + std::to_string(next_page++));
+        },
+        StringSize(), 2, 1024);
+
+    for (int i = 0; i < 5; i++) {
+        auto page = prefetcher.Next();
+        REQUIRE(page != nullptr);
+        REQUIRE(*page == "page" + std::to_string(i));
+    }
+    REQUIRE(prefetcher.Next() == nullptr);
+    REQUIRE(prefetcher.Next() == nullptr);
+}
+
+TEST_CASE("ODataPagePrefetcher - respects depth and memory limit", "[odata_page_prefetcher]") {
+    std::atomic<int> fetched{0};
+    auto fetch = [&fetched]() -> std::shared_ptr<std::string> {
+        fetched++;
+        return std::make_shared<std::string>(100, 'x');
+    };
+
+    SECTION("depth") {
+        StringPrefetcher prefetcher(fetch, StringSize(), 3, 1024 * 1024);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE(prefetcher.ReadyPages() == 3);
+        REQUIRE(fetched.load() == 3);
+    }
+
+    SECTION("memory limit, one page is always allowed") {
+        StringPrefetcher prefetcher(fetch, StringSize(), 10, 50);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE(prefetcher.ReadyPages() == 1);
+        REQUIRE(prefetcher.ReadyBytes() == 100);
+
+        REQUIRE(prefetcher.Next() != nullptr);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE(prefetcher.ReadyPages() == 1);
+        REQUIRE(fetched.load() == 2);
+    }
+}
+
+TEST_CASE("ODataPagePrefetcher - rethrows fetch errors to the consumer", "[odata_page_prefetcher]") {
+    int calls = 0;
+    StringPrefetcher prefetcher(
+        [&calls]() -> std::shared_ptr<std::string> {
+            if (calls++ == 1) {
+                throw std::runtime_error("HTTP 500");
+            }
+            return std::make_shared<std::string>("first");
+        },
+        StringSize(), 2, 1024);
+
+    REQUIRE(*prefetcher.Next() == "first");
+    REQUIRE_THROWS_WITH(prefetcher.Next(), "HTTP 500");
+    REQUIRE(prefetcher.Next() == nullptr);
+}
+
+TEST_CASE("ODataPagePrefetcher - destruction stops a blocked worker", "[odata_page_prefetcher]") {
+    auto prefetcher = std::make_unique<StringPrefetcher>(
+        []() -> std::shared_ptr<std::string> { return std::make_shared<std::string>("page"); },
+        StringSize(), 1, 1024);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE_NOTHROW(prefetcher.reset());
+}
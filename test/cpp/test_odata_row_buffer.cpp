@@ -75,3 +75,29 @@ TEST_CASE("ODataRowBuffer - Clear removes all rows", "[odata_row_buffer]") {
     REQUIRE(buf.Size() == 0);
     REQUIRE(!buf.HasMoreRows());
 }
+
+TEST_CASE("ODataRowBuffer - pages are decoded across page boundaries", "[odata_row_buffer]") {
+    ODataRowBuffer buf;
+
+    buf.AddPage(std::make_shared<ODataEntitySetJsonContent>(R"({"value":[{"id":1},{"id":2},{"id":3}]})"));
+    buf.AddPage(std::make_shared<ODataEntitySetJsonContent>(R"({"value":[]})"));
+    buf.AddPage(std::make_shared<ODataEntitySetJsonContent>(R"({"value":[{"id":4},{"id":5}]})"));
+    REQUIRE(buf.Size() == 5);
+    REQUIRE(buf.HasPageRows());
+    REQUIRE(!buf.HasPrebuiltRows());
+
+    std::vector<duckdb::LogicalType> types = {duckdb::LogicalType::BIGINT};
+    std::vector<ODataColumnBinding> columns = {{"id", types[0], 0}};
+    duckdb::DataChunk chunk;
+    chunk.Initialize(duckdb::Allocator::DefaultAllocator(), types);
+
+    REQUIRE(buf.DecodePageRows(columns, chunk, 0, 4) == 4);
+    REQUIRE(buf.Size() == 1);
+    REQUIRE(buf.DecodePageRows(columns, chunk, 4, 4) == 1);
+    REQUIRE(!buf.HasMoreRows());
+    chunk.SetCardinality(5);
+
+    for (idx_t i = 0; i < 5; i++) {
+        REQUIRE(chunk.GetValue(0, i).GetValue<int64_t>() == (int64_t)(i + 1));
+    }
+}
@@ -56,3 +56,21 @@ TEST_CASE("ODataUrlCodec ensureJsonFormat appends $format=json", "[odata_url]")
 }
 
 
+
+TEST_CASE("ODataUrlCodec query parameter helpers", "[odata_url]") {
+    HttpUrl url("https://h/svc/Entity?$format=json&%24top=100&$filter=A%20eq%201");
+
+    REQUIRE(ODataUrlCodec::getQueryParam(url, "$top").value() == "100");
+    REQUIRE(ODataUrlCodec::getQueryParam(url, "$filter").value() == "A%20eq%201");
+    REQUIRE_FALSE(ODataUrlCodec::getQueryParam(url, "$skip").has_value());
+
+    ODataUrlCodec::setQueryParam(url, "$top", "10");
+    ODataUrlCodec::setQueryParam(url, "$skip", "20");
+    REQUIRE(ODataUrlCodec::getQueryParam(url, "$top").value() == "10");
+    REQUIRE(ODataUrlCodec::getQueryParam(url, "$skip").value() == "20");
+    REQUIRE(url.Query().find("%24top") == std::string::npos);
+
+    ODataUrlCodec::removeQueryParam(url, "$filter");
+    REQUIRE_FALSE(ODataUrlCodec::getQueryParam(url, "$filter").has_value());
+    REQUIRE(url.Query().find("$format=json") != std::string::npos);
+}